@@ -0,0 +1,279 @@
+#include "agent_scheduler.hpp"
+#include <cmath>
+#include <exception>
+#include <new>
+
+namespace {
+
+/**
+ * @brief Cadre libre, chaîné dans la liste de sa classe de taille.
+ */
+struct FreeFrame {
+    FreeFrame* next; ///< Cadre libre suivant.
+};
+
+/**
+ * @brief Listes libres et bloc en cours d'un thread.
+ */
+struct FrameCache {
+    FreeFrame* free[kFrameClasses] = {}; ///< Cadres libres, par classe de taille.
+    char* cursor = nullptr; ///< Prochain cadre du bloc en cours.
+    char* end = nullptr; ///< Fin du bloc en cours.
+    FramePoolStats stats; ///< Compteurs du thread.
+};
+
+thread_local FrameCache t_frames; ///< Cache du thread appelant.
+
+/**
+ * @brief Classe de taille d'un cadre.
+ * @param size Taille demandée.
+ * @return L'indice de la classe ; kFrameClasses ou plus si le cadre est trop grand.
+ */
+std::size_t frame_class(std::size_t size) {
+    return size ? (size - 1) / kFrameGranule : 0;
+}
+
+} // namespace
+
+/**
+ * @brief Alloue un cadre de coroutine dans le cache du thread.
+ * @param size Taille demandée.
+ * @return Le cadre.
+ */
+void* AllocateFrame(std::size_t size) {
+    FrameCache& cache = t_frames;
+    ++cache.stats.allocations;
+    const std::size_t index = frame_class(size);
+    if (index >= kFrameClasses) {
+        ++cache.stats.oversized;
+        return ::operator new(size, std::align_val_t{kFrameGranule});
+    }
+    if (FreeFrame* frame = cache.free[index]) {
+        cache.free[index] = frame->next;
+        ++cache.stats.reused;
+        return frame;
+    }
+
+    const std::size_t bytes = (index + 1) * kFrameGranule;
+    if (static_cast<std::size_t>(cache.end - cache.cursor) < bytes) {
+        // Le reste du bloc précédent est perdu : au plus un cadre de la plus grande classe.
+        // Le bloc n'est jamais rendu : un cadre peut survivre au thread qui l'a découpé
+        void* chunk = ::operator new(kFrameChunkBytes, std::align_val_t{kFrameGranule});
+        cache.cursor = static_cast<char*>(chunk);
+        cache.end = cache.cursor + kFrameChunkBytes;
+        ++cache.stats.chunks;
+    }
+    void* frame = cache.cursor;
+    cache.cursor += bytes;
+    return frame;
+}
+
+/**
+ * @brief Rend un cadre à la liste libre du thread appelant.
+ * @param frame Cadre.
+ * @param size Taille demandée à l'allocation.
+ */
+void DeallocateFrame(void* frame, std::size_t size) {
+    const std::size_t index = frame_class(size);
+    if (index >= kFrameClasses) {
+        ::operator delete(frame, std::align_val_t{kFrameGranule});
+        return;
+    }
+    FrameCache& cache = t_frames;
+    FreeFrame* node = static_cast<FreeFrame*>(frame);
+    node->next = cache.free[index];
+    cache.free[index] = node;
+}
+
+/**
+ * @brief Compteurs de l'allocateur de cadres du thread appelant.
+ * @return Les compteurs.
+ */
+FramePoolStats LocalFramePoolStats() {
+    return t_frames.stats;
+}
+
+/**
+ * @brief Un comportement ne doit pas laisser échapper d'exception : arrêt du programme.
+ */
+void AgentTask::promise_type::unhandled_exception() noexcept {
+    std::terminate();
+}
+
+/**
+ * @brief Affectation par déplacement : détruit la coroutine possédée.
+ * @param other Tâche cédée.
+ * @return Cette tâche.
+ */
+AgentTask& AgentTask::operator=(AgentTask&& other) noexcept {
+    if (this != &other) {
+        if (handle) {
+            handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @brief Destructeur : détruit la coroutine si elle n'a pas été confiée à un ordonnanceur.
+ */
+AgentTask::~AgentTask() {
+    if (handle) {
+        handle.destroy();
+    }
+}
+
+/**
+ * @brief Planifie la reprise après le nombre de ticks demandé.
+ * @param handle Coroutine suspendue.
+ */
+void WaitTicks::await_suspend(AgentTask::Handle handle) const noexcept {
+    handle.promise().scheduler->Schedule(handle, ticks);
+}
+
+/**
+ * @brief Planifie la reprise après la durée demandée, convertie en ticks.
+ * @param handle Coroutine suspendue.
+ */
+void WaitSeconds::await_suspend(AgentTask::Handle handle) const noexcept {
+    AgentScheduler* scheduler = handle.promise().scheduler;
+    scheduler->Schedule(handle, scheduler->TicksFor(seconds));
+}
+
+/**
+ * @brief Constructeur.
+ * @param dt Durée d'un tick en secondes.
+ */
+AgentScheduler::AgentScheduler(float dt) : dt(dt > 0.f ? dt : 0.04f) {}
+
+/**
+ * @brief Destructeur : détruit les coroutines en attente.
+ */
+AgentScheduler::~AgentScheduler() {
+    for (std::vector<Timer>& slot : wheel) {
+        for (const Timer& timer : slot) {
+            timer.handle.destroy();
+        }
+    }
+}
+
+/**
+ * @brief Confie une coroutine à l'ordonnanceur.
+ * @param task Coroutine.
+ * @return False si la tâche était vide.
+ */
+bool AgentScheduler::Spawn(AgentTask task) {
+    const AgentTask::Handle handle = task.Release();
+    if (!handle) {
+        return false;
+    }
+    handle.promise().scheduler = this;
+    ++live;
+    Schedule(handle, 1);
+    return true;
+}
+
+/**
+ * @brief Range une coroutine dans la case de son tick d'échéance.
+ * @param handle Coroutine.
+ * @param ticks Ticks à attendre, au moins 1.
+ */
+void AgentScheduler::Schedule(AgentTask::Handle handle, std::uint64_t ticks) {
+    const std::uint64_t due = tick + (ticks ? ticks : 1);
+    wheel[due % kWheelSlots].push_back(Timer{due, handle});
+}
+
+/**
+ * @brief Avance d'un tick et reprend les coroutines arrivées à échéance.
+ *
+ * La case est échangée avec le tampon de traitement avant les reprises : une coroutine
+ * peut ainsi se replanifier, même dans la case en cours, sans invalider le parcours.
+ *
+ * @return Le nombre de coroutines reprises.
+ */
+std::size_t AgentScheduler::Tick() {
+    ++tick;
+    std::vector<Timer>& slot = wheel[tick % kWheelSlots];
+    batch.swap(slot);
+    std::size_t resumed = 0;
+    for (const Timer& timer : batch) {
+        if (timer.due != tick) {
+            slot.push_back(timer); // Attente plus longue qu'un tour de roue
+            continue;
+        }
+        timer.handle.resume();
+        ++resumed;
+        if (timer.handle.done()) {
+            timer.handle.destroy();
+            --live;
+        }
+    }
+    batch.clear();
+    resumes += resumed;
+    return resumed;
+}
+
+/**
+ * @brief Nombre de ticks correspondant à une durée.
+ * @param seconds Durée en secondes.
+ * @return Le nombre de ticks, au moins 1.
+ */
+std::uint64_t AgentScheduler::TicksFor(double seconds) const {
+    // Tolérance relative : dt est un float, 2 s à 0.04f ne doivent pas donner 51 ticks
+    const double ratio = seconds / dt;
+    const double ticks = std::ceil(ratio - 1e-6 * std::fmax(1.0, ratio));
+    return ticks < 1.0 ? 1 : static_cast<std::uint64_t>(ticks);
+}
+
+/**
+ * @brief Comportement de joueur : couper vers le panier, attendre, puis demander le ballon.
+ * @param player Joueur.
+ * @param ball Ballon.
+ * @param basket Panier visé.
+ * @param step Distance parcourue par tick.
+ * @param wait Attente avant l'appel de balle, en secondes.
+ */
+template <class Rules>
+AgentTask CutAndCall(BasicPlayer<Rules>& player, BasicBallon<Rules>& ball, Position basket, float step, double wait) {
+    // Coupe vers le panier
+    for (float distance = player.position.distance_to(basket); distance > step;
+         distance = player.position.distance_to(basket)) {
+        player.position.x += (basket.x - player.position.x) * step / distance;
+        player.position.y += (basket.y - player.position.y) * step / distance;
+        co_await NextTick();
+    }
+
+    co_await WaitSeconds{wait};
+
+    // Appel de balle : seul un coéquipier la cède
+    BasicPlayer<Rules>* holder = ball.possesseur;
+    if (holder && holder != &player && Rules::team_of(holder->number) == Rules::team_of(player.number)) {
+        holder->possede_ball = false;
+        ball.possesseur = &player;
+        ball.position = player.position;
+        player.possede_ball = true;
+    }
+}
+
+/**
+ * @brief Comportement de coach : alterne deux stratégies à intervalle régulier.
+ * @param coach Coach.
+ * @param first Stratégie appliquée d'abord.
+ * @param second Stratégie appliquée ensuite.
+ * @param period Durée de chaque stratégie, en secondes.
+ */
+AgentTask AlternateStrategies(Coach& coach, Strategy* first, Strategy* second, double period) {
+    for (;;) {
+        coach.SetStrategy(first);
+        co_await WaitSeconds{period};
+        coach.SetStrategy(second);
+        co_await WaitSeconds{period};
+    }
+}
+
+template AgentTask CutAndCall<Rules5x5>(BasicPlayer<Rules5x5>&, BasicBallon<Rules5x5>&, Position, float, double);
+template AgentTask CutAndCall<Rules3x3>(BasicPlayer<Rules3x3>&, BasicBallon<Rules3x3>&, Position, float, double);
+template AgentTask CutAndCall<RulesDrill2x2>(BasicPlayer<RulesDrill2x2>&, BasicBallon<RulesDrill2x2>&, Position,
+                                             float, double);
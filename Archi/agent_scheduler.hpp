@@ -0,0 +1,256 @@
+/**
+ * @file agent_scheduler.hpp
+ * @brief Comportements de joueurs et de coachs écrits en coroutines C++20, repris à chaque tick par un ordonnanceur coopératif.
+ */
+
+#ifndef AGENT_SCHEDULER_HPP
+#define AGENT_SCHEDULER_HPP
+
+#include "basket.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AgentScheduler;
+
+/**
+ * @brief Compteurs de l'allocateur de cadres de coroutines du thread appelant.
+ */
+struct FramePoolStats {
+    std::uint64_t allocations = 0; ///< Cadres alloués.
+    std::uint64_t reused = 0; ///< Cadres repris d'une liste libre.
+    std::uint64_t chunks = 0; ///< Blocs de kFrameChunkBytes réservés.
+    std::uint64_t oversized = 0; ///< Cadres trop grands, alloués par operator new.
+};
+
+constexpr std::size_t kFrameGranule = 64; ///< Granularité (et alignement) des cadres.
+constexpr std::size_t kFrameClasses = 16; ///< Classes de taille : jusqu'à kFrameGranule × kFrameClasses octets.
+constexpr std::size_t kFrameChunkBytes = 64 * 1024; ///< Taille des blocs découpés en cadres.
+
+/**
+ * @brief Alloue un cadre de coroutine.
+ *
+ * Chaque thread découpe ses cadres dans des blocs de kFrameChunkBytes et recycle les
+ * cadres libérés dans une liste par classe de taille : ni verrou ni appel système hors
+ * de la réservation d'un bloc. Un cadre peut être libéré par un autre thread que celui
+ * qui l'a alloué ; il rejoint alors les listes de ce thread. Les blocs ne sont jamais
+ * rendus au système.
+ *
+ * @param size Taille demandée.
+ * @return Le cadre, aligné sur kFrameGranule.
+ */
+void* AllocateFrame(std::size_t size);
+
+/**
+ * @brief Libère un cadre alloué par AllocateFrame().
+ * @param frame Cadre.
+ * @param size Taille demandée à l'allocation.
+ */
+void DeallocateFrame(void* frame, std::size_t size);
+
+/**
+ * @brief Compteurs de l'allocateur de cadres du thread appelant.
+ * @return Les compteurs.
+ */
+FramePoolStats LocalFramePoolStats();
+
+/**
+ * @brief Coroutine d'un agent.
+ *
+ * Une fonction qui renvoie AgentTask et utilise co_await devient un comportement : elle
+ * démarre suspendue et ne s'exécute qu'une fois confiée à un AgentScheduler par Spawn().
+ * L'objet possède la coroutine jusqu'à Spawn() ; détruit avant, il la détruit.
+ */
+class AgentTask {
+public:
+    /**
+     * @brief Promesse : cadre alloué par AllocateFrame(), ordonnanceur courant.
+     */
+    struct promise_type {
+        AgentScheduler* scheduler = nullptr; ///< Ordonnanceur de la coroutine, fixé par Spawn().
+
+        AgentTask get_return_object() {
+            return AgentTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept;
+
+        static void* operator new(std::size_t size) { return AllocateFrame(size); }
+        static void operator delete(void* frame, std::size_t size) { DeallocateFrame(frame, size); }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>; ///< Poignée de la coroutine.
+
+    AgentTask() = default;
+    AgentTask(AgentTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    AgentTask& operator=(AgentTask&& other) noexcept;
+    AgentTask(const AgentTask&) = delete; ///< Non copiable.
+    AgentTask& operator=(const AgentTask&) = delete; ///< Non copiable.
+    ~AgentTask();
+
+    /**
+     * @brief Cède la coroutine (appelé par AgentScheduler::Spawn()).
+     * @return La poignée, nulle si la tâche est vide.
+     */
+    Handle Release() {
+        Handle released = handle;
+        handle = nullptr;
+        return released;
+    }
+
+    bool Valid() const { return static_cast<bool>(handle); } ///< True si la tâche possède une coroutine.
+
+private:
+    explicit AgentTask(Handle handle) : handle(handle) {}
+
+    Handle handle = nullptr; ///< Coroutine possédée.
+};
+
+/**
+ * @brief Attente d'un nombre de ticks : `co_await WaitTicks{n}`.
+ *
+ * WaitTicks{0} ne suspend pas ; WaitTicks{1} reprend au tick suivant.
+ */
+struct WaitTicks {
+    std::uint64_t ticks; ///< Ticks à attendre.
+
+    bool await_ready() const noexcept { return ticks == 0; }
+    void await_suspend(AgentTask::Handle handle) const noexcept;
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Attente d'une durée de jeu : `co_await WaitSeconds{2.0}`.
+ *
+ * La durée est arrondie au tick supérieur selon le pas de l'ordonnanceur (au moins un tick).
+ */
+struct WaitSeconds {
+    double seconds; ///< Durée à attendre.
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(AgentTask::Handle handle) const noexcept;
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Attente du tick suivant.
+ * @return L'attente.
+ */
+inline WaitTicks NextTick() {
+    return WaitTicks{1};
+}
+
+/**
+ * @brief Ordonnanceur coopératif : reprend, à chaque tick, les coroutines dont l'attente expire.
+ *
+ * Un ordonnanceur est mono-thread ; pour plusieurs cœurs, on en crée un par worker (par
+ * exemple un par tâche de WorkStealingPool::ParallelFor), chacun avec ses matchs. Les
+ * attentes sont rangées dans une roue de kWheelSlots cases indexée par tick d'échéance :
+ * planifier et reprendre une coroutine coûtent O(1), et une attente plus longue qu'un
+ * tour de roue est simplement revue une fois par tour. Une coroutine terminée est
+ * détruite au tick où elle se termine.
+ */
+class AgentScheduler {
+public:
+    static constexpr std::size_t kWheelSlots = 256; ///< Cases de la roue des échéances.
+
+    /**
+     * @brief Constructeur.
+     * @param dt Durée d'un tick en secondes (celle de MatchConfig::dt).
+     */
+    explicit AgentScheduler(float dt = 0.04f);
+
+    /**
+     * @brief Destructeur : détruit les coroutines en attente.
+     */
+    ~AgentScheduler();
+
+    AgentScheduler(const AgentScheduler&) = delete; ///< Non copiable.
+    AgentScheduler& operator=(const AgentScheduler&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Confie une coroutine à l'ordonnanceur ; elle démarre au prochain Tick().
+     * @param task Coroutine, vidée par l'appel.
+     * @return False si la tâche était vide.
+     */
+    bool Spawn(AgentTask task);
+
+    /**
+     * @brief Avance d'un tick et reprend les coroutines arrivées à échéance.
+     * @return Le nombre de coroutines reprises.
+     */
+    std::size_t Tick();
+
+    /**
+     * @brief Planifie la reprise d'une coroutine suspendue (appelé par les attentes).
+     * @param handle Coroutine.
+     * @param ticks Ticks à attendre, au moins 1.
+     */
+    void Schedule(AgentTask::Handle handle, std::uint64_t ticks);
+
+    /**
+     * @brief Nombre de ticks correspondant à une durée, arrondi au supérieur et au moins 1.
+     * @param seconds Durée en secondes.
+     * @return Le nombre de ticks.
+     */
+    std::uint64_t TicksFor(double seconds) const;
+
+    std::size_t Size() const { return live; } ///< Coroutines non terminées.
+    std::uint64_t TickCount() const { return tick; } ///< Ticks effectués.
+    std::uint64_t Resumes() const { return resumes; } ///< Reprises effectuées depuis la construction.
+    float Dt() const { return dt; } ///< Durée d'un tick en secondes.
+
+private:
+    /**
+     * @brief Coroutine en attente.
+     */
+    struct Timer {
+        std::uint64_t due; ///< Tick de reprise.
+        AgentTask::Handle handle; ///< Coroutine.
+    };
+
+    float dt; ///< Durée d'un tick.
+    std::uint64_t tick = 0; ///< Ticks effectués.
+    std::size_t live = 0; ///< Coroutines non terminées.
+    std::uint64_t resumes = 0; ///< Reprises effectuées.
+    std::vector<Timer> wheel[kWheelSlots]; ///< Attentes, par tick d'échéance modulo kWheelSlots.
+    std::vector<Timer> batch; ///< Case en cours de traitement (capacité réutilisée).
+};
+
+/**
+ * @brief Comportement de joueur : couper vers le panier, attendre, puis demander le ballon.
+ *
+ * Le joueur avance de @p step par tick jusqu'à moins de @p step du panier, attend
+ * @p wait secondes, puis reçoit le ballon si un coéquipier le détient.
+ *
+ * @param player Joueur (doit survivre à la coroutine).
+ * @param ball Ballon (doit survivre à la coroutine).
+ * @param basket Panier visé.
+ * @param step Distance parcourue par tick.
+ * @param wait Attente avant l'appel de balle, en secondes.
+ * @return La coroutine.
+ */
+template <class Rules>
+AgentTask CutAndCall(BasicPlayer<Rules>& player, BasicBallon<Rules>& ball, Position basket, float step, double wait);
+
+/**
+ * @brief Comportement de coach : alterne deux stratégies à intervalle régulier, sans fin.
+ * @param coach Coach (doit survivre à la coroutine).
+ * @param first Stratégie appliquée d'abord.
+ * @param second Stratégie appliquée ensuite.
+ * @param period Durée de chaque stratégie, en secondes.
+ * @return La coroutine.
+ */
+AgentTask AlternateStrategies(Coach& coach, Strategy* first, Strategy* second, double period);
+
+extern template AgentTask CutAndCall<Rules5x5>(BasicPlayer<Rules5x5>&, BasicBallon<Rules5x5>&, Position, float,
+                                               double);
+extern template AgentTask CutAndCall<Rules3x3>(BasicPlayer<Rules3x3>&, BasicBallon<Rules3x3>&, Position, float,
+                                               double);
+extern template AgentTask CutAndCall<RulesDrill2x2>(BasicPlayer<RulesDrill2x2>&, BasicBallon<RulesDrill2x2>&,
+                                                    Position, float, double);
+
+#endif // AGENT_SCHEDULER_HPP
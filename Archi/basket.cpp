@@ -1,4 +1,8 @@
 #include "basket.hpp"
+#include "metrics.hpp"
+#include "output_sink.hpp"
+#include "score_notifier.hpp"
+#include "team_tree.hpp"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -20,22 +24,23 @@ float Position::distance_to(const Position& other) const {
  * @param players Liste de tous les joueurs du jeu.
  * @param team_id L'identifiant de l'équipe du joueur.
  */
-void Player::find_teammates(const std::vector<Player>& players, int team_id) {
-    std::vector<std::pair<Player*, float>> distances;
+template <class Rules>
+void BasicPlayer<Rules>::find_teammates(const std::vector<BasicPlayer>& players, int team_id) {
+    std::vector<std::pair<BasicPlayer*, float>> distances;
 
-    for (const Player& other : players) {
-        if (other.number != this->number && other.number / 5 == team_id) {
+    for (const BasicPlayer& other : players) {
+        if (other.number != this->number && Rules::team_of(other.number) == team_id) {
             float distance = this->position.distance_to(other.position);
-            distances.push_back({const_cast<Player*>(&other), distance});
+            distances.push_back({const_cast<BasicPlayer*>(&other), distance});
         }
     }
 
     std::sort(distances.begin(), distances.end(),
-              [](const std::pair<Player*, float>& a, const std::pair<Player*, float>& b) {
+              [](const std::pair<BasicPlayer*, float>& a, const std::pair<BasicPlayer*, float>& b) {
                   return a.second < b.second;
               });
 
-    for (int i = 0; i < 4 && i < static_cast<int>(distances.size()); ++i) {
+    for (int i = 0; i < Rules::teammates && i < static_cast<int>(distances.size()); ++i) {
         Teammates[i] = distances[i].first;
     }
 }
@@ -45,36 +50,41 @@ void Player::find_teammates(const std::vector<Player>& players, int team_id) {
  * @param players Liste de tous les joueurs du jeu.
  * @param team_id L'identifiant de l'équipe du joueur.
  */
-void Player::find_opponents(const std::vector<Player>& players, int team_id) {
-    std::vector<std::pair<Player*, float>> distances;
+template <class Rules>
+void BasicPlayer<Rules>::find_opponents(const std::vector<BasicPlayer>& players, int team_id) {
+    std::vector<std::pair<BasicPlayer*, float>> distances;
 
-    for (const Player& other : players) {
-        if (other.number / 5 != team_id) {
+    for (const BasicPlayer& other : players) {
+        if (Rules::team_of(other.number) != team_id) {
             float distance = this->position.distance_to(other.position);
-            distances.push_back({const_cast<Player*>(&other), distance});
+            distances.push_back({const_cast<BasicPlayer*>(&other), distance});
         }
     }
 
     std::sort(distances.begin(), distances.end(),
-              [](const std::pair<Player*, float>& a, const std::pair<Player*, float>& b) {
+              [](const std::pair<BasicPlayer*, float>& a, const std::pair<BasicPlayer*, float>& b) {
                   return a.second < b.second;
               });
 
-    for (int i = 0; i < 5 && i < static_cast<int>(distances.size()); ++i) {
+    for (int i = 0; i < Rules::opponents && i < static_cast<int>(distances.size()); ++i) {
         Opponents[i] = distances[i].first;
     }
 }
 
 /**
  * @brief Change le possesseur du ballon pour le coéquipier le plus proche.
+ *
+ * La boucle sur les coéquipiers est déroulée à la compilation pour chaque variante.
+ *
  * @return True si le possesseur a été changé avec succès, false sinon.
  */
-bool Ballon::changer_possesseur() {
+template <class Rules>
+bool BasicBallon<Rules>::changer_possesseur() {
     float min_distance = std::numeric_limits<float>::max();
-    Player* closest_teammate = nullptr;
+    BasicPlayer<Rules>* closest_teammate = nullptr;
 
-    for (int i = 0; i < 4; ++i) {
-        Player* teammate = this->possesseur->Teammates[i];
+    unrolled<Rules::teammates>([&](auto i) {
+        BasicPlayer<Rules>* teammate = this->possesseur->Teammates[i];
         if (teammate) {
             float distance = this->position.distance_to(teammate->position);
             if (distance < min_distance) {
@@ -82,7 +92,7 @@ bool Ballon::changer_possesseur() {
                 closest_teammate = teammate;
             }
         }
-    }
+    });
 
     if (closest_teammate) {
         this->possesseur = closest_teammate;
@@ -92,33 +102,55 @@ bool Ballon::changer_possesseur() {
     return false;
 }
 
-/**
- * @brief Instance singleton de la classe Gamescore.
- */
-Gamescore* Gamescore::instance = nullptr;
+template class BasicPlayer<Rules5x5>;
+template class BasicPlayer<Rules3x3>;
+template class BasicPlayer<RulesDrill2x2>;
+template class BasicBallon<Rules5x5>;
+template class BasicBallon<Rules3x3>;
+template class BasicBallon<RulesDrill2x2>;
 
 /**
  * @brief Constructeur par défaut de Gamescore.
  */
 Gamescore::Gamescore() : homeScore(0), awayScore(0) {}
 
+/**
+ * @brief Destructeur : vide et arrête la notification asynchrone éventuelle.
+ */
+Gamescore::~Gamescore() = default;
+
 /**
  * @brief Obtient l'instance unique de la classe Gamescore.
+ *
+ * Variable statique locale : son initialisation est garantie unique et thread-safe.
+ *
  * @return Pointeur vers l'instance singleton.
  */
 Gamescore* Gamescore::GetInstance() {
-    if (instance == nullptr) {
-        instance = new Gamescore();
-    }
-    return instance;
+    static Gamescore instance;
+    return &instance;
 }
 
 /**
  * @brief Ajoute un arbitre à la liste des observateurs.
  * @param arbitre Pointeur partagé vers l'arbitre.
  */
-void Gamescore::AddArbitre(std::shared_ptr<Arbitre> arbitre) {
+void Gamescore::AddArbitre(const std::shared_ptr<Arbitre>& arbitre) {
     arbitres.push_back(arbitre);
+    if (notifier) {
+        notifier->SetObservers(arbitres);
+    }
+}
+
+/**
+ * @brief Livre un lot d'événements en appelant Update() pour chacun.
+ * @param events Événements, du plus ancien au plus récent.
+ * @param count Nombre d'événements.
+ */
+void Arbitre::UpdateBatch(const ScoreEvent* events, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        Update(events[i].homeScore, events[i].awayScore);
+    }
 }
 
 /**
@@ -127,27 +159,67 @@ void Gamescore::AddArbitre(std::shared_ptr<Arbitre> arbitre) {
  * @param awayScore Score de l'équipe adverse.
  */
 void RefereeDisplay::Update(int homeScore, int awayScore) {
-    std::cout << "[Arbitre] Score mis à jour : Home " << homeScore
-              << " - Away " << awayScore << std::endl;
+    ReportLine() << "[Arbitre] Score mis à jour : Home " << homeScore << " - Away " << awayScore;
+}
+
+/**
+ * @brief Affiche un lot de scores avec un seul vidage du puits.
+ * @param events Événements, du plus ancien au plus récent.
+ * @param count Nombre d'événements.
+ */
+void RefereeDisplay::UpdateBatch(const ScoreEvent* events, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        ReportLine() << "[Arbitre] Score mis à jour : Home " << events[i].homeScore
+                     << " - Away " << events[i].awayScore;
+    }
+    FlushReports();
 }
 
 /**
  * @brief Retire un arbitre de la liste des observateurs.
  * @param arbitre Pointeur partagé vers l'arbitre.
  */
-void Gamescore::RemoveArbitre(std::shared_ptr<Arbitre> arbitre) {
+void Gamescore::RemoveArbitre(const std::shared_ptr<Arbitre>& arbitre) {
     arbitres.erase(std::remove(arbitres.begin(), arbitres.end(), arbitre), arbitres.end());
+    if (notifier) {
+        notifier->SetObservers(arbitres);
+    }
 }
 
 /**
  * @brief Notifie tous les arbitres des scores actuels.
  */
 void Gamescore::NotifyArbitres() {
+    events.Notify(GameEvent{EventType::Score, homeScore, awayScore});
+    if (notifier) {
+        notifier->Publish(homeScore, awayScore);
+        return;
+    }
+    CountMetric(Counter::ObserverCalls, arbitres.size());
     for (auto& arbitre : arbitres) {
         arbitre->Update(homeScore, awayScore);
     }
 }
 
+/**
+ * @brief Passe en notification asynchrone.
+ * @param capacity Capacité de la file.
+ * @param policy Politique appliquée lorsque la file est pleine.
+ * @param batch Nombre maximal d'événements livrés par lot.
+ */
+void Gamescore::EnableAsyncNotification(std::size_t capacity, BackPressure policy, std::size_t batch) {
+    notifier.reset();
+    notifier = std::make_unique<AsyncNotifier>(capacity, policy, batch);
+    notifier->SetObservers(arbitres);
+}
+
+/**
+ * @brief Revient en notification synchrone après avoir livré les événements en attente.
+ */
+void Gamescore::DisableAsyncNotification() {
+    notifier.reset();
+}
+
 /**
  * @brief Met à jour les scores du jeu et notifie les arbitres.
  * @param home Score de l'équipe à domicile.
@@ -163,14 +235,30 @@ void Gamescore::UpdateScore(int home, int away) {
  * @brief Exécute la stratégie offensive.
  */
 void OffensiveStrategy::ExecuteStrategy() {
-    std::cout << "Le coach ordonne : Passer en attaque rapide !" << std::endl;
+    ReportLine() << "Le coach ordonne : Passer en attaque rapide !";
+}
+
+/**
+ * @brief Consignes offensives : tirs de plus loin, défense plus lâche.
+ * @return Les consignes.
+ */
+Tactics OffensiveStrategy::GetTactics() const {
+    return Tactics{1.35f, 0.15f};
 }
 
 /**
  * @brief Exécute la stratégie défensive.
  */
 void DefensiveStrategy::ExecuteStrategy() {
-    std::cout << "Le coach ordonne : Renforcez la défense !" << std::endl;
+    ReportLine() << "Le coach ordonne : Renforcez la défense !";
+}
+
+/**
+ * @brief Consignes défensives : tirs plus proches, marquage serré.
+ * @return Les consignes.
+ */
+Tactics DefensiveStrategy::GetTactics() const {
+    return Tactics{0.8f, 0.55f};
 }
 
 /**
@@ -178,12 +266,28 @@ void DefensiveStrategy::ExecuteStrategy() {
  */
 Coach::Coach() : currentStrategy(nullptr) {}
 
+/**
+ * @brief Rattache le coach à un registre d'événements.
+ * @param registry Registre notifié à chaque SetStrategy(), ou nullptr.
+ * @param team Équipe entraînée.
+ */
+void Coach::Attach(ObserverRegistry* registry, int team) {
+    events = registry;
+    this->team = team;
+}
+
 /**
  * @brief Définit la stratégie actuelle pour le coach.
  * @param strategy Pointeur vers la stratégie.
  */
 void Coach::SetStrategy(Strategy* strategy) {
     currentStrategy = strategy;
+    if (events) {
+        GameEvent event{EventType::Strategy};
+        event.team = team;
+        event.strategy = strategy;
+        events->Notify(event);
+    }
 }
 
 /**
@@ -193,7 +297,7 @@ void Coach::ApplyStrategy() {
     if (currentStrategy) {
         currentStrategy->ExecuteStrategy();
     } else {
-        std::cout << "Aucune stratégie définie par le coach." << std::endl;
+        ReportLine() << "Aucune stratégie définie par le coach.";
     }
 }
 
@@ -202,25 +306,46 @@ void Coach::ApplyStrategy() {
  * @param player Le joueur à observer.
  */
 void Coach::ObservePlayer(const Player& player) {
+    if (!stats.Observe(player)) {
+        return;
+    }
     if (player.possede_ball) {
-        std::cout << "Coach observe : Le joueur " << player.number << " a le ballon." << std::endl;
+        ReportLine() << "Coach observe : Le joueur " << player.number << " a le ballon.";
     } else {
-        std::cout << "Coach observe : Le joueur " << player.number << " n'a pas le ballon." << std::endl;
+        ReportLine() << "Coach observe : Le joueur " << player.number << " n'a pas le ballon.";
     }
 }
 
+/**
+ * @brief Par défaut, un composant n'est pas recopié dans l'arbre aplati.
+ * @return TeamTree::kNone.
+ */
+std::uint32_t TeamComponent::FlattenInto(TeamTree&, std::uint32_t) const {
+    return TeamTree::kNone;
+}
+
 /**
  * @brief Constructeur de PlayerLeaf.
  * @param p Pointeur vers le joueur représenté par cette feuille.
  */
 PlayerLeaf::PlayerLeaf(Player* p) : player(p) {}
 
+/**
+ * @brief Ajoute une feuille pour ce joueur dans un arbre aplati.
+ * @param tree Arbre de destination.
+ * @param parent Groupe parent.
+ * @return L'identifiant de la feuille.
+ */
+std::uint32_t PlayerLeaf::FlattenInto(TeamTree& tree, std::uint32_t parent) const {
+    return tree.AddLeaf(parent, player);
+}
+
 /**
  * @brief Affiche les informations du joueur.
  */
 void PlayerLeaf::Display() const {
-    std::cout << "Joueur " << player->number << " à la position ("
-              << player->position.x << ", " << player->position.y << ")" << std::endl;
+    ReportLine() << "Joueur " << player->number << " à la position ("
+                 << player->position.x << ", " << player->position.y << ")";
 }
 
 /**
@@ -243,8 +368,24 @@ void TeamComposite::Remove(TeamComponent* component) {
  * @brief Affiche les informations de l'équipe.
  */
 void TeamComposite::Display() const {
-    std::cout << "Équipe :\n";
+    ReportLine() << "Équipe :";
     for (const auto& component : components) {
         component->Display();
     }
 }
+
+/**
+ * @brief Ajoute un groupe et, récursivement, ses composants dans un arbre aplati.
+ * @param tree Arbre de destination.
+ * @param parent Groupe parent.
+ * @return L'identifiant du groupe créé.
+ */
+std::uint32_t TeamComposite::FlattenInto(TeamTree& tree, std::uint32_t parent) const {
+    const TeamTree::NodeId group = tree.AddGroup(parent);
+    if (group != TeamTree::kNone) {
+        for (const auto& component : components) {
+            component->FlattenInto(tree, group);
+        }
+    }
+    return group;
+}
@@ -13,10 +13,16 @@
 #include <algorithm>
 #include <memory>
 #include <limits>
+#include <cstddef>
+#include <cstdint>
 
-// Dimensions du terrain
-#define basket_x 100.f ///< Largeur du terrain de basketball.
-#define basket_y 50.f ///< Hauteur du terrain de basketball.
+#include "observer_registry.hpp"
+#include "player_stats.hpp"
+#include "rules.hpp"
+
+// Dimensions du terrain par défaut (variante Rules5x5)
+constexpr float basket_x = Rules5x5::court_x; ///< Largeur du terrain de basketball.
+constexpr float basket_y = Rules5x5::court_y; ///< Hauteur du terrain de basketball.
 
 /**
  * @brief Structure représentant une position dans un espace 2D.
@@ -35,37 +41,46 @@ struct Position {
 
 /**
  * @brief Classe représentant un joueur dans le jeu de basketball.
+ *
+ * La taille des tables de voisins et la répartition en équipes viennent des règles
+ * @p Rules (voir GameRules). Les variantes Rules5x5, Rules3x3 et RulesDrill2x2 sont
+ * instanciées dans basket.cpp.
+ *
+ * @tparam Rules Règles de la variante de jeu.
  */
-class Player {
+template <class Rules>
+class BasicPlayer {
 public:
     Position position; ///< Position actuelle du joueur.
     bool possede_ball = false; ///< Indique si le joueur possède le ballon.
     int number; ///< Numéro attribué au joueur.
-    Player* Teammates[4]; ///< Tableau de pointeurs vers les coéquipiers.
-    Player* Opponents[5]; ///< Tableau de pointeurs vers les adversaires.
+    BasicPlayer* Teammates[Rules::teammates]; ///< Tableau de pointeurs vers les coéquipiers.
+    BasicPlayer* Opponents[Rules::opponents]; ///< Tableau de pointeurs vers les adversaires.
 
     /**
      * @brief Trouve les coéquipiers les plus proches.
      * @param players Liste de tous les joueurs.
      * @param team_id Identifiant de l'équipe.
      */
-    void find_teammates(const std::vector<Player>& players, int team_id);
+    void find_teammates(const std::vector<BasicPlayer>& players, int team_id);
 
     /**
      * @brief Trouve les adversaires les plus proches.
      * @param players Liste de tous les joueurs.
      * @param team_id Identifiant de l'équipe.
      */
-    void find_opponents(const std::vector<Player>& players, int team_id);
+    void find_opponents(const std::vector<BasicPlayer>& players, int team_id);
 };
 
 /**
  * @brief Classe représentant le ballon de basketball.
+ * @tparam Rules Règles de la variante de jeu.
  */
-class Ballon {
+template <class Rules>
+class BasicBallon {
 public:
     Position position; ///< Position actuelle du ballon.
-    Player* possesseur = nullptr; ///< Joueur qui possède actuellement le ballon.
+    BasicPlayer<Rules>* possesseur = nullptr; ///< Joueur qui possède actuellement le ballon.
 
     /**
      * @brief Change le possesseur du ballon pour le coéquipier le plus proche.
@@ -74,6 +89,34 @@ public:
     bool changer_possesseur();
 };
 
+extern template class BasicPlayer<Rules5x5>;
+extern template class BasicPlayer<Rules3x3>;
+extern template class BasicPlayer<RulesDrill2x2>;
+extern template class BasicBallon<Rules5x5>;
+extern template class BasicBallon<Rules3x3>;
+extern template class BasicBallon<RulesDrill2x2>;
+
+using Player = BasicPlayer<Rules5x5>; ///< Joueur d'un match classique à cinq contre cinq.
+using Ballon = BasicBallon<Rules5x5>; ///< Ballon d'un match classique à cinq contre cinq.
+
+/**
+ * @brief Événement de score transmis aux arbitres.
+ */
+struct ScoreEvent {
+    int homeScore; ///< Score de l'équipe à domicile.
+    int awayScore; ///< Score de l'équipe adverse.
+    std::uint64_t sequence; ///< Numéro d'ordre de l'événement.
+};
+
+/**
+ * @brief Politique appliquée lorsque la file de notification asynchrone est pleine.
+ */
+enum class BackPressure {
+    Drop, ///< L'événement est abandonné et comptabilisé.
+    Block, ///< Le producteur attend qu'une place se libère.
+    Coalesce ///< Seul le score le plus récent est conservé en attente.
+};
+
 /**
  * @brief Interface pour les arbitres observant le jeu (Pattern Observer).
  */
@@ -87,6 +130,16 @@ public:
      * @param awayScore Score de l'équipe adverse.
      */
     virtual void Update(int homeScore, int awayScore) = 0;
+
+    /**
+     * @brief Reçoit un lot d'événements de score (mode asynchrone).
+     *
+     * L'implémentation par défaut appelle Update() pour chaque événement.
+     *
+     * @param events Événements, du plus ancien au plus récent.
+     * @param count Nombre d'événements.
+     */
+    virtual void UpdateBatch(const ScoreEvent* events, std::size_t count);
 };
 
 /**
@@ -100,27 +153,54 @@ public:
      * @param awayScore Score de l'équipe adverse.
      */
     void Update(int homeScore, int awayScore) override;
+
+    /**
+     * @brief Affiche un lot de scores avec un seul vidage du flux.
+     * @param events Événements, du plus ancien au plus récent.
+     * @param count Nombre d'événements.
+     */
+    void UpdateBatch(const ScoreEvent* events, std::size_t count) override;
 };
 
+class AsyncNotifier;
+
 /**
  * @brief Classe gérant le score du jeu (Pattern Singleton et Observable).
+ *
+ * GetInstance() fournit le score partagé historique ; un moteur de match peut aussi
+ * posséder sa propre instance. Les champs homeScore et awayScore ne sont pas protégés :
+ * un score modifié par plusieurs threads passe par MatchScore (match_score.hpp), et la
+ * recherche d'un match par identifiant par ScoreRegistry plutôt que par GetInstance().
+ *
+ * La liste arbitres ne doit pas être modifiée pendant NotifyArbitres() ; les observateurs
+ * qui s'abonnent ou se désabonnent en cours de partie passent par Events(), dont la
+ * diffusion tolère ces modifications et filtre par type d'événement.
  */
 class Gamescore {
 private:
-    static Gamescore* instance; ///< Instance unique (Singleton).
+    std::unique_ptr<AsyncNotifier> notifier; ///< Notification asynchrone, nulle en mode synchrone.
+    ObserverRegistry events; ///< Abonnements par poignées aux événements de jeu.
 
+public:
     /**
-     * @brief Constructeur privé pour le pattern Singleton.
+     * @brief Constructeur d'un score indépendant, initialisé à 0 - 0.
      */
     Gamescore();
 
-public:
+    /**
+     * @brief Destructeur : vide et arrête la notification asynchrone éventuelle.
+     */
+    ~Gamescore();
+
     int homeScore; ///< Score actuel de l'équipe à domicile.
     int awayScore; ///< Score actuel de l'équipe adverse.
     std::vector<std::shared_ptr<Arbitre>> arbitres; ///< Liste des arbitres observant le jeu.
 
     /**
      * @brief Obtient l'instance unique de la classe Gamescore.
+     *
+     * L'instance est construite au premier appel, sans course entre threads.
+     *
      * @return Pointeur vers l'instance Singleton.
      */
     static Gamescore* GetInstance();
@@ -129,19 +209,48 @@ public:
      * @brief Ajoute un arbitre à la liste des observateurs.
      * @param arbitre Pointeur partagé vers l'arbitre.
      */
-    void AddArbitre(std::shared_ptr<Arbitre> arbitre);
+    void AddArbitre(const std::shared_ptr<Arbitre>& arbitre);
 
     /**
      * @brief Retire un arbitre de la liste des observateurs.
      * @param arbitre Pointeur partagé vers l'arbitre.
      */
-    void RemoveArbitre(std::shared_ptr<Arbitre> arbitre);
+    void RemoveArbitre(const std::shared_ptr<Arbitre>& arbitre);
+
+    /**
+     * @brief Registre des abonnés aux événements de jeu (score, possession, stratégie).
+     * @return Le registre.
+     */
+    ObserverRegistry& Events() { return events; }
 
     /**
      * @brief Notifie tous les arbitres des scores actuels.
+     *
+     * En mode asynchrone, le score est seulement déposé dans la file de notification.
+     * Les abonnés de Events() intéressés par EventType::Score sont notifiés sur le thread appelant.
      */
     void NotifyArbitres();
 
+    /**
+     * @brief Passe en notification asynchrone : les arbitres sont appelés par lots sur un thread dédié.
+     * @param capacity Capacité de la file (arrondie à une puissance de deux).
+     * @param policy Politique appliquée lorsque la file est pleine.
+     * @param batch Nombre maximal d'événements livrés par lot.
+     */
+    void EnableAsyncNotification(std::size_t capacity = 1024, BackPressure policy = BackPressure::Block,
+                                 std::size_t batch = 64);
+
+    /**
+     * @brief Revient en notification synchrone après avoir livré les événements en attente.
+     */
+    void DisableAsyncNotification();
+
+    /**
+     * @brief Notificateur asynchrone actif.
+     * @return Pointeur vers le notificateur, ou nullptr en mode synchrone.
+     */
+    AsyncNotifier* Notifier() const { return notifier.get(); }
+
     /**
      * @brief Met à jour les scores du jeu et notifie les arbitres.
      * @param home Score de l'équipe à domicile.
@@ -150,6 +259,16 @@ public:
     void UpdateScore(int home, int away);
 };
 
+/**
+ * @brief Consignes de jeu qu'une stratégie transmet au moteur de match.
+ *
+ * Les valeurs par défaut reproduisent le jeu sans stratégie.
+ */
+struct Tactics {
+    float shot_range_scale = 1.f; ///< Multiplie la distance à partir de laquelle le porteur tire.
+    float marking = 0.3f; ///< Part de l'écart entre vis-à-vis et panier que comble le défenseur.
+};
+
 /**
  * @brief Classe abstraite représentant une stratégie pour le coach.
  */
@@ -161,6 +280,18 @@ public:
      * @brief Exécute la stratégie.
      */
     virtual void ExecuteStrategy() = 0;
+
+    /**
+     * @brief Consignes appliquées par le moteur de match à l'équipe du coach.
+     * @return Les consignes.
+     */
+    virtual Tactics GetTactics() const { return Tactics(); }
+
+    /**
+     * @brief Nom court de la stratégie, utilisé par les exports.
+     * @return Le nom.
+     */
+    virtual const char* Name() const { return "strategy"; }
 };
 
 /**
@@ -172,6 +303,14 @@ public:
      * @brief Exécute la stratégie offensive.
      */
     void ExecuteStrategy() override;
+
+    /**
+     * @brief Tirs de plus loin, défense plus lâche.
+     * @return Les consignes.
+     */
+    Tactics GetTactics() const override;
+
+    const char* Name() const override { return "offensive"; } ///< Nom court.
 };
 
 /**
@@ -183,6 +322,14 @@ public:
      * @brief Exécute la stratégie défensive.
      */
     void ExecuteStrategy() override;
+
+    /**
+     * @brief Tirs plus proches, marquage serré.
+     * @return Les consignes.
+     */
+    Tactics GetTactics() const override;
+
+    const char* Name() const override { return "defensive"; } ///< Nom court.
 };
 
 /**
@@ -191,16 +338,32 @@ public:
 class Coach {
 private:
     Strategy* currentStrategy; ///< Stratégie actuelle appliquée par le coach.
+    ObserverRegistry* events = nullptr; ///< Registre notifié des changements de stratégie, ou nullptr.
+    int team = -1; ///< Équipe entraînée, rapportée dans les événements.
+    PlayerStatsTable stats; ///< Statistiques des joueurs observés.
 
 public:
     Coach(); ///< Constructeur par défaut.
 
     /**
-     * @brief Définit la stratégie actuelle.
+     * @brief Rattache le coach à un registre d'événements.
+     * @param registry Registre notifié à chaque SetStrategy(), ou nullptr.
+     * @param team Équipe entraînée.
+     */
+    void Attach(ObserverRegistry* registry, int team);
+
+    /**
+     * @brief Définit la stratégie actuelle et émet un événement EventType::Strategy si le coach est rattaché.
      * @param strategy Pointeur vers la stratégie.
      */
     void SetStrategy(Strategy* strategy);
 
+    /**
+     * @brief Stratégie actuelle.
+     * @return Pointeur vers la stratégie, ou nullptr.
+     */
+    Strategy* GetStrategy() const { return currentStrategy; }
+
     /**
      * @brief Applique la stratégie actuelle.
      */
@@ -208,13 +371,35 @@ public:
 
     /**
      * @brief Observe l'état d'un joueur.
+     *
+     * L'observation alimente les statistiques du coach (une observation par joueur et par
+     * tick) ; un rapport n'est émis qu'à la première observation du joueur et quand il
+     * prend ou perd le ballon.
+     *
      * @param player Joueur à observer.
      */
     void ObservePlayer(const Player& player);
+
+    /**
+     * @brief Statistiques des joueurs observés.
+     * @return La table, fusionnable avec celles d'autres coachs.
+     */
+    const PlayerStatsTable& Stats() const { return stats; }
+
+    /**
+     * @brief Statistiques des joueurs observés, modifiables (Restart() entre deux matchs, Clear()).
+     * @return La table.
+     */
+    PlayerStatsTable& Stats() { return stats; }
 };
 
+class TeamTree;
+
 /**
  * @brief Classe abstraite pour les composants dans le Pattern Composite.
+ *
+ * Pour les grandes hiérarchies, TeamTree (team_tree.hpp) range l'arbre à plat ;
+ * TeamNodeView en expose un nœud sous cette interface.
  */
 class TeamComponent {
 public:
@@ -224,6 +409,17 @@ public:
      * @brief Affiche les informations sur le composant.
      */
     virtual void Display() const = 0;
+
+    /**
+     * @brief Recopie le composant et ses descendants dans un arbre aplati.
+     *
+     * L'implémentation par défaut ne recopie rien.
+     *
+     * @param tree Arbre de destination.
+     * @param parent Groupe parent dans @p tree.
+     * @return L'identifiant du nœud créé, ou TeamTree::kNone.
+     */
+    virtual std::uint32_t FlattenInto(TeamTree& tree, std::uint32_t parent) const;
 };
 
 /**
@@ -240,6 +436,14 @@ public:
      * @brief Affiche les informations du joueur.
      */
     void Display() const override;
+
+    /**
+     * @brief Ajoute une feuille pour ce joueur dans un arbre aplati.
+     * @param tree Arbre de destination.
+     * @param parent Groupe parent dans @p tree.
+     * @return L'identifiant de la feuille.
+     */
+    std::uint32_t FlattenInto(TeamTree& tree, std::uint32_t parent) const override;
 };
 
 /**
@@ -266,6 +470,14 @@ public:
      * @brief Affiche les informations de l'équipe.
      */
     void Display() const override;
+
+    /**
+     * @brief Ajoute un groupe et, récursivement, ses composants dans un arbre aplati.
+     * @param tree Arbre de destination.
+     * @param parent Groupe parent dans @p tree.
+     * @return L'identifiant du groupe créé.
+     */
+    std::uint32_t FlattenInto(TeamTree& tree, std::uint32_t parent) const override;
 };
 
 #endif // BASKET_HPP
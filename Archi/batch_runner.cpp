@@ -0,0 +1,143 @@
+#include "batch_runner.hpp"
+#include <chrono>
+
+/**
+ * @brief Constructeur.
+ * @param threads Nombre de workers (0 : un par cœur).
+ */
+BatchRunner::BatchRunner(unsigned threads) : pool(threads) {}
+
+/**
+ * @brief Ancienne graine d'un match du lot (mélange de type splitmix).
+ * @param base Graine de base du lot.
+ * @param match_id Identifiant du match.
+ * @return La graine propre au match, jamais nulle.
+ */
+std::uint32_t BatchRunner::SeedFor(std::uint32_t base, std::uint64_t match_id) {
+    std::uint64_t z = base + (match_id + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    const std::uint32_t seed = static_cast<std::uint32_t>(z);
+    return seed ? seed : 1;
+}
+
+/**
+ * @brief Simule un lot de matchs.
+ * @param config Paramètres du lot.
+ * @param results Résultats indexés par identifiant de match.
+ */
+void BatchRunner::Run(const BatchConfig& config, std::vector<MatchResult>& results) {
+    RunMatches(config, results, false, nullptr, nullptr);
+}
+
+/**
+ * @brief Simule un lot de matchs en relevant les statistiques des joueurs.
+ * @param config Paramètres du lot.
+ * @param results Résultats indexés par identifiant de match.
+ * @param stats Table à laquelle les statistiques du lot sont ajoutées.
+ */
+void BatchRunner::Run(const BatchConfig& config, std::vector<MatchResult>& results, PlayerStatsTable& stats) {
+    worker_stats.assign(pool.Size(), PlayerStatsTable(stats.NearRadius()));
+    RunMatches(config, results, true, nullptr, nullptr);
+    for (const PlayerStatsTable& table : worker_stats) {
+        stats.Merge(table);
+    }
+}
+
+/**
+ * @brief Simule un lot de matchs en comptant la position des joueurs.
+ * @param config Paramètres du lot.
+ * @param results Résultats indexés par identifiant de match.
+ * @param heatmaps Cartes auxquelles le lot est ajouté.
+ */
+void BatchRunner::Run(const BatchConfig& config, std::vector<MatchResult>& results, HeatmapAccumulator& heatmaps) {
+    heatmaps.Resize(pool.Size());
+    RunMatches(config, results, false, &heatmaps, nullptr);
+    heatmaps.Reduce(pool);
+}
+
+/**
+ * @brief Simule un lot de matchs en exportant chacun dès qu'il se termine.
+ * @param config Paramètres du lot.
+ * @param results Résultats indexés par identifiant de match.
+ * @param exporter Export ouvert.
+ * @return False si l'export n'est pas ouvert ou si une écriture a échoué.
+ */
+bool BatchRunner::Run(const BatchConfig& config, std::vector<MatchResult>& results, ResultExporter& exporter) {
+    if (!exporter.IsOpen()) {
+        return false;
+    }
+    worker_stats.assign(pool.Size(), PlayerStatsTable());
+    export_ok = true;
+    RunMatches(config, results, true, nullptr, &exporter);
+    return export_ok;
+}
+
+/**
+ * @brief Simule un lot de matchs, chaque worker relevant éventuellement les statistiques dans sa table,
+ * les positions dans sa carte et exportant chaque match terminé.
+ * @param config Paramètres du lot.
+ * @param results Résultats indexés par identifiant de match.
+ * @param observe True pour relever les statistiques des joueurs dans worker_stats.
+ * @param heatmaps Cartes des workers à remplir, ou nullptr.
+ * @param exporter Export recevant chaque match terminé, ou nullptr ; avec un export, la table
+ *                 du worker est vidée à chaque match.
+ */
+void BatchRunner::RunMatches(const BatchConfig& config, std::vector<MatchResult>& results, bool observe,
+                             HeatmapAccumulator* heatmaps, ResultExporter* exporter) {
+    results.assign(config.matches, MatchResult{});
+
+    const auto start = std::chrono::steady_clock::now();
+    pool.ParallelFor(config.matches, [&](std::size_t id, unsigned worker) {
+        MatchConfig settings = config.match;
+        settings.match_id = id;
+
+        Match match(settings);
+        if (const std::size_t n = config.strategies.size()) {
+            match.coach(0).SetStrategy(config.strategies[id % n]);
+            match.coach(1).SetStrategy(config.strategies[(id / n) % n]);
+        }
+
+        PlayerStatsTable* stats = observe ? &worker_stats[worker] : nullptr;
+        if (stats && exporter) {
+            stats->Clear();
+        } else if (stats) {
+            stats->Restart();
+        }
+        Heatmap* heatmap = heatmaps ? &heatmaps->Local(worker) : nullptr;
+        if (stats || heatmap) {
+            for (std::uint64_t t = 0; t < config.ticks_per_match; ++t) {
+                match.tick();
+                if (stats) {
+                    for (const Player& player : match.players()) {
+                        stats->Observe(player);
+                    }
+                }
+                if (heatmap) {
+                    heatmap->AddPlayers(match.players());
+                }
+            }
+        } else {
+            for (std::uint64_t t = 0; t < config.ticks_per_match; ++t) {
+                match.tick();
+            }
+        }
+
+        MatchResult& result = results[id];
+        result.match_id = id;
+        result.homeScore = match.score().homeScore;
+        result.awayScore = match.score().awayScore;
+        result.ticks = match.tick_count();
+
+        if (exporter) {
+            const Strategy* home = match.coach(0).GetStrategy();
+            const Strategy* away = match.coach(1).GetStrategy();
+            if (!exporter->Append(result, home ? home->Name() : nullptr, away ? away->Name() : nullptr, *stats)) {
+                export_ok = false;
+            }
+        }
+    });
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    last_matches_per_second = seconds.count() > 0.0 ? config.matches / seconds.count() : 0.0;
+}
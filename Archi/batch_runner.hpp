@@ -0,0 +1,156 @@
+/**
+ * @file batch_runner.hpp
+ * @brief Exécution parallèle de lots de matchs indépendants.
+ */
+
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include "heatmap.hpp"
+#include "match.hpp"
+#include "player_stats.hpp"
+#include "result_export.hpp"
+#include "work_stealing_pool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Paramètres d'un lot de matchs.
+ */
+struct BatchConfig {
+    std::size_t matches = 1; ///< Nombre de matchs à simuler.
+    std::uint64_t ticks_per_match = 72000; ///< Durée d'un match en ticks (48 minutes à 25 Hz).
+    MatchConfig match; ///< Paramètres communs ; match_id est remplacé par l'identifiant du match dans le lot.
+    std::vector<Strategy*> strategies; ///< Stratégies partagées entre workers, sans état (non possédées) ; voir BatchRunner.
+};
+
+/**
+ * @brief Résultat final d'un match du lot.
+ */
+struct MatchResult {
+    std::uint64_t match_id = 0; ///< Identifiant du match dans le lot.
+    int homeScore = 0; ///< Score final de l'équipe à domicile.
+    int awayScore = 0; ///< Score final de l'équipe adverse.
+    std::uint64_t ticks = 0; ///< Nombre de ticks simulés.
+};
+
+/**
+ * @brief Exécute N matchs indépendants sur tous les cœurs.
+ *
+ * Chaque match est construit sur la pile du worker qui l'exécute et possède son propre
+ * Gamescore : aucun état n'est partagé entre matchs, et le singleton
+ * Gamescore::GetInstance() n'est jamais utilisé. Chaque worker écrit le résultat
+ * dans la case réservée au match, ce qui évite tout verrou global lors de la collecte.
+ * Les tirages d'un match ne dépendent que de la graine du lot, de son identifiant,
+ * du joueur et du tick (counter_rng.hpp) : les résultats sont identiques quel que soit
+ * le nombre de threads, et un match du lot se rejoue seul avec
+ * MatchConfig{.seed = graine, .match_id = identifiant}.
+ *
+ * Avec n stratégies dans BatchConfig::strategies, le match id oppose strategies[id % n]
+ * (domicile) à strategies[(id / n) % n] : n² matchs consécutifs couvrent toutes les paires.
+ * Une même stratégie est donnée aux coachs de matchs joués en même temps sur plusieurs
+ * workers, qui appellent GetTactics() et Name() sans synchronisation : elle doit être sans
+ * état et thread-safe, comme OffensiveStrategy et DefensiveStrategy. Une stratégie à état
+ * ou liée à un match, comme BasicSearchStrategy, ne convient pas. Les événements Strategy
+ * émis par Coach::SetStrategy() ne vont qu'au registre de chaque match.
+ */
+class BatchRunner {
+public:
+    /**
+     * @brief Constructeur.
+     * @param threads Nombre de workers (0 : un par cœur).
+     */
+    explicit BatchRunner(unsigned threads = 0);
+
+    /**
+     * @brief Simule un lot de matchs.
+     * @param config Paramètres du lot.
+     * @param results Résultats, redimensionnés à config.matches et indexés par identifiant de match.
+     */
+    void Run(const BatchConfig& config, std::vector<MatchResult>& results);
+
+    /**
+     * @brief Simule un lot de matchs en relevant les statistiques de chaque joueur à chaque tick.
+     *
+     * Chaque worker remplit sa propre table ; les tables sont fusionnées dans @p stats à la
+     * fin du lot. Les joueurs sont identifiés par leur numéro dans le match.
+     *
+     * @param config Paramètres du lot.
+     * @param results Résultats, redimensionnés à config.matches et indexés par identifiant de match.
+     * @param stats Table à laquelle les statistiques du lot sont ajoutées.
+     */
+    void Run(const BatchConfig& config, std::vector<MatchResult>& results, PlayerStatsTable& stats);
+
+    /**
+     * @brief Simule un lot de matchs en comptant la position de chaque joueur à chaque tick.
+     *
+     * @p heatmaps est redimensionné à une carte par worker ; chaque worker n'écrit que dans
+     * la sienne, puis les cartes sont réduites en arbre sur le pool à la fin du lot.
+     *
+     * @param config Paramètres du lot.
+     * @param results Résultats, redimensionnés à config.matches et indexés par identifiant de match.
+     * @param heatmaps Cartes auxquelles le lot est ajouté (Heatmap::LayersFor<Rules5x5>() couches) ;
+     *                 le total est dans heatmaps.Local(0).
+     */
+    void Run(const BatchConfig& config, std::vector<MatchResult>& results, HeatmapAccumulator& heatmaps);
+
+    /**
+     * @brief Simule un lot de matchs en exportant chacun en colonnes dès qu'il se termine.
+     *
+     * Chaque worker relève les statistiques de ses joueurs dans sa table, vidée à chaque
+     * match, puis verse le résultat, les stratégies et les statistiques dans @p exporter.
+     *
+     * @param config Paramètres du lot.
+     * @param results Résultats, redimensionnés à config.matches et indexés par identifiant de match.
+     * @param exporter Export ouvert ; il reste ouvert, à fermer par l'appelant.
+     * @return False si l'export n'est pas ouvert ou si une écriture a échoué.
+     */
+    bool Run(const BatchConfig& config, std::vector<MatchResult>& results, ResultExporter& exporter);
+
+    /**
+     * @brief Débit du dernier lot.
+     * @return Le nombre de matchs simulés par seconde.
+     */
+    double MatchesPerSecond() const { return last_matches_per_second; }
+
+    /**
+     * @brief Pool de threads utilisé par le lot.
+     * @return Le pool.
+     */
+    WorkStealingPool& Pool() { return pool; }
+
+    /**
+     * @brief Ancienne graine d'un match du lot (mélange de type splitmix).
+     *
+     * Run() ne s'en sert plus : un match du lot garde la graine du lot et se distingue par
+     * MatchConfig::match_id. Un match rejoué avec cette graine ne reproduit donc plus le
+     * match du lot ; utiliser MatchConfig{.seed = base, .match_id = match_id}.
+     *
+     * @param base Graine de base du lot.
+     * @param match_id Identifiant du match.
+     * @return La graine que Run() donnait au match, jamais nulle.
+     */
+    [[deprecated("les matchs d'un lot sont distingués par MatchConfig::match_id")]]
+    static std::uint32_t SeedFor(std::uint32_t base, std::uint64_t match_id);
+
+private:
+    WorkStealingPool pool; ///< Workers à vol de tâches.
+    std::vector<PlayerStatsTable> worker_stats; ///< Table de chaque worker pendant un lot avec statistiques.
+
+    /**
+     * @brief Simule un lot de matchs.
+     * @param config Paramètres du lot.
+     * @param results Résultats indexés par identifiant de match.
+     * @param observe True pour relever les statistiques des joueurs dans worker_stats.
+     * @param heatmaps Cartes des workers à remplir, ou nullptr.
+     * @param exporter Export recevant chaque match terminé, ou nullptr.
+     */
+    void RunMatches(const BatchConfig& config, std::vector<MatchResult>& results, bool observe,
+                    HeatmapAccumulator* heatmaps, ResultExporter* exporter);
+    double last_matches_per_second = 0.0; ///< Débit du dernier lot.
+    std::atomic<bool> export_ok{true}; ///< Faux si un ajout à l'export du lot a échoué.
+};
+
+#endif // BATCH_RUNNER_HPP
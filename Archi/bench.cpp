@@ -0,0 +1,956 @@
+/**
+ * @file bench.cpp
+ * @brief Microbenchmarks des chemins critiques de la bibliothèque, avec sortie JSON.
+ *
+ * Usage : basket_bench [--filter=texte] [--min-time=secondes] [--json=fichier|-]
+ *
+ * Chaque cas mesure le temps par opération (ns/op), le nombre d'allocations par
+ * opération (via un operator new instrumenté) et le débit en éléments par seconde.
+ */
+
+#include "agent_scheduler.hpp"
+#include "basket.hpp"
+#include "column_store.hpp"
+#include "counter_rng.hpp"
+#include "heatmap.hpp"
+#include "match.hpp"
+#include "metrics.hpp"
+#include "motion_batch.hpp"
+#include "neighbour_tracker.hpp"
+#include "observer_registry.hpp"
+#include "output_sink.hpp"
+#include "pass_evaluator.hpp"
+#include "player_pool.hpp"
+#include "player_stats.hpp"
+#include "shot_model.hpp"
+#include "search_strategy.hpp"
+#include "team_tree.hpp"
+#include "what_if.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0}; ///< Nombre d'allocations depuis le démarrage.
+
+/**
+ * @brief Allocation comptée, commune à toutes les formes d'operator new.
+ * @param size Octets demandés.
+ * @param alignment Alignement demandé (0 : celui de malloc).
+ * @return Le bloc, ou nullptr si la mémoire manque.
+ */
+void* counted_allocate(std::size_t size, std::size_t alignment) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    size = size ? size : 1;
+    if (alignment == 0) {
+        return std::malloc(size);
+    }
+    // aligned_alloc exige une taille multiple de l'alignement
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+/**
+ * @brief Libération commune à toutes les formes d'operator delete.
+ * @param p Bloc rendu par counted_allocate(), ou nullptr.
+ */
+void counted_release(void* p) noexcept {
+    std::free(p);
+}
+
+/**
+ * @brief Allocation comptée qui lève std::bad_alloc si la mémoire manque.
+ */
+void* counted_allocate_or_throw(std::size_t size, std::size_t alignment) {
+    if (void* p = counted_allocate(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+// Jeu complet : formes simples, tableaux, nothrow, alignées et dimensionnées, pour que
+// chaque new compté soit rendu par le delete correspondant
+void* operator new(std::size_t size) {
+    return counted_allocate_or_throw(size, 0);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_allocate_or_throw(size, 0);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, 0);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return counted_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return counted_allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept {
+    counted_release(p);
+}
+
+void operator delete[](void* p) noexcept {
+    counted_release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    counted_release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    counted_release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    counted_release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    counted_release(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    counted_release(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    counted_release(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    counted_release(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    counted_release(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    counted_release(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    counted_release(p);
+}
+
+namespace {
+
+/**
+ * @brief Empêche le compilateur d'éliminer un calcul dont le résultat n'est pas utilisé.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Résultat d'un cas de benchmark.
+ */
+struct BenchResult {
+    std::string name; ///< Nom du cas, paramètres compris.
+    std::uint64_t iterations; ///< Nombre d'opérations mesurées.
+    double ns_per_op; ///< Temps moyen par opération.
+    double allocs_per_op; ///< Allocations moyennes par opération.
+    double items_per_second; ///< Débit en éléments traités par seconde.
+};
+
+/**
+ * @brief Exécute les cas de benchmark et collecte leurs résultats.
+ */
+class BenchRunner {
+public:
+    /**
+     * @brief Constructeur.
+     * @param min_time Durée minimale de mesure par cas, en secondes.
+     * @param filter Seuls les cas dont le nom contient ce texte sont exécutés.
+     */
+    BenchRunner(double min_time, std::string filter) : min_time(min_time), filter(std::move(filter)) {}
+
+    /**
+     * @brief Mesure un cas : le nombre d'itérations croît jusqu'à dépasser la durée minimale.
+     * @param name Nom du cas.
+     * @param items Éléments traités par opération (pour le débit).
+     * @param op Opération à mesurer.
+     */
+    template <typename Op>
+    void Run(const std::string& name, std::uint64_t items, Op&& op) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            return;
+        }
+        op();
+
+        std::uint64_t iterations = 1;
+        for (;;) {
+            const std::uint64_t allocs_before = g_allocations.load(std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                op();
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            const std::uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - allocs_before;
+
+            if (elapsed.count() >= min_time || iterations >= (1ull << 40)) {
+                const double seconds = elapsed.count();
+                results.push_back(BenchResult{name, iterations, seconds * 1e9 / iterations,
+                                              static_cast<double>(allocs) / iterations,
+                                              seconds > 0 ? items * iterations / seconds : 0.0});
+                std::cerr << std::left << std::setw(40) << name << std::right << std::setw(14)
+                          << std::fixed << std::setprecision(1) << results.back().ns_per_op << " ns/op"
+                          << std::setw(10) << std::setprecision(2) << results.back().allocs_per_op << " allocs/op"
+                          << std::setw(16) << std::setprecision(0) << results.back().items_per_second << " items/s\n";
+                return;
+            }
+            const double scale = elapsed.count() > 0 ? 1.4 * min_time / elapsed.count() : 10.0;
+            iterations = static_cast<std::uint64_t>(iterations * std::min(std::max(scale, 2.0), 100.0));
+        }
+    }
+
+    /**
+     * @brief Écrit les résultats au format JSON.
+     * @param out Flux de sortie.
+     */
+    void WriteJson(std::ostream& out) const {
+        out << "{\n  \"context\": {\n"
+            << "    \"compiler\": \"" << compiler() << "\",\n"
+#ifdef NDEBUG
+            << "    \"assertions\": false,\n"
+#else
+            << "    \"assertions\": true,\n"
+#endif
+            << "    \"min_time\": " << min_time << "\n  },\n  \"benchmarks\": [\n";
+        out << std::setprecision(6);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << r.ns_per_op << ", \"allocs_per_op\": " << r.allocs_per_op
+                << ", \"items_per_second\": " << r.items_per_second << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+private:
+    double min_time; ///< Durée minimale de mesure par cas.
+    std::string filter; ///< Filtre sur les noms.
+    std::vector<BenchResult> results; ///< Résultats collectés.
+
+    /**
+     * @brief Identification du compilateur.
+     */
+    static const char* compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+};
+
+/**
+ * @brief Tampon de flux qui ignore tout ce qu'on y écrit.
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+/**
+ * @brief Arbitre sans entrée-sortie, pour mesurer le seul coût de la notification.
+ */
+class NullArbitre : public Arbitre {
+public:
+    int last = 0; ///< Dernier score reçu.
+    void Update(int homeScore, int awayScore) override { last = homeScore + awayScore; }
+};
+
+/**
+ * @brief Observateur d'événements sans entrée-sortie.
+ */
+class NullObserver : public GameObserver {
+public:
+    int last = 0; ///< Dernier score reçu.
+    void OnEvent(const GameEvent& event) override { last = event.homeScore + event.awayScore; }
+};
+
+/**
+ * @brief Stratégie sans entrée-sortie : référence d'un appel virtuel par agent et par tick.
+ */
+class CountingStrategy : public Strategy {
+public:
+    std::uint64_t* counter; ///< Compteur partagé.
+    explicit CountingStrategy(std::uint64_t* counter) : counter(counter) {}
+    void ExecuteStrategy() override { ++*counter; }
+};
+
+/**
+ * @brief Agent sans fin : le même travail que CountingStrategy, repris à chaque tick.
+ */
+AgentTask counting_agent(std::uint64_t* counter) {
+    for (;;) {
+        ++*counter;
+        co_await NextTick();
+    }
+}
+
+/**
+ * @brief Agent qui se termine aussitôt : mesure la création et la destruction d'un cadre.
+ */
+AgentTask empty_agent() {
+    co_return;
+}
+
+/**
+ * @brief Crée des joueurs répartis de façon déterministe sur le terrain.
+ * @param count Nombre de joueurs (cinq par équipe).
+ */
+std::vector<Player> make_players(int count) {
+    std::vector<Player> players;
+    players.reserve(count);
+    std::uint32_t state = 12345;
+    for (int i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const float x = (state >> 8) * (basket_x / 16777216.f);
+        state = state * 1664525u + 1013904223u;
+        const float y = (state >> 8) * (basket_y / 16777216.f);
+        players.push_back(Player{Position{x, y}, false, i, {}, {}});
+    }
+    return players;
+}
+
+/**
+ * @brief Benchmarks de distance et de recherche des voisins.
+ */
+void bench_neighbours(BenchRunner& bench) {
+    Position a{12.f, 7.f};
+    Position b{43.f, 31.f};
+    bench.Run("distance_to", 1, [&] {
+        do_not_optimize(a);
+        do_not_optimize(b);
+        do_not_optimize(a.distance_to(b));
+    });
+
+    for (int count : {10, 20, 50, 100, 200}) {
+        std::vector<Player> players = make_players(count);
+        std::size_t next = 0;
+        const std::string suffix = "/players:" + std::to_string(count);
+
+        bench.Run("find_teammates" + suffix, 1, [&] {
+            Player& player = players[next++ % players.size()];
+            player.find_teammates(players, player.number / 5);
+            do_not_optimize(player.Teammates);
+        });
+        bench.Run("find_opponents" + suffix, 1, [&] {
+            Player& player = players[next++ % players.size()];
+            player.find_opponents(players, player.number / 5);
+            do_not_optimize(player.Opponents);
+        });
+
+        PlayerPool pool(players.size());
+        pool.Load(players);
+        bench.Run("player_pool_refresh" + suffix, count, [&] {
+            pool.RefreshNeighbours(players);
+            do_not_optimize(players.front().Teammates);
+        });
+    }
+}
+
+/**
+ * @brief Déplace chaque joueur d'un pas en ligne droite, avec rebond sur les bords du terrain.
+ * @param players Joueurs à déplacer.
+ * @param velocity Déplacement par pas de chaque joueur, inversé à chaque rebond.
+ */
+void drift_players(std::vector<Player>& players, std::vector<Position>& velocity) {
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        Position& p = players[i].position;
+        Position& v = velocity[i];
+        p.x += v.x;
+        p.y += v.y;
+        if (p.x < 0.f || p.x > basket_x) {
+            v.x = -v.x;
+            p.x += 2 * v.x;
+        }
+        if (p.y < 0.f || p.y > basket_y) {
+            v.y = -v.y;
+            p.y += 2 * v.y;
+        }
+    }
+}
+
+/**
+ * @brief Benchmarks du maintien des voisins d'un effectif en mouvement : recalcul complet
+ * contre suivi incrémental, pour plusieurs vitesses (unités par tick).
+ */
+void bench_tracking(BenchRunner& bench) {
+    for (float step : {0.02f, 0.24f}) {
+        const std::string suffix = "/step:" + std::to_string(step).substr(0, 4);
+        std::vector<Player> players = make_players(10);
+        std::vector<Position> velocity;
+        for (int i = 0; i < 10; ++i) {
+            velocity.push_back(Position{step * std::cos(0.7f * i), step * std::sin(0.7f * i)});
+        }
+
+        PlayerPool pool;
+        pool.Load(players);
+        bench.Run("neighbours_full" + suffix, 10, [&] {
+            drift_players(players, velocity);
+            pool.RefreshNeighbours(players);
+            do_not_optimize(players.front().Teammates);
+        });
+
+        NeighbourTracker tracker;
+        tracker.Reset(players);
+        bench.Run("neighbours_kinetic" + suffix, 10, [&] {
+            drift_players(players, velocity);
+            do_not_optimize(tracker.Update(players));
+        });
+    }
+}
+
+/**
+ * @brief Benchmarks du changement de possesseur et du choix de la passe.
+ */
+void bench_possession(BenchRunner& bench) {
+    std::vector<Player> players = make_players(10);
+    PlayerPool pool;
+    pool.RefreshNeighbours(players);
+    Ballon ballon{players[0].position, &players[0]};
+    bench.Run("changer_possesseur", 1, [&] {
+        ballon.possesseur = &players[0];
+        do_not_optimize(ballon.changer_possesseur());
+    });
+
+    PassEvaluator evaluator;
+    const Position basket = Match::target_basket(0);
+    std::size_t next = 0;
+    bench.Run("pass_evaluate", PassEvaluator::kLanes, [&] {
+        do_not_optimize(evaluator.Evaluate(players[next++ % 5], basket));
+        do_not_optimize(evaluator.Best());
+    });
+}
+
+/**
+ * @brief Benchmarks de la notification synchrone des arbitres.
+ */
+void bench_observers(BenchRunner& bench) {
+    for (int count : {1, 10, 100, 1000}) {
+        Gamescore score;
+        for (int i = 0; i < count; ++i) {
+            score.AddArbitre(std::make_shared<NullArbitre>());
+        }
+        bench.Run("notify_arbitres/observers:" + std::to_string(count), count, [&] {
+            score.NotifyArbitres();
+        });
+    }
+
+    // Registre filtré : seul un observateur sur dix suit le score
+    for (int count : {10, 100, 1000}) {
+        ObserverRegistry registry;
+        std::vector<Subscription> handles;
+        for (int i = 0; i < count; ++i) {
+            const EventMask mask = i % 10 == 0 ? kAllEvents : MaskOf(EventType::Possession);
+            handles.push_back(registry.Subscribe(std::make_shared<NullObserver>(), mask));
+        }
+        const GameEvent event{EventType::Score, 2, 0};
+        bench.Run("registry_notify/observers:" + std::to_string(count), count / 10, [&] {
+            registry.Notify(event);
+        });
+        std::size_t next = 0;
+        bench.Run("registry_resubscribe/observers:" + std::to_string(count), 1, [&] {
+            Subscription& handle = handles[next++ % handles.size()];
+            registry.Unsubscribe(handle);
+            handle = registry.Subscribe(std::make_shared<NullObserver>(), MaskOf(EventType::Possession));
+        });
+    }
+}
+
+/**
+ * @brief Benchmarks des agents en coroutines : reprise par l'ordonnanceur contre un appel
+ * virtuel de Strategy::ExecuteStrategy par agent, et cycle de vie d'un cadre.
+ */
+void bench_agents(BenchRunner& bench) {
+    for (int count : {100, 10000}) {
+        std::uint64_t counter = 0;
+        std::vector<std::unique_ptr<Strategy>> strategies;
+        for (int i = 0; i < count; ++i) {
+            strategies.push_back(std::make_unique<CountingStrategy>(&counter));
+        }
+        bench.Run("virtual_execute/agents:" + std::to_string(count), count, [&] {
+            for (const auto& strategy : strategies) {
+                strategy->ExecuteStrategy();
+            }
+        });
+
+        AgentScheduler scheduler;
+        for (int i = 0; i < count; ++i) {
+            scheduler.Spawn(counting_agent(&counter));
+        }
+        bench.Run("agent_resume/agents:" + std::to_string(count), count, [&] { scheduler.Tick(); });
+        do_not_optimize(counter);
+    }
+
+    AgentScheduler scheduler;
+    bench.Run("agent_spawn_finish", 1, [&] {
+        scheduler.Spawn(empty_agent());
+        scheduler.Tick();
+    });
+}
+
+/**
+ * @brief Construit en pré-ordre une ligue équilibrée d'équipes de cinq joueurs.
+ * @param tree Arbre à remplir.
+ * @param parent Groupe parent.
+ * @param players Joueurs, cinq par équipe.
+ * @param first Première équipe du groupe.
+ * @param teams Nombre d'équipes du groupe.
+ */
+void build_league(TeamTree& tree, TeamTree::NodeId parent, std::vector<Player>& players, int first, int teams) {
+    if (teams == 1) {
+        const TeamTree::NodeId team = tree.AddGroup(parent);
+        for (int p = 0; p < 5; ++p) {
+            tree.AddLeaf(team, &players[5 * first + p]);
+        }
+        return;
+    }
+    const int chunk = (teams + 7) / 8;
+    for (int t = first; t < first + teams; t += chunk) {
+        build_league(tree, tree.AddGroup(parent), players, t, std::min(chunk, first + teams - t));
+    }
+}
+
+/**
+ * @brief Benchmarks de l'affichage d'équipes composites, pointeurs contre arbre aplati
+ * (sortie standard neutralisée), du parcours groupé des feuilles et des agrégats en cache.
+ */
+void bench_composite(BenchRunner& bench) {
+    NullBuffer null_buffer;
+    for (int leaves : {10, 100, 1000}) {
+        std::vector<Player> players = make_players(leaves);
+        std::vector<std::unique_ptr<PlayerLeaf>> leaf_nodes;
+        std::vector<std::unique_ptr<TeamComposite>> teams;
+        TeamComposite root;
+        for (int i = 0; i < leaves; ++i) {
+            if (i % 5 == 0) {
+                teams.push_back(std::make_unique<TeamComposite>());
+                root.Add(teams.back().get());
+            }
+            leaf_nodes.push_back(std::make_unique<PlayerLeaf>(&players[i]));
+            teams.back()->Add(leaf_nodes.back().get());
+        }
+
+        TeamTree tree;
+        tree.Append(TeamTree::kRoot, root);
+
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+        bench.Run("team_display/leaves:" + std::to_string(leaves), leaves, [&] { root.Display(); });
+        bench.Run("team_tree_display/leaves:" + std::to_string(leaves), leaves, [&] { tree.Display(); });
+        std::cout.rdbuf(saved);
+
+        bench.Run("team_tree_leaves/leaves:" + std::to_string(leaves), leaves, [&] {
+            float sum = 0.f;
+            tree.ForEachLeaf(TeamTree::kRoot, [&](const Player& player) { sum += player.position.x; });
+            do_not_optimize(sum);
+        });
+
+        // Ligue équilibrée (au plus 8 enfants par groupe) : un joueur bouge, la forme de la
+        // ligue est relue.
+        TeamTree league;
+        build_league(league, TeamTree::kRoot, players, 0, leaves / 5);
+        std::vector<TeamTree::NodeId> leaf_ids;
+        for (TeamTree::NodeId i = 0; i < league.Size(); ++i) {
+            if (league.IsLeaf(i)) {
+                leaf_ids.push_back(i);
+            }
+        }
+        std::size_t next = 0;
+        bench.Run("team_tree_aggregate/leaves:" + std::to_string(leaves), 1, [&] {
+            const TeamTree::NodeId leaf = leaf_ids[next++ % leaf_ids.size()];
+            league.At(leaf).player->position.x += 0.01f;
+            league.Invalidate(leaf);
+            do_not_optimize(league.Aggregate().Centroid());
+        });
+    }
+}
+
+/**
+ * @brief Benchmarks d'une ligne de rapport d'arbitre selon le puits et le seuil d'envoi.
+ *
+ * `endl` reproduit l'ancien comportement (flux vidé à chaque ligne) vers /dev/null.
+ */
+void bench_reporting(BenchRunner& bench) {
+    const int dev_null = ::open("/dev/null", O_WRONLY);
+    if (dev_null < 0) {
+        return;
+    }
+    RefereeDisplay referee;
+    int score = 0;
+
+    {
+        std::ofstream out("/dev/null");
+        bench.Run("report_line/endl", 1, [&] {
+            ++score;
+            out << "[Arbitre] Score mis à jour : Home " << score << " - Away " << score << std::endl;
+        });
+    }
+
+    FdSink fd(dev_null);
+    RingSink ring;
+    NullSink null;
+    const std::pair<const char*, OutputSink*> sinks[] = {{"fd", &fd}, {"ring", &ring}, {"null", &null}};
+    for (const auto& [name, sink] : sinks) {
+        SetOutputSink(sink);
+        for (std::size_t threshold : {std::size_t(0), std::size_t(4096)}) {
+            SetReportFlushThreshold(threshold);
+            bench.Run(std::string("report_line/sink:") + name + "/threshold:" + std::to_string(threshold), 1,
+                      [&] {
+                          ++score;
+                          referee.Update(score, score);
+                      });
+            FlushReports();
+        }
+    }
+    SetReportFlushThreshold(0);
+    SetOutputSink(nullptr);
+    ::close(dev_null);
+}
+
+/**
+ * @brief Benchmarks de l'intégration des déplacements : joueur par joueur contre paquets AoSoA.
+ */
+void bench_motion(BenchRunner& bench) {
+    constexpr float dt = 0.04f;
+    const MotionLimits limits;
+    for (int games : {1, 64, 4096}) {
+        const int bodies = games * MotionBatch::kBodies;
+
+        // Référence : un corps à la fois, position et vitesse entrelacées
+        struct Body {
+            Position position;
+            float vx, vy, ax, ay;
+        };
+        std::vector<Body> scalar(bodies);
+        for (int i = 0; i < bodies; ++i) {
+            scalar[i] = Body{Position{float(i % 28), float(i % 15)}, 0.f, 0.f, (i % 7) - 3.f, (i % 5) - 2.f};
+        }
+        bench.Run("motion_scalar/games:" + std::to_string(games), bodies, [&] {
+            for (Body& b : scalar) {
+                const float a = std::sqrt(b.ax * b.ax + b.ay * b.ay);
+                const float as = a > limits.player_accel ? limits.player_accel / a : 1.f;
+                b.vx += b.ax * as * dt;
+                b.vy += b.ay * as * dt;
+                const float v = std::sqrt(b.vx * b.vx + b.vy * b.vy);
+                if (v > limits.player_speed) {
+                    b.vx *= limits.player_speed / v;
+                    b.vy *= limits.player_speed / v;
+                }
+                b.position.x += b.vx * dt;
+                b.position.y += b.vy * dt;
+                if (b.position.x < 0.f || b.position.x > basket_x) {
+                    b.position.x = std::fmin(std::fmax(b.position.x, 0.f), basket_x);
+                    b.vx = 0.f;
+                }
+                if (b.position.y < 0.f || b.position.y > basket_y) {
+                    b.position.y = std::fmin(std::fmax(b.position.y, 0.f), basket_y);
+                    b.vy = 0.f;
+                }
+            }
+            do_not_optimize(scalar[0].position.x);
+        });
+
+        MotionBatch batch(games, limits);
+        for (int g = 0; g < games; ++g) {
+            for (int b = 0; b < MotionBatch::kBodies; ++b) {
+                const int i = g * MotionBatch::kBodies + b;
+                batch.SetBody(g, b, Position{float(i % 28), float(i % 15)});
+                batch.SetAcceleration(g, b, (i % 7) - 3.f, (i % 5) - 2.f);
+            }
+        }
+        bench.Run("motion_batch/games:" + std::to_string(games), bodies, [&] {
+            batch.Step(dt);
+            do_not_optimize(batch.Blocks()[0].x[0]);
+        });
+    }
+}
+
+/**
+ * @brief Benchmarks d'un tick complet du moteur de match, de la reprise d'un état, des choix de
+ * stratégie, d'une résolution de tir, d'un ajout au score atomique et des statistiques par joueur.
+ */
+void bench_match(BenchRunner& bench) {
+    Match match;
+    bench.Run("match_tick", 1, [&] { match.tick(); });
+
+    const GameState state = match.snapshot();
+    Match fork;
+    bench.Run("game_state_restore", 1, [&] {
+        fork.restore(state);
+        do_not_optimize(fork.tick_count());
+    });
+
+    OffensiveStrategy offense;
+    DefensiveStrategy defense;
+    Strategy* candidates[] = {&offense, &defense};
+    WhatIf what_if;
+    bench.Run("what_if_choose/forks:2x64/horizon:25", 128, [&] {
+        do_not_optimize(what_if.Choose(match, 0, candidates, 2, 64, 25));
+    });
+
+    WorkStealingPool pool;
+    SearchConfig config;
+    SearchStrategy search(pool, {&offense, &defense}, config);
+    bench.Run("search_decide/rollouts:" + std::to_string(config.rollouts), config.rollouts, [&] {
+        do_not_optimize(search.Decide(match, 0));
+    });
+
+    Player shooter{Position{40.f, 25.f}, true, 0, {}, {}};
+    Player defender{Position{41.f, 25.f}, false, 5, {}, {}};
+    shooter.Opponents[0] = &defender;
+    const Position basket{basket_x, 25.f};
+    float draw = 0.f;
+    bench.Run("shot_resolve", 1, [&] {
+        draw = draw < 0.99f ? draw + 0.01f : 0.f;
+        shooter.position.x = basket.x - 12.f * draw;
+        do_not_optimize(ShotModel::Resolve(shooter, basket, draw));
+    });
+
+    MatchScore score;
+    int team = 0;
+    bench.Run("match_score_add", 1, [&] {
+        team ^= 1;
+        do_not_optimize(score.Add(team, 2));
+    });
+
+    PlayerStatsTable stats;
+    bench.Run("player_stats_observe/players:10", Rules5x5::players, [&] {
+        match.tick();
+        for (const Player& player : match.players()) {
+            stats.Observe(player);
+        }
+    });
+    PlayerStatsTable totals;
+    bench.Run("player_stats_merge", 1, [&] {
+        totals.Merge(stats);
+        do_not_optimize(totals.Size());
+    });
+}
+
+/**
+ * @brief Benchmarks des tirages : std::mt19937 partagé contre Philox, tirage par tirage et en bloc.
+ */
+void bench_random(BenchRunner& bench) {
+    constexpr std::size_t kDraws = 1024;
+    std::vector<float> out(kDraws);
+
+    std::mt19937 mt(1);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    bench.Run("random_mt19937/draws:1024", kDraws, [&] {
+        for (float& value : out) {
+            value = unit(mt);
+        }
+        do_not_optimize(out.data());
+    });
+
+    const PhiloxKey key = KeyFor(1, 0);
+    std::uint32_t tick = 0;
+    bench.Run("random_philox_stream/draws:1024", kDraws, [&] {
+        CounterStream stream(key, ++tick, 0, RandomStream::Match);
+        for (float& value : out) {
+            value = stream.NextFloat();
+        }
+        do_not_optimize(out.data());
+    });
+    bench.Run("random_philox_bulk/draws:1024", kDraws, [&] {
+        PhiloxUniform(key, PhiloxBlock{{0, ++tick, 0, 1}}, kDraws, out.data());
+        do_not_optimize(out.data());
+    });
+}
+
+/**
+ * @brief Benchmarks des cartes d'occupation : binning d'un tick de joueurs, binning en masse
+ * et réduction en arbre des cartes de quatre workers.
+ */
+void bench_heatmap(BenchRunner& bench) {
+    Match match;
+    Heatmap court(HeatmapGrid(), Heatmap::LayersFor<Rules5x5>());
+    bench.Run("heatmap_add_players/players:10", Rules5x5::players, [&] {
+        court.AddPlayers(match.players());
+        do_not_optimize(court.Layer(0));
+    });
+
+    constexpr std::size_t kPositions = 4096;
+    std::vector<float> xs(kPositions);
+    std::vector<float> ys(kPositions);
+    std::mt19937 mt(1);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    for (std::size_t i = 0; i < kPositions; ++i) {
+        xs[i] = unit(mt) * basket_x;
+        ys[i] = unit(mt) * basket_y;
+    }
+    Heatmap bulk;
+    bench.Run("heatmap_add/positions:4096", kPositions, [&] {
+        bulk.Add(xs.data(), ys.data(), kPositions, 0);
+        do_not_optimize(bulk.Layer(0));
+    });
+
+    WorkStealingPool pool;
+    HeatmapAccumulator accumulator(HeatmapGrid(), Heatmap::LayersFor<Rules5x5>(), 4);
+    bench.Run("heatmap_reduce/workers:4", 4, [&] {
+        do_not_optimize(accumulator.Reduce(pool).Layer(0));
+    });
+}
+
+/**
+ * @brief Benchmarks des colonnes : écriture en flux d'entiers et de flottants, relecture d'un bloc
+ * projeté, comparées à l'écriture des mêmes valeurs en texte.
+ */
+void bench_columns(BenchRunner& bench) {
+    constexpr std::size_t kRows = column_store::kBlockRows;
+    const std::string path = "bench_column.col";
+    std::vector<std::int64_t> ids(kRows);
+    std::vector<float> distances(kRows);
+    std::mt19937 mt(1);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    for (std::size_t i = 0; i < kRows; ++i) {
+        ids[i] = static_cast<std::int64_t>(i / 10);
+        distances[i] = 400.f + 200.f * unit(mt);
+    }
+
+    ColumnWriter writer;
+    writer.Open(path, "ids", column_store::ColumnType::Int64);
+    bench.Run("column_write_int/rows:4096", kRows, [&] {
+        for (std::int64_t value : ids) {
+            writer.AppendInt(value);
+        }
+    });
+    writer.Open(path, "samples", column_store::ColumnType::Float32);
+    bench.Run("column_write_float/rows:4096", kRows, [&] {
+        for (float value : distances) {
+            writer.AppendFloat(value);
+        }
+    });
+
+    std::FILE* text = std::fopen("/dev/null", "w");
+    bench.Run("text_write_float/rows:4096", kRows, [&] {
+        for (float value : distances) {
+            std::fprintf(text, "%g\n", value);
+        }
+    });
+    std::fclose(text);
+
+    writer.Open(path, "distances", column_store::ColumnType::Float32);
+    for (float value : distances) {
+        writer.AppendFloat(value);
+    }
+    writer.Close();
+    ColumnReader reader;
+    reader.Open(path);
+    std::vector<float> block;
+    std::size_t next = 0;
+    bench.Run("column_read_float/rows:4096", kRows, [&] {
+        reader.ReadBlock(next, block);
+        next = (next + 1) % reader.Blocks();
+        do_not_optimize(block.data());
+    });
+    reader.Close();
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief Benchmarks de l'instrumentation : incrément d'un compteur, chronométrage échantillonné
+ * et fusion des threads. Le coût sur match_tick se lit en comparant deux compilations,
+ * avec et sans BASKET_METRICS.
+ */
+void bench_metrics(BenchRunner& bench) {
+    bench.Run("metrics_count", 1, [] { CountMetric(Counter::Ticks); });
+    bench.Run("metrics_timer", 1, [] { LatencyTimer timer(Histogram::TickNs); });
+    bench.Run("metrics_scrape", 1, [] { do_not_optimize(ScrapeMetrics()); });
+}
+
+} // namespace
+
+/**
+ * @brief Point d'entrée des microbenchmarks.
+ */
+int main(int argc, char** argv) {
+    double min_time = 0.2;
+    std::string filter;
+    std::string json;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(9);
+        } else if (arg.rfind("--min-time=", 0) == 0) {
+            min_time = std::atof(arg.c_str() + 11);
+        } else if (arg.rfind("--json=", 0) == 0) {
+            json = arg.substr(7);
+        } else {
+            std::cerr << "Usage : " << argv[0] << " [--filter=texte] [--min-time=secondes] [--json=fichier|-]\n";
+            return 1;
+        }
+    }
+
+    BenchRunner bench(min_time, filter);
+    bench_neighbours(bench);
+    bench_tracking(bench);
+    bench_possession(bench);
+    bench_observers(bench);
+    bench_agents(bench);
+    bench_composite(bench);
+    bench_reporting(bench);
+    bench_motion(bench);
+    bench_match(bench);
+    bench_random(bench);
+    bench_heatmap(bench);
+    bench_columns(bench);
+    bench_metrics(bench);
+
+    if (json == "-") {
+        bench.WriteJson(std::cout);
+    } else if (!json.empty()) {
+        std::ofstream out(json);
+        bench.WriteJson(out);
+    }
+    return 0;
+}
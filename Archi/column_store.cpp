@@ -0,0 +1,728 @@
+#include "column_store.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using column_store::BlockEntry;
+using column_store::ColumnType;
+using column_store::Encoding;
+using column_store::Footer;
+using column_store::Trailer;
+
+constexpr std::size_t kPackedHeader = 8; ///< Base (uint32), largeur (uint8) et complément d'un bloc bit-packé.
+
+/**
+ * @brief Ajoute une valeur brute au tampon.
+ */
+template <class T>
+void put(std::vector<unsigned char>& out, const T& value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * @brief Ajoute un entier en varint LEB128 (7 bits par octet, poids faible d'abord).
+ */
+void put_varint(std::vector<unsigned char>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+/**
+ * @brief Lit un varint LEB128.
+ * @return False si le varint dépasse @p end ou 64 bits.
+ */
+bool get_varint(const unsigned char*& at, const unsigned char* end, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (at == end) {
+            return false;
+        }
+        const unsigned char byte = *at++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Zigzag : les petits écarts négatifs deviennent de petits entiers positifs.
+ */
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Inverse de zigzag().
+ */
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/**
+ * @brief Motif IEEE rendu croissant avec la valeur : les négatifs sont inversés, le bit de signe
+ * des positifs levé.
+ */
+std::uint32_t float_key(float value) {
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+}
+
+/**
+ * @brief Inverse de float_key().
+ */
+float key_float(std::uint32_t key) {
+    return std::bit_cast<float>(key & 0x80000000u ? key & 0x7FFFFFFFu : ~key);
+}
+
+/**
+ * @brief Octets de @p count valeurs de @p width bits.
+ */
+std::size_t packed_size(std::size_t count, unsigned width) {
+    return (count * width + 7) / 8;
+}
+
+/**
+ * @brief Range des valeurs sur @p width bits chacune, du poids faible au poids fort.
+ */
+void pack_bits(const std::uint32_t* values, std::size_t count, unsigned width, std::vector<unsigned char>& out) {
+    std::uint64_t accumulator = 0;
+    unsigned bits = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        accumulator |= static_cast<std::uint64_t>(values[i]) << bits;
+        bits += width;
+        while (bits >= 8) {
+            out.push_back(static_cast<unsigned char>(accumulator));
+            accumulator >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits) {
+        out.push_back(static_cast<unsigned char>(accumulator));
+    }
+}
+
+/**
+ * @brief Relit des valeurs de @p width bits ; @p store(i, valeur) reçoit chacune.
+ * @return False si les données dépassent @p end.
+ */
+template <class Store>
+bool unpack_bits(const unsigned char* at, const unsigned char* end, std::size_t count, unsigned width, Store store) {
+    if (width > 32 || packed_size(count, width) > static_cast<std::size_t>(end - at)) {
+        return false;
+    }
+    const std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+    std::uint64_t accumulator = 0;
+    unsigned bits = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        while (bits < width) {
+            accumulator |= static_cast<std::uint64_t>(*at++) << bits;
+            bits += 8;
+        }
+        store(i, static_cast<std::uint32_t>(accumulator & mask));
+        accumulator >>= width;
+        bits -= width;
+    }
+    return true;
+}
+
+/**
+ * @brief Bloc bit-packé : base, largeur, puis les écarts à la base.
+ */
+void encode_packed(const std::uint32_t* values, std::size_t count, std::vector<unsigned char>& out) {
+    const auto [low, high] = std::minmax_element(values, values + count);
+    const unsigned width = static_cast<unsigned>(std::bit_width(*high - *low));
+    put(out, *low);
+    const unsigned char meta[4] = {static_cast<unsigned char>(width), 0, 0, 0};
+    out.insert(out.end(), meta, meta + 4);
+    std::vector<std::uint32_t> offsets(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        offsets[i] = values[i] - *low;
+    }
+    pack_bits(offsets.data(), count, width, out);
+}
+
+/**
+ * @brief Relit un bloc écrit par encode_packed().
+ * @return False si le bloc est tronqué.
+ */
+template <class Store>
+bool decode_packed(const unsigned char* at, const unsigned char* end, std::size_t count, Store store) {
+    if (static_cast<std::size_t>(end - at) < kPackedHeader) {
+        return false;
+    }
+    std::uint32_t base;
+    std::memcpy(&base, at, sizeof(base));
+    const unsigned width = at[4];
+    return unpack_bits(at + kPackedHeader, end, count, width,
+                       [&](std::size_t i, std::uint32_t value) { store(i, base + value); });
+}
+
+/**
+ * @brief Encode un bloc de flottants : dictionnaire ou motifs bit-packés, le plus court des deux.
+ * @return L'encodage retenu.
+ */
+Encoding encode_floats(const std::vector<float>& values, std::vector<unsigned char>& out) {
+    const std::size_t count = values.size();
+    std::vector<std::uint32_t> keys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        keys[i] = float_key(values[i]);
+    }
+    // Valeurs distinctes par hachage ouvert, abandonné au-delà de kMaxDictionary : un bloc
+    // continu ne paie pas de tri
+    constexpr std::size_t kSlots = 2 * column_store::kMaxDictionary;
+    std::uint32_t slots[kSlots];
+    bool used[kSlots] = {};
+    std::vector<std::uint32_t> distinct;
+    distinct.reserve(column_store::kMaxDictionary + 1);
+    for (std::size_t i = 0; i < count && distinct.size() <= column_store::kMaxDictionary; ++i) {
+        std::size_t slot = (keys[i] * 0x9E3779B1u) >> 23;
+        while (used[slot] && slots[slot] != keys[i]) {
+            slot = (slot + 1) % kSlots;
+        }
+        if (!used[slot]) {
+            used[slot] = true;
+            slots[slot] = keys[i];
+            distinct.push_back(keys[i]);
+        }
+    }
+    if (distinct.size() > column_store::kMaxDictionary) {
+        encode_packed(keys.data(), count, out);
+        return Encoding::BitPacked;
+    }
+    std::sort(distinct.begin(), distinct.end());
+
+    const unsigned packed_width = static_cast<unsigned>(std::bit_width(distinct.back() - distinct.front()));
+    const std::size_t packed_bytes = kPackedHeader + packed_size(count, packed_width);
+    const unsigned index_width = static_cast<unsigned>(std::bit_width(distinct.size() - 1));
+    const std::size_t dictionary_bytes =
+        sizeof(std::uint32_t) * (1 + distinct.size()) + packed_size(count, index_width);
+
+    if (packed_bytes <= dictionary_bytes) {
+        encode_packed(keys.data(), count, out);
+        return Encoding::BitPacked;
+    }
+    put(out, static_cast<std::uint32_t>(distinct.size()));
+    for (std::uint32_t key : distinct) {
+        put(out, key);
+    }
+    for (std::uint32_t& key : keys) {
+        key = static_cast<std::uint32_t>(std::lower_bound(distinct.begin(), distinct.end(), key) - distinct.begin());
+    }
+    pack_bits(keys.data(), count, index_width, out);
+    return Encoding::Dictionary;
+}
+
+/**
+ * @brief Statistique flottante d'une colonne sans valeur.
+ */
+constexpr double kNoFloat = std::numeric_limits<double>::quiet_NaN();
+
+} // namespace
+
+/**
+ * @brief Destructeur : ferme la colonne si elle est ouverte.
+ */
+ColumnWriter::~ColumnWriter() {
+    Close();
+}
+
+/**
+ * @brief Crée (ou remplace) le fichier de la colonne.
+ * @param path Chemin du fichier.
+ * @param name Nom de la colonne.
+ * @param type Type des valeurs.
+ * @return True si le fichier a été créé.
+ */
+bool ColumnWriter::Open(const std::string& path, const std::string& name, ColumnType type) {
+    Close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    this->name = name;
+    this->type = type;
+    ok = true;
+    offset = 0;
+    stats = ColumnStats{};
+    stats.min_float = kNoFloat;
+    stats.max_float = kNoFloat;
+    ints.clear();
+    floats.clear();
+    blocks.clear();
+    dictionary.clear();
+    ids.clear();
+    return true;
+}
+
+/**
+ * @brief Ajoute un entier.
+ * @param value Valeur.
+ * @return False si la colonne n'accepte pas d'entier ou si l'écriture a échoué.
+ */
+bool ColumnWriter::AppendInt(std::int64_t value) {
+    if (!file || type != ColumnType::Int64) {
+        return false;
+    }
+    stats.min_int = stats.rows ? std::min(stats.min_int, value) : value;
+    stats.max_int = stats.rows ? std::max(stats.max_int, value) : value;
+    ++stats.rows;
+    ints.push_back(value);
+    return ints.size() == column_store::kBlockRows ? Flush() : ok;
+}
+
+/**
+ * @brief Ajoute un flottant.
+ * @param value Valeur.
+ * @return False si la colonne n'accepte pas de flottant ou si l'écriture a échoué.
+ */
+bool ColumnWriter::AppendFloat(float value) {
+    if (!file || type != ColumnType::Float32) {
+        return false;
+    }
+    if (!std::isnan(value)) {
+        // Les statistiques valent NaN tant qu'aucune valeur n'a été vue
+        if (!(value >= stats.min_float)) {
+            stats.min_float = value;
+        }
+        if (!(value <= stats.max_float)) {
+            stats.max_float = value;
+        }
+    }
+    ++stats.rows;
+    floats.push_back(value);
+    return floats.size() == column_store::kBlockRows ? Flush() : ok;
+}
+
+/**
+ * @brief Ajoute une chaîne, par son identifiant dans le dictionnaire.
+ * @param value Valeur.
+ * @return False si la colonne n'accepte pas de chaîne ou si l'écriture a échoué.
+ */
+bool ColumnWriter::AppendString(std::string_view value) {
+    if (!file || type != ColumnType::String) {
+        return false;
+    }
+    std::string key(value);
+    auto found = ids.find(key);
+    if (found == ids.end()) {
+        found = ids.emplace(key, static_cast<std::uint32_t>(dictionary.size())).first;
+        dictionary.push_back(std::move(key));
+    }
+    const std::int64_t id = found->second;
+    stats.min_int = stats.rows ? std::min(stats.min_int, id) : id;
+    stats.max_int = stats.rows ? std::max(stats.max_int, id) : id;
+    ++stats.rows;
+    ints.push_back(id);
+    return ints.size() == column_store::kBlockRows ? Flush() : ok;
+}
+
+/**
+ * @brief Encode et écrit le bloc en cours.
+ * @return False si l'écriture a échoué.
+ */
+bool ColumnWriter::Flush() {
+    const std::size_t rows = type == ColumnType::Float32 ? floats.size() : ints.size();
+    if (rows == 0) {
+        return ok;
+    }
+    encoded.clear();
+    Encoding encoding = Encoding::DeltaVarint;
+    if (type == ColumnType::Int64) {
+        std::uint64_t previous = 0;
+        for (std::int64_t value : ints) {
+            // Écart calculé modulo 2^64 : pas de dépassement signé
+            put_varint(encoded, zigzag(static_cast<std::int64_t>(static_cast<std::uint64_t>(value) - previous)));
+            previous = static_cast<std::uint64_t>(value);
+        }
+    } else if (type == ColumnType::Float32) {
+        encoding = encode_floats(floats, encoded);
+    } else {
+        std::vector<std::uint32_t> values(ints.begin(), ints.end());
+        encode_packed(values.data(), values.size(), encoded);
+        encoding = Encoding::BitPacked;
+    }
+
+    column_store::BlockEntry entry{};
+    entry.offset = offset;
+    entry.size = static_cast<std::uint32_t>(encoded.size());
+    entry.rows = static_cast<std::uint32_t>(rows);
+    entry.encoding = static_cast<std::uint32_t>(encoding);
+    ok = ok && std::fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+    offset += encoded.size();
+    blocks.push_back(entry);
+    ints.clear();
+    floats.clear();
+    return ok;
+}
+
+/**
+ * @brief Écrit le dernier bloc, le pied et le Trailer, puis ferme le fichier.
+ * @return True si toutes les écritures ont réussi.
+ */
+bool ColumnWriter::Close() {
+    if (!file) {
+        return false;
+    }
+    Flush();
+
+    // Le pied commence sur 8 octets : l'index des blocs se lit en place dans la projection
+    std::vector<unsigned char> tail((8 - offset % 8) % 8, 0);
+    const std::uint64_t footer_offset = offset + tail.size();
+
+    std::vector<unsigned char> strings;
+    for (const std::string& value : dictionary) {
+        put(strings, static_cast<std::uint32_t>(value.size()));
+        strings.insert(strings.end(), value.begin(), value.end());
+    }
+
+    column_store::Footer footer{};
+    std::memcpy(footer.magic, column_store::kMagic, sizeof(footer.magic));
+    footer.version = column_store::kVersion;
+    footer.type = static_cast<std::uint8_t>(type);
+    footer.name_size = static_cast<std::uint32_t>(name.size());
+    footer.rows = stats.rows;
+    footer.blocks = blocks.size();
+    footer.min_int = stats.min_int;
+    footer.max_int = stats.max_int;
+    footer.min_float = stats.min_float;
+    footer.max_float = stats.max_float;
+    footer.dictionary_count = static_cast<std::uint32_t>(dictionary.size());
+    footer.dictionary_size = static_cast<std::uint32_t>(strings.size());
+    const std::size_t footer_begin = tail.size();
+    put(tail, footer);
+    for (const column_store::BlockEntry& entry : blocks) {
+        put(tail, entry);
+    }
+    tail.insert(tail.end(), name.begin(), name.end());
+    tail.insert(tail.end(), strings.begin(), strings.end());
+
+    column_store::Trailer trailer{};
+    trailer.footer_offset = footer_offset;
+    trailer.footer_size = static_cast<std::uint32_t>(tail.size() - footer_begin);
+    std::memcpy(trailer.magic, column_store::kMagic, sizeof(trailer.magic));
+    put(tail, trailer);
+
+    ok = ok && std::fwrite(tail.data(), 1, tail.size(), file) == tail.size();
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+}
+
+/**
+ * @brief Destructeur : libère la projection.
+ */
+ColumnReader::~ColumnReader() {
+    Close();
+}
+
+/**
+ * @brief Ouvre et projette une colonne.
+ * @param path Chemin du fichier.
+ * @return True si le fichier est une colonne valide.
+ */
+bool ColumnReader::Open(const std::string& path) {
+    Close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Footer) + sizeof(Trailer)) {
+        ::close(fd);
+        return false;
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        size = 0;
+        return false;
+    }
+    map = static_cast<const unsigned char*>(mapped);
+
+    // Champs non fiables : bornes vérifiées par soustraction, aucune somme ne peut déborder
+    Trailer trailer;
+    std::memcpy(&trailer, map + size - sizeof(Trailer), sizeof(trailer));
+    bool valid = std::memcmp(trailer.magic, column_store::kMagic, sizeof(trailer.magic)) == 0 &&
+                 trailer.footer_offset % 8 == 0 && trailer.footer_size >= sizeof(Footer) &&
+                 trailer.footer_size <= size - sizeof(Trailer) &&
+                 trailer.footer_offset == size - sizeof(Trailer) - trailer.footer_size;
+    if (valid) {
+        std::memcpy(&footer, map + trailer.footer_offset, sizeof(footer));
+        valid = std::memcmp(footer.magic, column_store::kMagic, sizeof(footer.magic)) == 0 &&
+                footer.version == column_store::kVersion && footer.type >= 1 && footer.type <= 3 &&
+                footer.blocks <= trailer.footer_size / sizeof(BlockEntry) &&
+                sizeof(Footer) + footer.blocks * sizeof(BlockEntry) + footer.name_size + footer.dictionary_size ==
+                    trailer.footer_size;
+    }
+    if (!valid) {
+        Close();
+        return false;
+    }
+
+    const unsigned char* at = map + trailer.footer_offset + sizeof(Footer);
+    index = reinterpret_cast<const BlockEntry*>(at);
+    std::uint64_t rows = 0;
+    for (std::size_t i = 0; i < footer.blocks; ++i) {
+        valid = valid && index[i].size <= trailer.footer_offset &&
+                index[i].offset <= trailer.footer_offset - index[i].size && index[i].rows <= column_store::kBlockRows;
+        rows += index[i].rows;
+    }
+    at += footer.blocks * sizeof(BlockEntry);
+    name.assign(reinterpret_cast<const char*>(at), footer.name_size);
+    at += footer.name_size;
+
+    const unsigned char* end = at + footer.dictionary_size;
+    dictionary.clear();
+    for (std::uint32_t i = 0; valid && i < footer.dictionary_count; ++i) {
+        std::uint32_t length;
+        valid = static_cast<std::size_t>(end - at) >= sizeof(length);
+        if (valid) {
+            std::memcpy(&length, at, sizeof(length));
+            at += sizeof(length);
+            valid = static_cast<std::size_t>(end - at) >= length;
+        }
+        if (valid) {
+            dictionary.emplace_back(reinterpret_cast<const char*>(at), length);
+            at += length;
+        }
+    }
+    if (!valid || rows != footer.rows) {
+        Close();
+        return false;
+    }
+    ::madvise(const_cast<unsigned char*>(map), size, MADV_SEQUENTIAL);
+    return true;
+}
+
+/**
+ * @brief Libère la projection.
+ */
+void ColumnReader::Close() {
+    if (map) {
+        ::munmap(const_cast<unsigned char*>(map), size);
+    }
+    map = nullptr;
+    size = 0;
+    footer = Footer{};
+    name.clear();
+    index = nullptr;
+    dictionary.clear();
+}
+
+/**
+ * @brief Décode un bloc d'entiers ou d'identifiants de chaînes.
+ * @param block Indice du bloc.
+ * @param out Valeurs du bloc.
+ * @return False si le bloc n'existe pas, si le type ne convient pas ou si le bloc est invalide.
+ */
+bool ColumnReader::ReadBlock(std::size_t block, std::vector<std::int64_t>& out) const {
+    if (!map || block >= footer.blocks || Type() == ColumnType::Float32) {
+        return false;
+    }
+    const BlockEntry& entry = index[block];
+    const unsigned char* at = map + entry.offset;
+    const unsigned char* end = at + entry.size;
+    out.resize(entry.rows);
+
+    if (static_cast<Encoding>(entry.encoding) == Encoding::DeltaVarint) {
+        std::uint64_t value = 0;
+        for (std::int64_t& item : out) {
+            std::uint64_t delta;
+            if (!get_varint(at, end, delta)) {
+                return false;
+            }
+            value += static_cast<std::uint64_t>(unzigzag(delta));
+            item = static_cast<std::int64_t>(value);
+        }
+        return true;
+    }
+    if (static_cast<Encoding>(entry.encoding) == Encoding::BitPacked) {
+        return decode_packed(at, end, out.size(), [&](std::size_t i, std::uint32_t id) { out[i] = id; });
+    }
+    return false;
+}
+
+/**
+ * @brief Décode un bloc de flottants.
+ * @param block Indice du bloc.
+ * @param out Valeurs du bloc.
+ * @return False si le bloc n'existe pas, si le type ne convient pas ou si le bloc est invalide.
+ */
+bool ColumnReader::ReadBlock(std::size_t block, std::vector<float>& out) const {
+    if (!map || block >= footer.blocks || Type() != ColumnType::Float32) {
+        return false;
+    }
+    const BlockEntry& entry = index[block];
+    const unsigned char* at = map + entry.offset;
+    const unsigned char* end = at + entry.size;
+    out.resize(entry.rows);
+
+    if (static_cast<Encoding>(entry.encoding) == Encoding::BitPacked) {
+        return decode_packed(at, end, out.size(), [&](std::size_t i, std::uint32_t key) { out[i] = key_float(key); });
+    }
+    if (static_cast<Encoding>(entry.encoding) == Encoding::Dictionary) {
+        std::uint32_t count;
+        if (static_cast<std::size_t>(end - at) < sizeof(count)) {
+            return false;
+        }
+        std::memcpy(&count, at, sizeof(count));
+        at += sizeof(count);
+        if (count == 0 || count > column_store::kMaxDictionary ||
+            static_cast<std::size_t>(end - at) < count * sizeof(std::uint32_t)) {
+            return false;
+        }
+        float values[column_store::kMaxDictionary];
+        for (std::uint32_t i = 0; i < count; ++i) {
+            std::uint32_t key;
+            std::memcpy(&key, at + i * sizeof(key), sizeof(key));
+            values[i] = key_float(key);
+        }
+        at += count * sizeof(std::uint32_t);
+        bool inside = true;
+        const unsigned width = static_cast<unsigned>(std::bit_width(count - 1));
+        const bool read = unpack_bits(at, end, out.size(), width, [&](std::size_t i, std::uint32_t slot) {
+            inside = inside && slot < count;
+            out[i] = values[slot < count ? slot : 0];
+        });
+        return read && inside;
+    }
+    return false;
+}
+
+/**
+ * @brief Décode toute une colonne d'entiers ou d'identifiants.
+ * @param out Valeurs.
+ * @return False si un bloc est invalide ou si le type ne convient pas.
+ */
+bool ColumnReader::ReadAll(std::vector<std::int64_t>& out) const {
+    out.clear();
+    out.reserve(footer.rows);
+    std::vector<std::int64_t> block;
+    for (std::size_t i = 0; i < Blocks(); ++i) {
+        if (!ReadBlock(i, block)) {
+            return false;
+        }
+        out.insert(out.end(), block.begin(), block.end());
+    }
+    return map && Type() != ColumnType::Float32;
+}
+
+/**
+ * @brief Décode toute une colonne de flottants.
+ * @param out Valeurs.
+ * @return False si un bloc est invalide ou si le type ne convient pas.
+ */
+bool ColumnReader::ReadAll(std::vector<float>& out) const {
+    out.clear();
+    out.reserve(footer.rows);
+    std::vector<float> block;
+    for (std::size_t i = 0; i < Blocks(); ++i) {
+        if (!ReadBlock(i, block)) {
+            return false;
+        }
+        out.insert(out.end(), block.begin(), block.end());
+    }
+    return map && Type() == ColumnType::Float32;
+}
+
+/**
+ * @brief Chaîne d'un identifiant.
+ * @param id Identifiant.
+ * @return La chaîne, vide si l'identifiant n'existe pas.
+ */
+std::string_view ColumnReader::String(std::int64_t id) const {
+    return id >= 0 && static_cast<std::size_t>(id) < dictionary.size() ? dictionary[id] : std::string_view();
+}
+
+/**
+ * @brief Statistiques du pied.
+ * @return Les statistiques.
+ */
+ColumnStats ColumnReader::Stats() const {
+    ColumnStats stats;
+    stats.rows = footer.rows;
+    stats.min_int = footer.min_int;
+    stats.max_int = footer.max_int;
+    stats.min_float = footer.min_float;
+    stats.max_float = footer.max_float;
+    return stats;
+}
+
+/**
+ * @brief Écrit le schéma d'une table.
+ * @param path Chemin du fichier.
+ * @param columns Colonnes.
+ * @return False si le fichier n'a pas pu être écrit.
+ */
+bool WriteColumnSchema(const std::string& path, const std::vector<ColumnSchema>& columns) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const std::uint32_t count = static_cast<std::uint32_t>(columns.size());
+    bool ok = std::fwrite(column_store::kSchemaMagic, 1, 4, file) == 4 &&
+              std::fwrite(&column_store::kVersion, sizeof(column_store::kVersion), 1, file) == 1 &&
+              std::fwrite(&count, sizeof(count), 1, file) == 1;
+    for (const ColumnSchema& column : columns) {
+        const unsigned char type[4] = {static_cast<unsigned char>(column.type), 0, 0, 0};
+        const std::uint32_t name_size = static_cast<std::uint32_t>(column.name.size());
+        ok = ok && std::fwrite(type, 1, 4, file) == 4 && std::fwrite(&name_size, sizeof(name_size), 1, file) == 1 &&
+             std::fwrite(&column.rows, sizeof(column.rows), 1, file) == 1 &&
+             std::fwrite(column.name.data(), 1, name_size, file) == name_size;
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Relit un schéma écrit par WriteColumnSchema().
+ * @param path Chemin du fichier.
+ * @param columns Colonnes.
+ * @return False si le fichier est absent, tronqué ou d'un autre format.
+ */
+bool ReadColumnSchema(const std::string& path, std::vector<ColumnSchema>& columns) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    bool ok = std::fread(magic, 1, 4, file) == 4 && std::memcmp(magic, column_store::kSchemaMagic, 4) == 0 &&
+              std::fread(&version, sizeof(version), 1, file) == 1 && version == column_store::kVersion &&
+              std::fread(&count, sizeof(count), 1, file) == 1;
+    std::vector<ColumnSchema> loaded;
+    for (std::uint32_t i = 0; ok && i < count; ++i) {
+        unsigned char type[4];
+        std::uint32_t name_size = 0;
+        ColumnSchema column;
+        ok = std::fread(type, 1, 4, file) == 4 && type[0] >= 1 && type[0] <= 3 &&
+             std::fread(&name_size, sizeof(name_size), 1, file) == 1 && name_size <= 4096 &&
+             std::fread(&column.rows, sizeof(column.rows), 1, file) == 1;
+        if (ok) {
+            column.type = static_cast<ColumnType>(type[0]);
+            column.name.resize(name_size);
+            ok = std::fread(column.name.data(), 1, name_size, file) == name_size;
+            loaded.push_back(std::move(column));
+        }
+    }
+    std::fclose(file);
+    if (ok) {
+        columns = std::move(loaded);
+    }
+    return ok;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file column_store.hpp
+ * @brief Fichiers colonnaires compressés : écriture en flux par blocs, relecture par projection mémoire (mmap).
+ */
+
+#ifndef COLUMN_STORE_HPP
+#define COLUMN_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Format d'un fichier de colonne.
+ *
+ * Un fichier par colonne : les blocs encodés (au plus kBlockRows valeurs chacun, décodables
+ * séparément), puis le pied de fichier (Footer, index des blocs, nom de la colonne,
+ * dictionnaire des chaînes), aligné sur 8 octets, puis le Trailer de 16 octets qui le localise.
+ * - Entiers : écart à la valeur précédente du bloc (à 0 pour la première), en zigzag
+ *   puis en varint LEB128.
+ * - Flottants : par bloc, le plus court entre un dictionnaire (au plus kMaxDictionary
+ *   valeurs distinctes, indices bit-packés) et les motifs IEEE rendus ordonnés, moins le
+ *   plus petit, bit-packés. Les deux sont sans perte.
+ * - Chaînes : identifiants dans le dictionnaire du pied, moins le plus petit du bloc, bit-packés.
+ * Les valeurs sont en petit-boutiste ; les bits sont rangés du poids faible au poids fort.
+ */
+namespace column_store {
+
+constexpr char kMagic[4] = {'B', 'S', 'C', 'C'}; ///< Signature du pied et du Trailer.
+constexpr char kSchemaMagic[4] = {'B', 'S', 'C', 'S'}; ///< Signature d'un fichier de schéma.
+constexpr std::uint32_t kVersion = 1; ///< Version du format.
+constexpr std::size_t kBlockRows = 4096; ///< Valeurs par bloc.
+constexpr std::size_t kMaxDictionary = 256; ///< Valeurs distinctes au plus d'un dictionnaire de flottants.
+
+/**
+ * @brief Type des valeurs d'une colonne.
+ */
+enum class ColumnType : std::uint8_t {
+    Int64 = 1, ///< Entiers signés.
+    Float32 = 2, ///< Flottants simple précision.
+    String = 3 ///< Chaînes, par dictionnaire.
+};
+
+/**
+ * @brief Encodage d'un bloc.
+ */
+enum class Encoding : std::uint32_t {
+    DeltaVarint = 1, ///< Écarts en zigzag et varint.
+    Dictionary = 2, ///< Dictionnaire local puis indices bit-packés.
+    BitPacked = 3 ///< Base puis écarts à la base bit-packés.
+};
+
+/**
+ * @brief Pied de fichier, suivi de l'index des blocs, du nom et du dictionnaire.
+ */
+struct Footer {
+    char magic[4]; ///< Signature kMagic.
+    std::uint32_t version; ///< Version du format.
+    std::uint8_t type; ///< ColumnType.
+    std::uint8_t reserved[3]; ///< Réservé.
+    std::uint32_t name_size; ///< Octets du nom.
+    std::uint64_t rows; ///< Nombre de valeurs.
+    std::uint64_t blocks; ///< Nombre de blocs.
+    std::int64_t min_int; ///< Plus petit entier (ou identifiant de chaîne).
+    std::int64_t max_int; ///< Plus grand entier (ou identifiant de chaîne).
+    double min_float; ///< Plus petit flottant, NaN exclus (NaN sans valeur).
+    double max_float; ///< Plus grand flottant, NaN exclus (NaN sans valeur).
+    std::uint32_t dictionary_count; ///< Chaînes du dictionnaire.
+    std::uint32_t dictionary_size; ///< Octets du dictionnaire (longueur uint32 puis octets, par chaîne).
+};
+
+/**
+ * @brief Entrée de l'index : un bloc.
+ */
+struct BlockEntry {
+    std::uint64_t offset; ///< Position du bloc dans le fichier.
+    std::uint32_t size; ///< Octets du bloc.
+    std::uint32_t rows; ///< Valeurs du bloc.
+    std::uint32_t encoding; ///< Encoding du bloc.
+    std::uint32_t reserved; ///< Réservé.
+};
+
+/**
+ * @brief Fin du fichier : localise le pied.
+ */
+struct Trailer {
+    std::uint64_t footer_offset; ///< Position du pied.
+    std::uint32_t footer_size; ///< Octets du pied, nom, index et dictionnaire compris.
+    char magic[4]; ///< Signature kMagic.
+};
+
+static_assert(sizeof(Footer) == 72, "Pied de colonne de taille inattendue");
+static_assert(sizeof(BlockEntry) == 24, "Entrée d'index de taille inattendue");
+static_assert(sizeof(Trailer) == 16, "Fin de colonne de taille inattendue");
+
+} // namespace column_store
+
+/**
+ * @brief Statistiques d'une colonne, tenues à l'écriture et relues dans le pied.
+ */
+struct ColumnStats {
+    std::uint64_t rows = 0; ///< Nombre de valeurs.
+    std::int64_t min_int = 0; ///< Plus petit entier (colonnes Int64 et String).
+    std::int64_t max_int = 0; ///< Plus grand entier (colonnes Int64 et String).
+    double min_float = 0.0; ///< Plus petit flottant (colonnes Float32).
+    double max_float = 0.0; ///< Plus grand flottant (colonnes Float32).
+};
+
+/**
+ * @brief Description d'une colonne dans un schéma de table.
+ */
+struct ColumnSchema {
+    std::string name; ///< Nom de la colonne (et de son fichier, sans le suffixe ".col").
+    column_store::ColumnType type = column_store::ColumnType::Int64; ///< Type des valeurs.
+    std::uint64_t rows = 0; ///< Nombre de valeurs.
+};
+
+/**
+ * @brief Écrit une colonne en flux : seul le bloc en cours est gardé en mémoire.
+ *
+ * Chaque bloc plein est encodé puis écrit aussitôt ; Close() écrit le dernier bloc et le
+ * pied. Non thread-safe : un écrivain partagé doit être protégé par l'appelant.
+ */
+class ColumnWriter {
+public:
+    ColumnWriter() = default; ///< Constructeur par défaut.
+
+    /**
+     * @brief Destructeur : ferme la colonne si elle est ouverte.
+     */
+    ~ColumnWriter();
+
+    ColumnWriter(const ColumnWriter&) = delete; ///< Non copiable.
+    ColumnWriter& operator=(const ColumnWriter&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Crée (ou remplace) le fichier de la colonne.
+     * @param path Chemin du fichier.
+     * @param name Nom de la colonne, enregistré dans le pied.
+     * @param type Type des valeurs.
+     * @return True si le fichier a été créé.
+     */
+    bool Open(const std::string& path, const std::string& name, column_store::ColumnType type);
+
+    /**
+     * @brief Ajoute un entier à une colonne Int64.
+     * @param value Valeur.
+     * @return False si la colonne n'est pas ouverte, d'un autre type, ou si l'écriture a échoué.
+     */
+    bool AppendInt(std::int64_t value);
+
+    /**
+     * @brief Ajoute un flottant à une colonne Float32.
+     * @param value Valeur.
+     * @return False si la colonne n'est pas ouverte, d'un autre type, ou si l'écriture a échoué.
+     */
+    bool AppendFloat(float value);
+
+    /**
+     * @brief Ajoute une chaîne à une colonne String.
+     * @param value Valeur.
+     * @return False si la colonne n'est pas ouverte, d'un autre type, ou si l'écriture a échoué.
+     */
+    bool AppendString(std::string_view value);
+
+    /**
+     * @brief Écrit le dernier bloc, le pied et le Trailer, puis ferme le fichier.
+     * @return True si toutes les écritures ont réussi.
+     */
+    bool Close();
+
+    bool IsOpen() const { return file != nullptr; } ///< Indique si une colonne est ouverte.
+    const ColumnStats& Stats() const { return stats; } ///< Statistiques des valeurs ajoutées.
+    column_store::ColumnType Type() const { return type; } ///< Type des valeurs.
+    std::uint64_t Bytes() const { return offset; } ///< Octets de blocs écrits.
+
+private:
+    std::FILE* file = nullptr; ///< Fichier de la colonne.
+    std::string name; ///< Nom de la colonne.
+    column_store::ColumnType type = column_store::ColumnType::Int64; ///< Type des valeurs.
+    bool ok = true; ///< Faux après un échec d'écriture.
+    std::uint64_t offset = 0; ///< Position du prochain bloc.
+    ColumnStats stats; ///< Statistiques.
+    std::vector<std::int64_t> ints; ///< Bloc en cours (Int64, ou identifiants des chaînes).
+    std::vector<float> floats; ///< Bloc en cours (Float32).
+    std::vector<unsigned char> encoded; ///< Tampon d'encodage d'un bloc.
+    std::vector<column_store::BlockEntry> blocks; ///< Index des blocs écrits.
+    std::vector<std::string> dictionary; ///< Chaînes, par identifiant.
+    std::unordered_map<std::string, std::uint32_t> ids; ///< Identifiant de chaque chaîne.
+
+    /**
+     * @brief Encode et écrit le bloc en cours.
+     * @return False si l'écriture a échoué.
+     */
+    bool Flush();
+};
+
+/**
+ * @brief Relit une colonne projetée en mémoire, bloc par bloc.
+ *
+ * Le pied et l'index des blocs sont lus dans la projection, sans copie ; chaque bloc se
+ * décode indépendamment, ce qui permet de parcourir une colonne sans la charger entière.
+ */
+class ColumnReader {
+public:
+    ColumnReader() = default; ///< Constructeur par défaut.
+
+    /**
+     * @brief Destructeur : libère la projection.
+     */
+    ~ColumnReader();
+
+    ColumnReader(const ColumnReader&) = delete; ///< Non copiable.
+    ColumnReader& operator=(const ColumnReader&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Ouvre et projette une colonne.
+     * @param path Chemin du fichier.
+     * @return True si le fichier est une colonne valide.
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Libère la projection.
+     */
+    void Close();
+
+    /**
+     * @brief Décode un bloc d'une colonne Int64 (ou les identifiants d'une colonne String).
+     * @param block Indice du bloc.
+     * @param out Valeurs du bloc (remplacées).
+     * @return False si le bloc n'existe pas, si le type ne convient pas ou si le bloc est invalide.
+     */
+    bool ReadBlock(std::size_t block, std::vector<std::int64_t>& out) const;
+
+    /**
+     * @brief Décode un bloc d'une colonne Float32.
+     * @param block Indice du bloc.
+     * @param out Valeurs du bloc (remplacées).
+     * @return False si le bloc n'existe pas, si le type ne convient pas ou si le bloc est invalide.
+     */
+    bool ReadBlock(std::size_t block, std::vector<float>& out) const;
+
+    /**
+     * @brief Décode toute une colonne Int64 (ou les identifiants d'une colonne String).
+     * @param out Valeurs (remplacées).
+     * @return False si un bloc est invalide ou si le type ne convient pas.
+     */
+    bool ReadAll(std::vector<std::int64_t>& out) const;
+
+    /**
+     * @brief Décode toute une colonne Float32.
+     * @param out Valeurs (remplacées).
+     * @return False si un bloc est invalide ou si le type ne convient pas.
+     */
+    bool ReadAll(std::vector<float>& out) const;
+
+    /**
+     * @brief Chaîne d'un identifiant d'une colonne String.
+     * @param id Identifiant.
+     * @return La chaîne, pointant dans la projection ; vide si l'identifiant n'existe pas.
+     */
+    std::string_view String(std::int64_t id) const;
+
+    const std::string& Name() const { return name; } ///< Nom de la colonne.
+    column_store::ColumnType Type() const { return static_cast<column_store::ColumnType>(footer.type); } ///< Type.
+    std::uint64_t Rows() const { return footer.rows; } ///< Nombre de valeurs.
+    std::size_t Blocks() const { return static_cast<std::size_t>(footer.blocks); } ///< Nombre de blocs.
+    const column_store::BlockEntry& Block(std::size_t block) const { return index[block]; } ///< Entrée d'un bloc.
+    ColumnStats Stats() const; ///< Statistiques du pied.
+
+private:
+    const unsigned char* map = nullptr; ///< Projection du fichier.
+    std::size_t size = 0; ///< Taille du fichier.
+    column_store::Footer footer{}; ///< Pied lu.
+    std::string name; ///< Nom de la colonne.
+    const column_store::BlockEntry* index = nullptr; ///< Index des blocs (dans la projection).
+    std::vector<std::string_view> dictionary; ///< Chaînes, pointant dans la projection.
+};
+
+/**
+ * @brief Écrit le schéma d'une table : nom, type et nombre de valeurs de chaque colonne.
+ * @param path Chemin du fichier.
+ * @param columns Colonnes.
+ * @return False si le fichier n'a pas pu être écrit.
+ */
+bool WriteColumnSchema(const std::string& path, const std::vector<ColumnSchema>& columns);
+
+/**
+ * @brief Relit un schéma écrit par WriteColumnSchema().
+ * @param path Chemin du fichier.
+ * @param columns Colonnes (remplacées).
+ * @return False si le fichier est absent, tronqué ou d'un autre format.
+ */
+bool ReadColumnSchema(const std::string& path, std::vector<ColumnSchema>& columns);
+
+#endif // COLUMN_STORE_HPP
@@ -0,0 +1,211 @@
+#include "counter_rng.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr std::uint32_t kMul0 = 0xD2511F53u; ///< Multiplicateur des mots 0.
+constexpr std::uint32_t kMul1 = 0xCD9E8D57u; ///< Multiplicateur des mots 2.
+constexpr std::uint32_t kBump0 = 0x9E3779B9u; ///< Incrément de la clé, mot 0.
+constexpr std::uint32_t kBump1 = 0xBB67AE85u; ///< Incrément de la clé, mot 1.
+
+/**
+ * @brief Égalité de deux blocs, évaluable à la compilation.
+ */
+constexpr bool same(PhiloxBlock a, PhiloxBlock b) {
+    return a.c[0] == b.c[0] && a.c[1] == b.c[1] && a.c[2] == b.c[2] && a.c[3] == b.c[3];
+}
+
+// Vecteurs de référence de Random123 (kat_vectors, philox4x32 à 10 tours)
+static_assert(same(Philox4x32(PhiloxBlock{{0, 0, 0, 0}}, PhiloxKey{{0, 0}}),
+                   PhiloxBlock{{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}}),
+              "Philox4x32-10 : compteur et clé nuls");
+static_assert(same(Philox4x32(PhiloxBlock{{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}},
+                              PhiloxKey{{0xffffffffu, 0xffffffffu}}),
+                   PhiloxBlock{{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}}),
+              "Philox4x32-10 : compteur et clé pleins");
+static_assert(same(Philox4x32(PhiloxBlock{{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}},
+                              PhiloxKey{{0xa4093822u, 0x299f31d0u}}),
+                   PhiloxBlock{{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}}),
+              "Philox4x32-10 : décimales de pi");
+
+/**
+ * @brief Blocs restants, un par un.
+ */
+void fill_scalar(PhiloxKey key, PhiloxBlock counter, std::size_t blocks, std::uint32_t* out) {
+    for (std::size_t i = 0; i < blocks; ++i) {
+        const PhiloxBlock block = Philox4x32(counter, key);
+        out[4 * i + 0] = block.c[0];
+        out[4 * i + 1] = block.c[1];
+        out[4 * i + 2] = block.c[2];
+        out[4 * i + 3] = block.c[3];
+        ++counter.c[0];
+    }
+}
+
+#if defined(__AVX2__)
+
+/**
+ * @brief Produits 32 × 32 → 64 bits de huit mots : moitiés basses et hautes.
+ */
+inline void mulhilo(__m256i x, __m256i m, __m256i& lo, __m256i& hi) {
+    const __m256i even = _mm256_mul_epu32(x, m);
+    const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+    lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+/**
+ * @brief Huit blocs à la fois : un mot de compteur par registre, un bloc par voie.
+ * @return Le nombre de blocs traités (multiple de 8).
+ */
+std::size_t fill_simd(PhiloxKey key, PhiloxBlock counter, std::size_t blocks, std::uint32_t* out) {
+    const __m256i m0 = _mm256_set1_epi32(static_cast<int>(kMul0));
+    const __m256i m1 = _mm256_set1_epi32(static_cast<int>(kMul1));
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    std::size_t i = 0;
+    for (; i + 8 <= blocks; i += 8) {
+        __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(counter.c[0] + i)), lanes);
+        __m256i c1 = _mm256_set1_epi32(static_cast<int>(counter.c[1]));
+        __m256i c2 = _mm256_set1_epi32(static_cast<int>(counter.c[2]));
+        __m256i c3 = _mm256_set1_epi32(static_cast<int>(counter.c[3]));
+        std::uint32_t k0 = key.k[0];
+        std::uint32_t k1 = key.k[1];
+        for (int round = 0; round < 10; ++round) {
+            __m256i lo0, hi0, lo1, hi1;
+            mulhilo(c0, m0, lo0, hi0);
+            mulhilo(c2, m1, lo1, hi1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+            c1 = lo1;
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+            c3 = lo0;
+            k0 += kBump0;
+            k1 += kBump1;
+        }
+
+        // Transposition : quatre registres de mots → huit blocs consécutifs
+        const __m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+        const __m256i t1 = _mm256_unpackhi_epi32(c0, c1);
+        const __m256i t2 = _mm256_unpacklo_epi32(c2, c3);
+        const __m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+        const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+        const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+        const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+        const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+        __m256i* dst = reinterpret_cast<__m256i*>(out + 4 * i);
+        _mm256_storeu_si256(dst + 0, _mm256_permute2x128_si256(u0, u1, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(u2, u3, 0x20));
+        _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(u0, u1, 0x31));
+        _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(u2, u3, 0x31));
+    }
+    return i;
+}
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+/**
+ * @brief Produits 32 × 32 → 64 bits de quatre mots : moitiés basses et hautes.
+ */
+inline void mulhilo(__m128i x, __m128i m, __m128i& lo, __m128i& hi) {
+    const __m128i even = _mm_shuffle_epi32(_mm_mul_epu32(x, m), _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128i odd = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_epi64(x, 32), m), _MM_SHUFFLE(3, 1, 2, 0));
+    lo = _mm_unpacklo_epi32(even, odd);
+    hi = _mm_unpackhi_epi32(even, odd);
+}
+
+/**
+ * @brief Quatre blocs à la fois : un mot de compteur par registre, un bloc par voie.
+ * @return Le nombre de blocs traités (multiple de 4).
+ */
+std::size_t fill_simd(PhiloxKey key, PhiloxBlock counter, std::size_t blocks, std::uint32_t* out) {
+    const __m128i m0 = _mm_set1_epi32(static_cast<int>(kMul0));
+    const __m128i m1 = _mm_set1_epi32(static_cast<int>(kMul1));
+    const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+    std::size_t i = 0;
+    for (; i + 4 <= blocks; i += 4) {
+        __m128i c0 = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(counter.c[0] + i)), lanes);
+        __m128i c1 = _mm_set1_epi32(static_cast<int>(counter.c[1]));
+        __m128i c2 = _mm_set1_epi32(static_cast<int>(counter.c[2]));
+        __m128i c3 = _mm_set1_epi32(static_cast<int>(counter.c[3]));
+        std::uint32_t k0 = key.k[0];
+        std::uint32_t k1 = key.k[1];
+        for (int round = 0; round < 10; ++round) {
+            __m128i lo0, hi0, lo1, hi1;
+            mulhilo(c0, m0, lo0, hi0);
+            mulhilo(c2, m1, lo1, hi1);
+            c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(static_cast<int>(k0)));
+            c1 = lo1;
+            c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(static_cast<int>(k1)));
+            c3 = lo0;
+            k0 += kBump0;
+            k1 += kBump1;
+        }
+
+        // Transposition 4 × 4 : quatre registres de mots → quatre blocs consécutifs
+        const __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+        const __m128i t1 = _mm_unpackhi_epi32(c0, c1);
+        const __m128i t2 = _mm_unpacklo_epi32(c2, c3);
+        const __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+        __m128i* dst = reinterpret_cast<__m128i*>(out + 4 * i);
+        _mm_storeu_si128(dst + 0, _mm_unpacklo_epi64(t0, t2));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi64(t0, t2));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi64(t1, t3));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi64(t1, t3));
+    }
+    return i;
+}
+
+#else
+
+/**
+ * @brief Sans SIMD, tout passe par le chemin scalaire.
+ * @return 0.
+ */
+std::size_t fill_simd(PhiloxKey, PhiloxBlock, std::size_t, std::uint32_t*) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+/**
+ * @brief Tire des blocs consécutifs, par paquets vectorisés puis un par un.
+ * @param key Clé.
+ * @param first Compteur du premier bloc.
+ * @param blocks Nombre de blocs.
+ * @param out Destination de 4 × blocks mots.
+ */
+void PhiloxFill(PhiloxKey key, PhiloxBlock first, std::size_t blocks, std::uint32_t* out) {
+    const std::size_t done = fill_simd(key, first, blocks, out);
+    PhiloxBlock rest = first;
+    rest.c[0] += static_cast<std::uint32_t>(done);
+    fill_scalar(key, rest, blocks - done, out + 4 * done);
+}
+
+/**
+ * @brief Tire des flottants uniformes, par paquets de 64 blocs.
+ * @param key Clé.
+ * @param first Compteur du premier bloc.
+ * @param count Nombre de flottants.
+ * @param out Destination.
+ */
+void PhiloxUniform(PhiloxKey key, PhiloxBlock first, std::size_t count, float* out) {
+    constexpr std::size_t kChunk = 64;
+    std::uint32_t bits[4 * kChunk];
+    PhiloxBlock counter = first;
+    for (std::size_t done = 0; done < count;) {
+        const std::size_t words = count - done < 4 * kChunk ? count - done : 4 * kChunk;
+        const std::size_t blocks = (words + 3) / 4;
+        PhiloxFill(key, counter, blocks, bits);
+        for (std::size_t i = 0; i < words; ++i) {
+            out[done + i] = ToUnitFloat(bits[i]);
+        }
+        counter.c[0] += static_cast<std::uint32_t>(blocks);
+        done += words;
+    }
+}
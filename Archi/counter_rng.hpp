@@ -0,0 +1,162 @@
+/**
+ * @file counter_rng.hpp
+ * @brief Générateur à compteur Philox4x32-10 : tirages reproductibles, indépendants de l'ordre d'exécution.
+ */
+
+#ifndef COUNTER_RNG_HPP
+#define COUNTER_RNG_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Clé Philox : identifie un flux (graine et match).
+ */
+struct PhiloxKey {
+    std::uint32_t k[2]; ///< Mots de la clé.
+};
+
+/**
+ * @brief Compteur Philox : position dans le flux ; donne aussi le bloc de quatre mots tirés.
+ */
+struct PhiloxBlock {
+    std::uint32_t c[4]; ///< Mots du compteur ou du bloc tiré.
+};
+
+/**
+ * @brief Étiquettes du dernier mot de compteur, séparant les usages d'une même clé.
+ */
+enum class RandomStream : std::uint32_t {
+    Match = 1, ///< Décisions d'un tick de match (déplacements, tirs).
+    Search = 2, ///< Choix d'actions de la recherche de stratégie.
+    Fork = 3 ///< Graines des variantes d'un match.
+};
+
+/**
+ * @brief Philox4x32-10 (Salmon et al., 2011) : bloc pseudo-aléatoire d'un compteur sous une clé.
+ *
+ * Fonction pure : le même couple (compteur, clé) donne toujours le même bloc, sur tout
+ * thread et dans tout ordre.
+ *
+ * @param counter Compteur.
+ * @param key Clé.
+ * @return Quatre mots pseudo-aléatoires.
+ */
+constexpr PhiloxBlock Philox4x32(PhiloxBlock counter, PhiloxKey key) {
+    std::uint32_t c0 = counter.c[0];
+    std::uint32_t c1 = counter.c[1];
+    std::uint32_t c2 = counter.c[2];
+    std::uint32_t c3 = counter.c[3];
+    std::uint32_t k0 = key.k[0];
+    std::uint32_t k1 = key.k[1];
+    for (int round = 0; round < 10; ++round) {
+        const std::uint64_t p0 = std::uint64_t{0xD2511F53u} * c0;
+        const std::uint64_t p1 = std::uint64_t{0xCD9E8D57u} * c2;
+        const std::uint32_t hi0 = static_cast<std::uint32_t>(p0 >> 32);
+        const std::uint32_t hi1 = static_cast<std::uint32_t>(p1 >> 32);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = static_cast<std::uint32_t>(p1);
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = static_cast<std::uint32_t>(p0);
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    return PhiloxBlock{{c0, c1, c2, c3}};
+}
+
+/**
+ * @brief Clé d'un match : graine et identifiant du match.
+ * @param seed Graine de la simulation.
+ * @param match_id Identifiant du match (par exemple son rang dans un lot).
+ * @return La clé.
+ */
+constexpr PhiloxKey KeyFor(std::uint32_t seed, std::uint64_t match_id) {
+    // Le poids fort de l'identifiant est mêlé à la graine : une clé par (graine, match)
+    return PhiloxKey{{static_cast<std::uint32_t>(match_id),
+                      seed ^ static_cast<std::uint32_t>(match_id >> 32) * 0x9E3779B9u}};
+}
+
+/**
+ * @brief Convertit un mot tiré en flottant uniforme.
+ * @param bits Mot tiré.
+ * @return Une valeur dans [0, 1), au pas de 2^-24.
+ */
+constexpr float ToUnitFloat(std::uint32_t bits) {
+    return static_cast<float>(bits >> 8) * (1.f / 16777216.f);
+}
+
+/**
+ * @brief Tire des blocs consécutifs : le bloc i est Philox4x32 du compteur `first` dont le mot 0 vaut first.c[0] + i.
+ *
+ * Chemin vectorisé (huit blocs à la fois en AVX2, quatre en SSE2) ; le résultat est
+ * identique au chemin scalaire, bit pour bit.
+ *
+ * @param key Clé.
+ * @param first Compteur du premier bloc (le mot 0 ne doit pas déborder sur @p blocks blocs).
+ * @param blocks Nombre de blocs.
+ * @param out Destination de 4 × blocks mots, bloc par bloc.
+ */
+void PhiloxFill(PhiloxKey key, PhiloxBlock first, std::size_t blocks, std::uint32_t* out);
+
+/**
+ * @brief Tire des flottants uniformes : out[i] = ToUnitFloat(mot i % 4 du bloc i / 4).
+ * @param key Clé.
+ * @param first Compteur du premier bloc.
+ * @param count Nombre de flottants.
+ * @param out Destination.
+ */
+void PhiloxUniform(PhiloxKey key, PhiloxBlock first, std::size_t count, float* out);
+
+/**
+ * @brief Suite de mots tirés sous une clé, les trois mots hauts du compteur étant fixés.
+ *
+ * Chaque bloc fournit quatre mots ; le mot 0 du compteur compte les blocs consommés.
+ */
+class CounterStream {
+public:
+    /**
+     * @brief Constructeur.
+     * @param key Clé.
+     * @param c1 Mot 1 du compteur.
+     * @param c2 Mot 2 du compteur.
+     * @param stream Usage, placé dans le mot 3 du compteur.
+     */
+    CounterStream(PhiloxKey key, std::uint32_t c1, std::uint32_t c2, RandomStream stream)
+        : key(key), counter{{0, c1, c2, static_cast<std::uint32_t>(stream)}} {}
+
+    /**
+     * @brief Mot suivant.
+     * @return 32 bits pseudo-aléatoires.
+     */
+    std::uint32_t Next() {
+        if (used == 4) {
+            block = Philox4x32(counter, key);
+            ++counter.c[0];
+            used = 0;
+        }
+        return block.c[used++];
+    }
+
+    /**
+     * @brief Flottant uniforme suivant.
+     * @return Une valeur dans [0, 1).
+     */
+    float NextFloat() { return ToUnitFloat(Next()); }
+
+    /**
+     * @brief Entier uniforme (à un biais négligeable près) dans [0, bound).
+     * @param bound Borne, non nulle.
+     * @return L'entier tiré.
+     */
+    std::uint32_t Below(std::uint32_t bound) {
+        return static_cast<std::uint32_t>((static_cast<std::uint64_t>(Next()) * bound) >> 32);
+    }
+
+private:
+    PhiloxKey key; ///< Clé.
+    PhiloxBlock counter; ///< Compteur du prochain bloc.
+    PhiloxBlock block{}; ///< Bloc en cours.
+    int used = 4; ///< Mots consommés du bloc en cours.
+};
+
+#endif // COUNTER_RNG_HPP
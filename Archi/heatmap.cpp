@@ -0,0 +1,304 @@
+#include "heatmap.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kBinChunk = 256; ///< Positions binées par passage du noyau.
+
+/**
+ * @brief Case de chaque position : col + cols × row, bornées à la grille.
+ * @param xs Abscisses.
+ * @param ys Ordonnées.
+ * @param count Nombre de positions.
+ * @param scale_x Colonnes par unité.
+ * @param scale_y Lignes par unité.
+ * @param cols Colonnes.
+ * @param rows Lignes.
+ * @param cells Destination des indices de case.
+ */
+void bin_cells(const float* xs, const float* ys, std::size_t count, float scale_x, float scale_y, int cols, int rows,
+               std::int32_t* cells) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 sx = _mm256_set1_ps(scale_x);
+    const __m256 sy = _mm256_set1_ps(scale_y);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 max_col = _mm256_set1_ps(static_cast<float>(cols - 1));
+    const __m256 max_row = _mm256_set1_ps(static_cast<float>(rows - 1));
+    const __m256i stride = _mm256_set1_epi32(cols);
+    for (; i + 8 <= count; i += 8) {
+        // Bornage avant conversion ; max_ps renvoie son second opérande pour NaN, qui tombe en case 0
+        const __m256 fx = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(xs + i), sx), zero), max_col);
+        const __m256 fy = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(ys + i), sy), zero), max_row);
+        const __m256i col = _mm256_cvttps_epi32(fx);
+        const __m256i row = _mm256_cvttps_epi32(fy);
+        const __m256i cell = _mm256_add_epi32(col, _mm256_mullo_epi32(row, stride));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(cells + i), cell);
+    }
+#endif
+    for (; i < count; ++i) {
+        const float fx = xs[i] * scale_x;
+        const float fy = ys[i] * scale_y;
+        // Comparaisons écrites pour que NaN donne 0, comme le chemin vectorisé
+        const int col = static_cast<int>(fx > 0.f ? std::min(fx, static_cast<float>(cols - 1)) : 0.f);
+        const int row = static_cast<int>(fy > 0.f ? std::min(fy, static_cast<float>(rows - 1)) : 0.f);
+        cells[i] = col + cols * row;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Constructeur.
+ * @param grid Résolution et étendue.
+ * @param layers Nombre de couches.
+ */
+Heatmap::Heatmap(const HeatmapGrid& grid, int layers)
+    : grid(grid), layers(std::max(layers, 1)) {
+    this->grid.cols = std::max(grid.cols, 1);
+    this->grid.rows = std::max(grid.rows, 1);
+    scale_x = grid.width > 0.f ? this->grid.cols / grid.width : 0.f;
+    scale_y = grid.height > 0.f ? this->grid.rows / grid.height : 0.f;
+    counts.assign(Cells() * this->layers, 0);
+}
+
+/**
+ * @brief Compte des positions dans une couche, par paquets de kBinChunk.
+ * @param xs Abscisses.
+ * @param ys Ordonnées.
+ * @param count Nombre de positions.
+ * @param layer Couche.
+ * @return False si la couche n'existe pas.
+ */
+bool Heatmap::Add(const float* xs, const float* ys, std::size_t count, int layer) {
+    if (layer < 0 || layer >= layers) {
+        return false;
+    }
+    std::uint32_t* base = counts.data() + static_cast<std::size_t>(layer) * Cells();
+    std::int32_t cells[kBinChunk];
+    for (std::size_t done = 0; done < count; done += kBinChunk) {
+        const std::size_t n = std::min(kBinChunk, count - done);
+        bin_cells(xs + done, ys + done, n, scale_x, scale_y, grid.cols, grid.rows, cells);
+        for (std::size_t i = 0; i < n; ++i) {
+            ++base[cells[i]];
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compte la position de chaque joueur dans sa couche et dans celle de son équipe.
+ * @param players Joueurs.
+ */
+template <class Rules>
+void Heatmap::AddPlayers(const std::vector<BasicPlayer<Rules>>& players) {
+    float xs[kBinChunk];
+    float ys[kBinChunk];
+    std::int32_t cells[kBinChunk];
+    const std::size_t cells_per_layer = Cells();
+    for (std::size_t done = 0; done < players.size(); done += kBinChunk) {
+        const std::size_t n = std::min(kBinChunk, players.size() - done);
+        for (std::size_t i = 0; i < n; ++i) {
+            xs[i] = players[done + i].position.x;
+            ys[i] = players[done + i].position.y;
+        }
+        bin_cells(xs, ys, n, scale_x, scale_y, grid.cols, grid.rows, cells);
+        for (std::size_t i = 0; i < n; ++i) {
+            const int number = players[done + i].number;
+            if (number >= 0 && number < layers) {
+                ++counts[number * cells_per_layer + cells[i]];
+            }
+            const int team = Rules::players + Rules::team_of(number);
+            if (number >= 0 && team < layers) {
+                ++counts[team * cells_per_layer + cells[i]];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ajoute les compteurs d'une autre carte.
+ * @param other Carte compatible.
+ * @return False si les grilles ou le nombre de couches diffèrent.
+ */
+bool Heatmap::Merge(const Heatmap& other) {
+    if (other.grid.cols != grid.cols || other.grid.rows != grid.rows || other.layers != layers) {
+        return false;
+    }
+    std::uint32_t* dst = counts.data();
+    const std::uint32_t* src = other.counts.data();
+    const std::size_t n = counts.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        dst[i] += src[i];
+    }
+    return true;
+}
+
+/**
+ * @brief Remet tous les compteurs à zéro.
+ */
+void Heatmap::Clear() {
+    std::fill(counts.begin(), counts.end(), 0u);
+}
+
+/**
+ * @brief Total d'une couche.
+ * @param layer Couche.
+ * @return La somme de ses compteurs, 0 si la couche n'existe pas.
+ */
+std::uint64_t Heatmap::Total(int layer) const {
+    if (layer < 0 || layer >= layers) {
+        return 0;
+    }
+    const std::uint32_t* values = Layer(layer);
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < Cells(); ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+/**
+ * @brief Écrit une couche en image PGM binaire 8 bits.
+ * @param path Chemin du fichier.
+ * @param layer Couche.
+ * @return False si la couche n'existe pas ou si l'écriture a échoué.
+ */
+bool Heatmap::WritePgm(const std::string& path, int layer) const {
+    if (layer < 0 || layer >= layers) {
+        return false;
+    }
+    const std::uint32_t* values = Layer(layer);
+    const std::uint32_t peak = *std::max_element(values, values + Cells());
+
+    std::vector<std::uint8_t> pixels(Cells());
+    for (int row = 0; row < grid.rows; ++row) {
+        const std::uint32_t* line = values + static_cast<std::size_t>(grid.rows - 1 - row) * grid.cols;
+        for (int col = 0; col < grid.cols; ++col) {
+            pixels[static_cast<std::size_t>(row) * grid.cols + col] =
+                peak ? static_cast<std::uint8_t>((static_cast<std::uint64_t>(line[col]) * 255 + peak / 2) / peak) : 0;
+        }
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fprintf(file, "P5\n%d %d\n255\n", grid.cols, grid.rows) > 0;
+    ok = ok && std::fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Écrit la carte au format binaire.
+ * @param path Chemin du fichier.
+ * @return False si l'écriture a échoué.
+ */
+bool Heatmap::WriteBinary(const std::string& path) const {
+    heatmap::Header header{};
+    std::memcpy(header.magic, heatmap::kMagic, sizeof(header.magic));
+    header.version = heatmap::kVersion;
+    header.cols = static_cast<std::uint32_t>(grid.cols);
+    header.rows = static_cast<std::uint32_t>(grid.rows);
+    header.layers = static_cast<std::uint32_t>(layers);
+    header.width = grid.width;
+    header.height = grid.height;
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(counts.data(), sizeof(std::uint32_t), counts.size(), file) == counts.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Relit une carte écrite par WriteBinary().
+ * @param path Chemin du fichier.
+ * @param map Carte remplacée.
+ * @return False si le fichier est absent, tronqué ou d'un autre format.
+ */
+bool Heatmap::ReadBinary(const std::string& path, Heatmap& map) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    heatmap::Header header;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, heatmap::kMagic, sizeof(header.magic)) == 0 &&
+              header.version == heatmap::kVersion && header.cols > 0 && header.rows > 0 && header.layers > 0 &&
+              header.cols <= 1u << 15 && header.rows <= 1u << 15 && header.layers <= 1u << 16;
+    if (ok) {
+        Heatmap loaded(HeatmapGrid{static_cast<int>(header.cols), static_cast<int>(header.rows), header.width,
+                                   header.height},
+                       static_cast<int>(header.layers));
+        ok = std::fread(loaded.counts.data(), sizeof(std::uint32_t), loaded.counts.size(), file) ==
+             loaded.counts.size();
+        if (ok) {
+            map = std::move(loaded);
+        }
+    }
+    std::fclose(file);
+    return ok;
+}
+
+/**
+ * @brief Constructeur.
+ * @param grid Grille des cartes.
+ * @param layers Couches de chaque carte.
+ * @param workers Nombre de cartes privées.
+ */
+HeatmapAccumulator::HeatmapAccumulator(const HeatmapGrid& grid, int layers, unsigned workers)
+    : maps(std::max(workers, 1u), Heatmap(grid, layers)) {}
+
+/**
+ * @brief Ajuste le nombre de cartes privées sans perdre de compteur.
+ * @param workers Nombre de workers.
+ */
+void HeatmapAccumulator::Resize(unsigned workers) {
+    workers = std::max(workers, 1u);
+    for (std::size_t i = workers; i < maps.size(); ++i) {
+        maps[0].Merge(maps[i]);
+    }
+    const Heatmap empty(maps[0].Grid(), maps[0].Layers());
+    maps.resize(workers, empty);
+}
+
+/**
+ * @brief Réduction en arbre : à l'étape de pas s, la carte i + s est ajoutée à la carte i (i multiple de 2s).
+ * @param pool Pool exécutant les étapes.
+ * @return La carte totale.
+ */
+const Heatmap& HeatmapAccumulator::Reduce(WorkStealingPool& pool) {
+    for (std::size_t stride = 1; stride < maps.size(); stride *= 2) {
+        const std::size_t pairs = (maps.size() + 2 * stride - 1) / (2 * stride);
+        pool.ParallelFor(pairs, [&](std::size_t pair, unsigned) {
+            const std::size_t i = pair * 2 * stride;
+            if (i + stride < maps.size()) {
+                maps[i].Merge(maps[i + stride]);
+                maps[i + stride].Clear();
+            }
+        });
+    }
+    return maps[0];
+}
+
+/**
+ * @brief Remet toutes les cartes à zéro.
+ */
+void HeatmapAccumulator::Clear() {
+    for (Heatmap& map : maps) {
+        map.Clear();
+    }
+}
+
+template void Heatmap::AddPlayers<Rules5x5>(const std::vector<BasicPlayer<Rules5x5>>&);
+template void Heatmap::AddPlayers<Rules3x3>(const std::vector<BasicPlayer<Rules3x3>>&);
+template void Heatmap::AddPlayers<RulesDrill2x2>(const std::vector<BasicPlayer<RulesDrill2x2>>&);
@@ -0,0 +1,239 @@
+/**
+ * @file heatmap.hpp
+ * @brief Cartes d'occupation du terrain par joueur et par équipe, accumulées par thread puis réduites en arbre.
+ */
+
+#ifndef HEATMAP_HPP
+#define HEATMAP_HPP
+
+#include "basket.hpp"
+#include "work_stealing_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Format binaire d'une carte.
+ *
+ * En-tête de 32 octets, puis les compteurs en uint32 petit-boutiste : couche par couche,
+ * ligne par ligne (y croissant), colonne par colonne (x croissant).
+ */
+namespace heatmap {
+
+constexpr char kMagic[4] = {'B', 'S', 'H', 'M'}; ///< Signature du fichier.
+constexpr std::uint32_t kVersion = 1; ///< Version du format.
+
+/**
+ * @brief En-tête du fichier.
+ */
+struct Header {
+    char magic[4]; ///< Signature kMagic.
+    std::uint32_t version; ///< Version du format.
+    std::uint32_t cols; ///< Colonnes de la grille.
+    std::uint32_t rows; ///< Lignes de la grille.
+    std::uint32_t layers; ///< Nombre de couches.
+    float width; ///< Largeur couverte.
+    float height; ///< Hauteur couverte.
+    std::uint32_t reserved; ///< Réservé.
+};
+
+static_assert(sizeof(Header) == 32, "En-tête de carte de taille inattendue");
+
+} // namespace heatmap
+
+/**
+ * @brief Résolution et étendue d'une grille d'occupation.
+ */
+struct HeatmapGrid {
+    int cols = 100; ///< Colonnes (axe X).
+    int rows = 50; ///< Lignes (axe Y).
+    float width = basket_x; ///< Largeur couverte, depuis x = 0.
+    float height = basket_y; ///< Hauteur couverte, depuis y = 0.
+
+    /**
+     * @brief Grille couvrant le terrain d'une variante de jeu.
+     * @param cols Colonnes.
+     * @param rows Lignes.
+     * @return La grille.
+     */
+    template <class Rules>
+    static HeatmapGrid ForCourt(int cols, int rows) {
+        return HeatmapGrid{cols, rows, Rules::court_x, Rules::court_y};
+    }
+};
+
+/**
+ * @brief Carte d'occupation : un histogramme 2D par couche, en compteurs contigus.
+ *
+ * Les couches sont libres ; AddPlayers() range le joueur n dans la couche n et son
+ * équipe dans la couche players + équipe. Le calcul des cases est vectorisé (huit
+ * positions par itération en AVX2) ; l'incrément reste scalaire. Les positions hors de
+ * la grille sont ramenées sur son bord.
+ */
+class Heatmap {
+public:
+    /**
+     * @brief Constructeur.
+     * @param grid Résolution et étendue (au moins une case).
+     * @param layers Nombre de couches (au moins 1).
+     */
+    explicit Heatmap(const HeatmapGrid& grid = HeatmapGrid(), int layers = 1);
+
+    /**
+     * @brief Nombre de couches nécessaire à AddPlayers() pour une variante.
+     * @return Une couche par joueur et une par équipe.
+     */
+    template <class Rules>
+    static constexpr int LayersFor() {
+        return Rules::players + Rules::teams;
+    }
+
+    /**
+     * @brief Compte des positions dans une couche.
+     * @param xs Abscisses.
+     * @param ys Ordonnées.
+     * @param count Nombre de positions.
+     * @param layer Couche.
+     * @return False si la couche n'existe pas.
+     */
+    bool Add(const float* xs, const float* ys, std::size_t count, int layer);
+
+    /**
+     * @brief Compte la position de chaque joueur dans sa couche et dans celle de son équipe.
+     *
+     * Les joueurs dont une couche n'existe pas sont ignorés.
+     *
+     * @param players Joueurs, par exemple BasicMatch::players().
+     */
+    template <class Rules>
+    void AddPlayers(const std::vector<BasicPlayer<Rules>>& players);
+
+    /**
+     * @brief Ajoute les compteurs d'une autre carte.
+     * @param other Carte de même grille et de même nombre de couches.
+     * @return False si les cartes ne sont pas compatibles.
+     */
+    bool Merge(const Heatmap& other);
+
+    /**
+     * @brief Remet tous les compteurs à zéro.
+     */
+    void Clear();
+
+    /**
+     * @brief Compteur d'une case.
+     * @param layer Couche.
+     * @param col Colonne.
+     * @param row Ligne.
+     * @return Le nombre de positions comptées dans la case.
+     */
+    std::uint32_t Count(int layer, int col, int row) const {
+        return counts[static_cast<std::size_t>(layer) * Cells() + static_cast<std::size_t>(row) * grid.cols + col];
+    }
+
+    /**
+     * @brief Compteurs d'une couche, ligne par ligne.
+     * @param layer Couche.
+     * @return Cells() compteurs.
+     */
+    const std::uint32_t* Layer(int layer) const { return counts.data() + static_cast<std::size_t>(layer) * Cells(); }
+
+    /**
+     * @brief Total d'une couche.
+     * @param layer Couche.
+     * @return La somme de ses compteurs.
+     */
+    std::uint64_t Total(int layer) const;
+
+    /**
+     * @brief Écrit une couche en image PGM binaire (P5) 8 bits, la case la plus occupée en blanc.
+     *
+     * Une ligne d'image par ligne de grille, y décroissant de haut en bas comme sur un plan.
+     *
+     * @param path Chemin du fichier.
+     * @param layer Couche.
+     * @return False si la couche n'existe pas ou si le fichier n'a pas pu être écrit.
+     */
+    bool WritePgm(const std::string& path, int layer) const;
+
+    /**
+     * @brief Écrit la carte au format binaire (heatmap::Header puis les compteurs).
+     * @param path Chemin du fichier.
+     * @return False si le fichier n'a pas pu être écrit.
+     */
+    bool WriteBinary(const std::string& path) const;
+
+    /**
+     * @brief Relit une carte écrite par WriteBinary().
+     * @param path Chemin du fichier.
+     * @param map Carte remplacée par celle du fichier.
+     * @return False si le fichier est absent, tronqué ou d'un autre format.
+     */
+    static bool ReadBinary(const std::string& path, Heatmap& map);
+
+    const HeatmapGrid& Grid() const { return grid; } ///< Grille.
+    int Layers() const { return layers; } ///< Nombre de couches.
+    std::size_t Cells() const { return static_cast<std::size_t>(grid.cols) * grid.rows; } ///< Cases par couche.
+
+private:
+    HeatmapGrid grid; ///< Grille.
+    int layers; ///< Nombre de couches.
+    float scale_x; ///< Colonnes par unité de largeur.
+    float scale_y; ///< Lignes par unité de hauteur.
+    std::vector<std::uint32_t> counts; ///< Compteurs, couche par couche.
+};
+
+/**
+ * @brief Cartes privées de chaque worker, réduites en arbre.
+ *
+ * Chaque worker n'écrit que dans sa carte (Local()) : aucun partage pendant
+ * l'accumulation. Reduce() additionne les cartes deux à deux en log2(workers) étapes
+ * parallèles ; le total se retrouve dans la carte du worker 0.
+ */
+class HeatmapAccumulator {
+public:
+    /**
+     * @brief Constructeur.
+     * @param grid Grille des cartes.
+     * @param layers Couches de chaque carte.
+     * @param workers Nombre de cartes privées.
+     */
+    HeatmapAccumulator(const HeatmapGrid& grid, int layers, unsigned workers = 1);
+
+    /**
+     * @brief Ajuste le nombre de cartes privées ; les cartes retirées sont d'abord ajoutées à celle du worker 0.
+     * @param workers Nombre de workers (au moins 1).
+     */
+    void Resize(unsigned workers);
+
+    /**
+     * @brief Carte privée d'un worker.
+     * @param worker Indice du worker, dans [0, Workers()).
+     * @return La carte.
+     */
+    Heatmap& Local(unsigned worker) { return maps[worker]; }
+
+    /**
+     * @brief Additionne toutes les cartes dans celle du worker 0 et vide les autres.
+     * @param pool Pool exécutant les étapes de la réduction.
+     * @return La carte totale.
+     */
+    const Heatmap& Reduce(WorkStealingPool& pool);
+
+    /**
+     * @brief Remet toutes les cartes à zéro.
+     */
+    void Clear();
+
+    unsigned Workers() const { return static_cast<unsigned>(maps.size()); } ///< Nombre de cartes privées.
+
+private:
+    std::vector<Heatmap> maps; ///< Une carte par worker.
+};
+
+extern template void Heatmap::AddPlayers<Rules5x5>(const std::vector<BasicPlayer<Rules5x5>>&);
+extern template void Heatmap::AddPlayers<Rules3x3>(const std::vector<BasicPlayer<Rules3x3>>&);
+extern template void Heatmap::AddPlayers<RulesDrill2x2>(const std::vector<BasicPlayer<RulesDrill2x2>>&);
+
+#endif // HEATMAP_HPP
@@ -3,7 +3,7 @@
  * @brief Point d'entrée principal pour tester les fonctionnalités du projet de simulation de basketball.
  */
 
-#include "basket.cpp"
+#include "basket.hpp"
 #include <iostream>
 
 /**
@@ -18,10 +18,10 @@
  */
 int main() {
     // Création de joueurs
-    Player player1{Position{10, 20}, true, 1}; ///< Joueur 1 possédant initialement le ballon.
-    Player player2{Position{30, 40}, false, 2}; ///< Joueur 2 sans ballon.
-    Player player3{Position{50, 60}, false, 3}; ///< Joueur 3 sans ballon.
-    Player player4{Position{70, 80}, false, 4}; ///< Joueur 4 sans ballon.
+    Player player1{Position{10, 20}, true, 1, {}, {}}; ///< Joueur 1 possédant initialement le ballon.
+    Player player2{Position{30, 40}, false, 2, {}, {}}; ///< Joueur 2 sans ballon.
+    Player player3{Position{50, 60}, false, 3, {}, {}}; ///< Joueur 3 sans ballon.
+    Player player4{Position{70, 80}, false, 4, {}, {}}; ///< Joueur 4 sans ballon.
 
     // Initialisation des coéquipiers et adversaires
     std::vector<Player> players = {player1, player2, player3, player4};
@@ -0,0 +1,343 @@
+#include "match.hpp"
+#include "metrics.hpp"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr float kPullUpBand = 1.5f; ///< Profondeur, derrière la ligne, de la zone des tirs à 3 points.
+
+/**
+ * @brief Ramène une position à l'intérieur du terrain.
+ * @param p Position à borner.
+ */
+template <class Rules>
+void clamp_to_court(Position& p) {
+    p.x = std::fmin(std::fmax(p.x, 0.f), Rules::court_x);
+    p.y = std::fmin(std::fmax(p.y, 0.f), Rules::court_y);
+}
+
+/**
+ * @brief Décalage latéral d'une place de formation : 0 pour la place 0, puis alternativement
+ * d'un côté et de l'autre, de plus en plus loin de l'axe.
+ * @param slot Place dans l'équipe.
+ * @param team_size Joueurs par équipe.
+ * @return Une valeur dans [-1, 1].
+ */
+float formation_offset(int slot, int team_size) {
+    if (slot == 0) {
+        return 0.f;
+    }
+    const int rings = team_size / 2;
+    const int ring = (slot + 1) / 2;
+    const float side = slot % 2 ? -1.f : 1.f;
+    return side * ring / static_cast<float>(rings ? rings : 1);
+}
+
+} // namespace
+
+/**
+ * @brief Constructeur plaçant les joueurs en position d'entre-deux.
+ *
+ * Les places offensives sont réparties en arc autour du panier, à une distance
+ * proportionnelle à la hauteur du terrain.
+ *
+ * @param config Paramètres de simulation.
+ */
+template <class Rules>
+BasicMatch<Rules>::BasicMatch(const MatchConfig& config) : config(config) {
+    const float radius = 0.14f * Rules::court_y;
+    for (int slot = 0; slot < Rules::team_size; ++slot) {
+        const float angle = 1.3f * formation_offset(slot, Rules::team_size);
+        attack_spots[slot] = Position{radius * std::cos(angle), radius * std::sin(angle)};
+    }
+
+    roster.reserve(kPlayers);
+    for (int i = 0; i < kPlayers; ++i) {
+        roster.push_back(PlayerType{Position{0.f, 0.f}, false, i, {}, {}});
+    }
+    coaches[0].Attach(&gamescore.Events(), 0);
+    coaches[1].Attach(&gamescore.Events(), 1);
+    reset();
+}
+
+/**
+ * @brief Panier attaqué par une équipe.
+ * @param team Identifiant de l'équipe.
+ * @return La position du panier visé.
+ */
+template <class Rules>
+Position BasicMatch<Rules>::target_basket(int team) {
+    return Position{team == 0 ? Rules::court_x : 0.f, Rules::court_y / 2};
+}
+
+/**
+ * @brief Replace les joueurs et remet le score et le temps à zéro.
+ */
+template <class Rules>
+void BasicMatch<Rules>::reset() {
+    for (int i = 0; i < kPlayers; ++i) {
+        PlayerType& player = roster[i];
+        const int slot = i % Rules::team_size;
+        const float depth = (0.05f + 0.03f * slot) * Rules::court_x;
+        const float lane = (0.5f + 0.3f * formation_offset(slot, Rules::team_size)) * Rules::court_y;
+        player.position = Position{team_of(player) == 0 ? Rules::court_x / 2 - depth : Rules::court_x / 2 + depth,
+                                   lane};
+        player.possede_ball = false;
+    }
+
+    ticks = 0;
+    seed = config.seed;
+    match_id = config.match_id;
+    key = KeyFor(seed, match_id);
+    live.Reset();
+    gamescore.homeScore = 0;
+    gamescore.awayScore = 0;
+
+    tracker.Reset(roster);
+    ball.possesseur = nullptr;
+    give_ball(&roster[0]);
+}
+
+/**
+ * @brief Avance le match d'un pas de temps.
+ */
+template <class Rules>
+void BasicMatch<Rules>::tick() {
+    LatencyTimer timer(Histogram::TickNs);
+    CountMetric(Counter::Ticks);
+    draw_tick();
+    move_players();
+    refresh_neighbours();
+    update_possession();
+    update_score();
+    ++ticks;
+}
+
+/**
+ * @brief Sauvegarde l'état du match.
+ * @return L'état, sans pointeur.
+ */
+template <class Rules>
+typename BasicMatch<Rules>::State BasicMatch<Rules>::snapshot() const {
+    State state;
+    for (int i = 0; i < kPlayers; ++i) {
+        state.x[i] = roster[i].position.x;
+        state.y[i] = roster[i].position.y;
+    }
+    state.ball_x = ball.position.x;
+    state.ball_y = ball.position.y;
+    state.holder = ball.possesseur ? ball.possesseur->number : -1;
+    const ScoreSnapshot score = live.Snapshot();
+    state.home = score.home;
+    state.away = score.away;
+    state.seed = seed;
+    state.match_id = match_id;
+    state.ticks = ticks;
+    return state;
+}
+
+/**
+ * @brief Reprend le match depuis un état sauvegardé, sans notifier les observateurs.
+ * @param state État produit par snapshot().
+ */
+template <class Rules>
+void BasicMatch<Rules>::restore(const State& state) {
+    assert(state.holder >= -1 && state.holder < kPlayers && "Porteur hors de l'effectif");
+    const int holder = state.holder >= 0 && state.holder < kPlayers ? state.holder : 0;
+    for (int i = 0; i < kPlayers; ++i) {
+        roster[i].position = Position{state.x[i], state.y[i]};
+        roster[i].possede_ball = i == holder;
+    }
+    ball.possesseur = &roster[holder];
+    ball.position = Position{state.ball_x, state.ball_y};
+    live.Set(state.home, state.away);
+    gamescore.homeScore = state.home;
+    gamescore.awayScore = state.away;
+    seed = state.seed;
+    match_id = state.match_id;
+    key = KeyFor(seed, match_id);
+    ticks = state.ticks;
+    tracker.Reset(roster);
+}
+
+/**
+ * @brief Exécute plusieurs ticks et mesure le débit.
+ * @param count Nombre de ticks à exécuter.
+ * @return Le nombre de ticks par seconde mesuré.
+ */
+template <class Rules>
+double BasicMatch<Rules>::run(std::uint64_t count) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        tick();
+    }
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    last_ticks_per_second = seconds.count() > 0.0 ? count / seconds.count() : 0.0;
+    return last_ticks_per_second;
+}
+
+/**
+ * @brief Déplace chaque joueur d'au plus un pas vers sa cible.
+ *
+ * Le porteur fonce vers le panier, ses coéquipiers occupent des places autour de la
+ * raquette, et chaque défenseur se place entre son vis-à-vis et son propre panier.
+ */
+template <class Rules>
+void BasicMatch<Rules>::move_players() {
+    const int attacking = team_of(*ball.possesseur);
+    const Position basket = target_basket(attacking);
+    const float inward = attacking == 0 ? -1.f : 1.f;
+    const float step = config.player_speed * config.dt;
+    const float marking = tactics(1 - attacking).marking;
+
+    for (int i = 0; i < kPlayers; ++i) {
+        PlayerType& player = roster[i];
+        Position target;
+        if (team_of(player) == attacking) {
+            if (&player == ball.possesseur) {
+                target = basket;
+            } else {
+                const Position& spot = attack_spots[i % Rules::team_size];
+                target = Position{basket.x + inward * spot.x, basket.y + spot.y};
+            }
+        } else {
+            const Position& mark = roster[(i + Rules::team_size) % kPlayers].position;
+            target = Position{mark.x + marking * (basket.x - mark.x), mark.y + marking * (basket.y - mark.y)};
+        }
+
+        float dx = target.x - player.position.x + (random(player, 0) - 0.5f) * step;
+        float dy = target.y - player.position.y + (random(player, 1) - 0.5f) * step;
+        const float length = std::sqrt(dx * dx + dy * dy);
+        if (length > step) {
+            dx *= step / length;
+            dy *= step / length;
+        }
+        player.position.x += dx;
+        player.position.y += dy;
+        clamp_to_court<Rules>(player.position);
+    }
+}
+
+/**
+ * @brief Met à jour les coéquipiers et adversaires les plus proches de tous les joueurs.
+ *
+ * Seules les listes dont la marge de mouvement est épuisée sont vérifiées.
+ */
+template <class Rules>
+void BasicMatch<Rules>::refresh_neighbours() {
+    tracker.Update(roster);
+}
+
+/**
+ * @brief Fait suivre le ballon et déclenche une passe à intervalle régulier.
+ *
+ * Le receveur est la meilleure option du BasicPassEvaluator, ou le coéquipier le plus
+ * proche si evaluate_passes est désactivé.
+ */
+template <class Rules>
+void BasicMatch<Rules>::update_possession() {
+    ball.position = ball.possesseur->position;
+    if (config.pass_interval <= 0 || ticks == 0 || ticks % config.pass_interval != 0) {
+        return;
+    }
+
+    PlayerType* passer = ball.possesseur;
+    if (config.evaluate_passes) {
+        if (passes.Evaluate(*passer, target_basket(team_of(*passer)))) {
+            CountMetric(Counter::PassesCompleted);
+            give_ball(passes.Best()->receiver);
+        } else {
+            CountMetric(Counter::PassesFailed);
+        }
+    } else if (ball.changer_possesseur()) {
+        CountMetric(Counter::PassesCompleted);
+        passer->possede_ball = false;
+        give_ball(ball.possesseur);
+    } else {
+        CountMetric(Counter::PassesFailed);
+    }
+}
+
+/**
+ * @brief Fait tirer le porteur à portée du panier et met à jour le score.
+ *
+ * Avec le modèle de tir, le porteur peut aussi tenter un tir à 3 points juste derrière
+ * la ligne, et la réussite dépend de la distance et du défenseur le plus proche.
+ * Qu'il soit réussi ou manqué, le tir rend le ballon au défenseur le plus proche.
+ */
+template <class Rules>
+void BasicMatch<Rules>::update_score() {
+    PlayerType* shooter = ball.possesseur;
+    const int team = team_of(*shooter);
+    const Position basket = target_basket(team);
+    const float distance = shooter->position.distance_to(basket);
+    const bool pull_up = config.shot_model && distance >= ShotModel::kThreePointRange &&
+                         distance < ShotModel::kThreePointRange + kPullUpBand &&
+                         random(*shooter, 2) < config.three_point_rate;
+    if (distance > config.shot_range * tactics(team).shot_range_scale && !pull_up) {
+        return;
+    }
+
+    CountMetric(Counter::ShotsTaken);
+    int points = 0;
+    if (config.shot_model) {
+        points = ShotModel::Resolve(*shooter, basket, random(*shooter, 3)).Points();
+    } else if (random(*shooter, 3) < config.make_probability) {
+        points = 2;
+    }
+    if (points) {
+        CountMetric(Counter::ShotsMade);
+        const ScoreSnapshot after = live.Add(team, points);
+        gamescore.UpdateScore(after.home, after.away);
+    }
+
+    if (shooter->Opponents[0]) {
+        give_ball(shooter->Opponents[0]);
+    }
+}
+
+/**
+ * @brief Donne le ballon à un joueur et émet un événement EventType::Possession.
+ * @param player Nouveau possesseur.
+ */
+template <class Rules>
+void BasicMatch<Rules>::give_ball(PlayerType* player) {
+    if (ball.possesseur) {
+        ball.possesseur->possede_ball = false;
+    }
+    ball.possesseur = player;
+    player->possede_ball = true;
+    ball.position = player->position;
+
+    GameEvent event{EventType::Possession};
+    event.player = player->number;
+    event.team = team_of(*player);
+    gamescore.Events().Notify(event);
+}
+
+/**
+ * @brief Consignes de la stratégie d'une équipe.
+ * @param team Identifiant de l'équipe.
+ * @return Les consignes du coach, ou celles par défaut sans stratégie.
+ */
+template <class Rules>
+Tactics BasicMatch<Rules>::tactics(int team) const {
+    const Strategy* strategy = coaches[team].GetStrategy();
+    return strategy ? strategy->GetTactics() : Tactics();
+}
+
+/**
+ * @brief Tire les blocs du tick en cours, un par joueur.
+ */
+template <class Rules>
+void BasicMatch<Rules>::draw_tick() {
+    const PhiloxBlock first{{0, static_cast<std::uint32_t>(ticks), static_cast<std::uint32_t>(ticks >> 32),
+                             static_cast<std::uint32_t>(RandomStream::Match)}};
+    PhiloxFill(key, first, kDrawBlocks, draws);
+}
+
+template class BasicMatch<Rules5x5>;
+template class BasicMatch<Rules3x3>;
+template class BasicMatch<RulesDrill2x2>;
@@ -0,0 +1,228 @@
+/**
+ * @file match.hpp
+ * @brief Moteur de match à pas de temps fixe.
+ */
+
+#ifndef MATCH_HPP
+#define MATCH_HPP
+
+#include "basket.hpp"
+#include "counter_rng.hpp"
+#include "match_score.hpp"
+#include "neighbour_tracker.hpp"
+#include "pass_evaluator.hpp"
+#include "shot_model.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Paramètres de simulation d'un match.
+ */
+struct MatchConfig {
+    float dt = 0.04f; ///< Pas de temps fixe en secondes (25 Hz).
+    float player_speed = 6.f; ///< Vitesse maximale d'un joueur (unités par seconde).
+    float shot_range = 6.f; ///< Distance au panier à partir de laquelle le porteur tire.
+    float make_probability = 0.5f; ///< Probabilité de réussite d'un tir, sans modèle de tir.
+    bool shot_model = true; ///< Résout les tirs par ShotModel (distance, défenseur, 2 ou 3 points).
+    float three_point_rate = 0.04f; ///< Avec le modèle, probabilité par tick d'un tir pris juste derrière la ligne à 3 points.
+    int pass_interval = 25; ///< Nombre de ticks entre deux passes.
+    bool evaluate_passes = true; ///< Choisit la passe selon les lignes d'interception (sinon le plus proche).
+    std::uint32_t seed = 1; ///< Graine des tirages pseudo-aléatoires.
+    std::uint64_t match_id = 0; ///< Identifiant du match ; avec la graine, forme la clé des tirages.
+};
+
+/**
+ * @brief État complet d'un match, sans pointeur : copiable par memcpy.
+ *
+ * Positions des joueurs, ballon (par numéro de porteur), score, temps et clé des
+ * tirages pseudo-aléatoires. Les tables de voisins et les stratégies n'en font pas partie : les
+ * premières sont recalculées par BasicMatch::restore(), les secondes restent celles des
+ * coachs du match restauré.
+ *
+ * @tparam Rules Règles de la variante de jeu.
+ */
+template <class Rules>
+struct BasicGameState {
+    float x[Rules::players]; ///< Positions X des joueurs, par numéro.
+    float y[Rules::players]; ///< Positions Y des joueurs, par numéro.
+    float ball_x; ///< Position X du ballon.
+    float ball_y; ///< Position Y du ballon.
+    std::int32_t holder; ///< Numéro du porteur du ballon, -1 si aucun (restore() le donne alors au joueur 0).
+    std::int32_t home; ///< Score de l'équipe à domicile.
+    std::int32_t away; ///< Score de l'équipe adverse.
+    std::uint32_t seed; ///< Graine des tirages.
+    std::uint64_t match_id; ///< Identifiant du match, second élément de la clé des tirages.
+    std::uint64_t ticks; ///< Nombre de ticks écoulés.
+};
+
+static_assert(std::is_trivially_copyable_v<BasicGameState<Rules5x5>>, "Un état de match se copie par memcpy");
+
+using GameState = BasicGameState<Rules5x5>; ///< État d'un match à cinq contre cinq.
+
+/**
+ * @brief Moteur de match possédant les joueurs, le ballon, le score et les deux coachs.
+ *
+ * Chaque appel à tick() avance le jeu d'un pas de temps fixe, dans l'ordre :
+ * déplacement, mise à jour des voisins, possession, puis score. Toute la mémoire est
+ * réservée à la construction : la boucle de simulation n'alloue plus ensuite.
+ * L'équipe 0 attaque le panier de droite, l'équipe 1 celui de gauche. Les consignes
+ * (Tactics) de la stratégie de chaque coach règlent la distance de tir de son équipe
+ * et le marquage de ses défenseurs ; snapshot() et restore() permettent de reprendre
+ * un match depuis un état sauvegardé, par exemple pour simuler des variantes.
+ *
+ * @tparam Rules Règles de la variante de jeu (taille des équipes, dimensions du terrain).
+ */
+template <class Rules>
+class BasicMatch {
+public:
+    using PlayerType = BasicPlayer<Rules>; ///< Type des joueurs.
+    using BallonType = BasicBallon<Rules>; ///< Type du ballon.
+
+    using State = BasicGameState<Rules>; ///< État sauvegardable du match.
+
+    static constexpr int kPlayers = Rules::players; ///< Nombre de joueurs sur le terrain.
+
+    /**
+     * @brief Constructeur plaçant les joueurs en position d'entre-deux.
+     * @param config Paramètres de simulation.
+     */
+    explicit BasicMatch(const MatchConfig& config = MatchConfig());
+
+    BasicMatch(const BasicMatch&) = delete; ///< Non copiable : les joueurs se référencent par pointeurs.
+    BasicMatch& operator=(const BasicMatch&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Replace les joueurs et remet le score et le temps à zéro.
+     */
+    void reset();
+
+    /**
+     * @brief Avance le match d'un pas de temps.
+     */
+    void tick();
+
+    /**
+     * @brief Sauvegarde l'état du match.
+     * @return L'état, sans pointeur.
+     */
+    State snapshot() const;
+
+    /**
+     * @brief Reprend le match depuis un état sauvegardé, sans notifier les observateurs.
+     *
+     * Les tables de voisins sont recalculées ; les coachs et leurs stratégies sont conservés.
+     * Sans porteur (holder à -1), le ballon revient au joueur 0, comme au coup d'envoi ; un
+     * numéro hors de [-1, joueurs) est une erreur de l'appelant (assertion, puis même repli).
+     *
+     * @param state État produit par snapshot(), éventuellement par un autre match.
+     */
+    void restore(const State& state);
+
+    /**
+     * @brief Exécute plusieurs ticks et mesure le débit.
+     * @param ticks Nombre de ticks à exécuter.
+     * @return Le nombre de ticks par seconde mesuré.
+     */
+    double run(std::uint64_t ticks);
+
+    /**
+     * @brief Débit mesuré lors du dernier appel à run().
+     * @return Le nombre de ticks par seconde.
+     */
+    double ticks_per_second() const { return last_ticks_per_second; }
+
+    std::uint64_t tick_count() const { return ticks; } ///< Nombre de ticks écoulés.
+    float elapsed() const { return ticks * config.dt; } ///< Temps de jeu écoulé en secondes.
+    const MatchConfig& settings() const { return config; } ///< Paramètres de simulation.
+
+    std::vector<PlayerType>& players() { return roster; } ///< Les joueurs.
+    const std::vector<PlayerType>& players() const { return roster; } ///< Les joueurs.
+    BallonType& ballon() { return ball; } ///< Le ballon.
+    const BallonType& ballon() const { return ball; } ///< Le ballon.
+    Gamescore& score() { return gamescore; } ///< Le score du match et ses arbitres.
+    const MatchScore& live_score() const { return live; } ///< Score atomique, lisible depuis d'autres threads.
+    const Gamescore& score() const { return gamescore; } ///< Le score du match.
+    ObserverRegistry& events() { return gamescore.Events(); } ///< Abonnements aux événements du match.
+    Coach& coach(int team) { return coaches[team]; } ///< Le coach d'une équipe (0 ou 1).
+    const Coach& coach(int team) const { return coaches[team]; } ///< Le coach d'une équipe (0 ou 1).
+    const BasicNeighbourTracker<Rules>& neighbours() const { return tracker; } ///< Suivi des voisins.
+
+    /**
+     * @brief Équipe d'un joueur.
+     * @param player Le joueur.
+     * @return 0 ou 1.
+     */
+    static int team_of(const PlayerType& player) { return Rules::team_of(player.number); }
+
+    /**
+     * @brief Panier attaqué par une équipe.
+     * @param team Identifiant de l'équipe.
+     * @return La position du panier visé.
+     */
+    static Position target_basket(int team);
+
+private:
+    MatchConfig config; ///< Paramètres de simulation.
+    std::vector<PlayerType> roster; ///< Les joueurs, réservés une fois pour toutes.
+    BallonType ball; ///< Le ballon.
+    Gamescore gamescore; ///< Score propre au match, notifié aux arbitres.
+    MatchScore live; ///< Score de référence, dans un seul mot atomique.
+    Coach coaches[2]; ///< Coachs des deux équipes.
+    BasicNeighbourTracker<Rules> tracker; ///< Maintien incrémental des voisins.
+    BasicPassEvaluator<Rules> passes; ///< Évaluation des passes du porteur.
+    Position attack_spots[Rules::team_size]; ///< Places offensives autour du panier, vers l'intérieur du terrain.
+    std::uint64_t ticks = 0; ///< Nombre de ticks écoulés.
+    std::uint32_t seed = 1; ///< Graine des tirages.
+    std::uint64_t match_id = 0; ///< Identifiant du match.
+    PhiloxKey key{}; ///< Clé des tirages, KeyFor(seed, match_id).
+    static constexpr int kDrawBlocks = (kPlayers + 7) / 8 * 8; ///< Blocs tirés par tick : arrondi aux paquets vectorisés.
+    std::uint32_t draws[4 * kDrawBlocks]; ///< Tirages du tick en cours : un bloc de quatre mots par joueur.
+    double last_ticks_per_second = 0.0; ///< Débit du dernier run().
+
+    void move_players(); ///< Étape 1 : déplacement des joueurs.
+    void refresh_neighbours(); ///< Étape 2 : coéquipiers et adversaires les plus proches.
+    void update_possession(); ///< Étape 3 : passes et suivi du ballon.
+    void update_score(); ///< Étape 4 : tirs et mise à jour du score.
+
+    /**
+     * @brief Donne le ballon à un joueur.
+     * @param player Nouveau possesseur.
+     */
+    void give_ball(PlayerType* player);
+
+    /**
+     * @brief Consignes de la stratégie d'une équipe.
+     * @param team Identifiant de l'équipe.
+     * @return Les consignes, par défaut sans stratégie.
+     */
+    Tactics tactics(int team) const;
+
+    /**
+     * @brief Tire les blocs du tick en cours, un par joueur, en un seul passage vectorisé.
+     *
+     * Le bloc du joueur n au tick t est Philox4x32({n, t, t >> 32, RandomStream::Match}, key) :
+     * les tirages ne dépendent que de (graine, match, joueur, tick).
+     */
+    void draw_tick();
+
+    /**
+     * @brief Tirage uniforme du tick en cours.
+     *
+     * Mots : 0 et 1 pour l'écart de déplacement, 2 pour la décision de tir à 3 points,
+     * 3 pour la réussite d'un tir.
+     *
+     * @param player Joueur.
+     * @param word Mot de son bloc, de 0 à 3.
+     * @return Une valeur dans [0, 1).
+     */
+    float random(const PlayerType& player, int word) const { return ToUnitFloat(draws[4 * player.number + word]); }
+};
+
+extern template class BasicMatch<Rules5x5>;
+extern template class BasicMatch<Rules3x3>;
+extern template class BasicMatch<RulesDrill2x2>;
+
+using Match = BasicMatch<Rules5x5>; ///< Match classique à cinq contre cinq.
+
+#endif // MATCH_HPP
@@ -0,0 +1,407 @@
+#include "match_log.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kInitialMapping = 1 << 20; ///< Taille initiale de la projection en écriture.
+constexpr std::size_t kKeyHeader = 16; ///< Octets fixes d'une image clé.
+constexpr std::size_t kDeltaHeader = 4; ///< Octets fixes d'une image delta.
+
+/**
+ * @brief Quantifie une coordonnée en virgule fixe.
+ */
+std::int32_t quantize(float v) {
+    return static_cast<std::int32_t>(std::lround(v * match_log::kScale));
+}
+
+/**
+ * @brief Écrit une valeur brute à une adresse quelconque.
+ */
+template <typename T>
+unsigned char* put(unsigned char* at, T value) {
+    std::memcpy(at, &value, sizeof(T));
+    return at + sizeof(T);
+}
+
+/**
+ * @brief Lit une valeur brute à une adresse quelconque.
+ */
+template <typename T>
+const unsigned char* get(const unsigned char* at, T& value) {
+    std::memcpy(&value, at, sizeof(T));
+    return at + sizeof(T);
+}
+
+} // namespace
+
+/**
+ * @brief Constructeur.
+ * @param keyframe_interval Nombre de ticks entre deux images clés.
+ */
+MatchLogWriter::MatchLogWriter(std::uint32_t keyframe_interval)
+    : keyframe_interval(keyframe_interval ? keyframe_interval : 1) {}
+
+/**
+ * @brief Destructeur : ferme le journal s'il est ouvert.
+ */
+MatchLogWriter::~MatchLogWriter() {
+    Close();
+}
+
+/**
+ * @brief Crée (ou remplace) le fichier du journal.
+ * @param path Chemin du fichier.
+ * @return True si le fichier a été créé et projeté.
+ */
+bool MatchLogWriter::Open(const std::string& path) {
+    Close();
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    ticks = 0;
+    players = 0;
+    lastHome = 0;
+    lastAway = 0;
+    used = match_log::kHeaderSize;
+    index.clear();
+    if (!Reserve(0)) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Garantit la place pour @p bytes octets supplémentaires.
+ * @param bytes Nombre d'octets à écrire.
+ * @return False si l'agrandissement a échoué.
+ */
+bool MatchLogWriter::Reserve(std::size_t bytes) {
+    if (map && used + bytes <= capacity) {
+        return true;
+    }
+    std::size_t grown = capacity ? capacity : kInitialMapping;
+    while (grown < used + bytes) {
+        grown *= 2;
+    }
+    if (map) {
+        ::munmap(map, capacity);
+        map = nullptr;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(grown)) != 0) {
+        return false;
+    }
+    void* mapped = ::mmap(nullptr, grown, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    map = static_cast<unsigned char*>(mapped);
+    capacity = grown;
+    return true;
+}
+
+/**
+ * @brief Ajoute l'état d'un tick, en image clé ou en image delta.
+ *
+ * Une image clé est écrite tous les keyframe_interval ticks, ou plus tôt si un écart
+ * ne tient pas dans le format delta.
+ *
+ * @param roster Joueurs du match.
+ * @param ballon Ballon.
+ * @param homeScore Score de l'équipe à domicile.
+ * @param awayScore Score de l'équipe adverse.
+ * @return False si le journal n'est pas ouvert ou si l'écriture a échoué.
+ */
+bool MatchLogWriter::Append(const std::vector<Player>& roster, const Ballon& ballon, int homeScore, int awayScore) {
+    if (fd < 0) {
+        return false;
+    }
+    if (ticks == 0) {
+        players = static_cast<std::uint32_t>(roster.size());
+        last.assign(2 * players, 0);
+        current.assign(2 * players, 0);
+    } else if (roster.size() != players) {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < players; ++i) {
+        current[2 * i] = quantize(roster[i].position.x);
+        current[2 * i + 1] = quantize(roster[i].position.y);
+    }
+
+    std::int8_t possessor = -1;
+    if (ballon.possesseur && !roster.empty() && ballon.possesseur >= roster.data() &&
+        ballon.possesseur < roster.data() + roster.size()) {
+        possessor = static_cast<std::int8_t>(ballon.possesseur - roster.data());
+    }
+
+    const int dHome = homeScore - lastHome;
+    const int dAway = awayScore - lastAway;
+    bool key = ticks % keyframe_interval == 0 || dHome < -128 || dHome > 127 || dAway < -128 || dAway > 127;
+    for (std::uint32_t i = 0; !key && i < 2 * players; ++i) {
+        const std::int32_t d = current[i] - last[i];
+        key = d < INT16_MIN || d > INT16_MAX;
+    }
+
+    const std::size_t bytes = key ? kKeyHeader + 8 * players : kDeltaHeader + 4 * players;
+    if (!Reserve(bytes)) {
+        return false;
+    }
+
+    unsigned char* at = map + used;
+    if (key) {
+        index.push_back(match_log::IndexEntry{ticks, used});
+        at = put<std::uint8_t>(at, match_log::kKeyFrame);
+        at = put<std::int8_t>(at, possessor);
+        at = put<std::uint16_t>(at, 0);
+        at = put<std::uint32_t>(at, static_cast<std::uint32_t>(ticks));
+        at = put<std::int32_t>(at, homeScore);
+        at = put<std::int32_t>(at, awayScore);
+        for (std::uint32_t i = 0; i < 2 * players; ++i) {
+            at = put<std::int32_t>(at, current[i]);
+        }
+    } else {
+        at = put<std::uint8_t>(at, match_log::kDeltaFrame);
+        at = put<std::int8_t>(at, possessor);
+        at = put<std::int8_t>(at, static_cast<std::int8_t>(dHome));
+        at = put<std::int8_t>(at, static_cast<std::int8_t>(dAway));
+        for (std::uint32_t i = 0; i < 2 * players; ++i) {
+            at = put<std::int16_t>(at, static_cast<std::int16_t>(current[i] - last[i]));
+        }
+    }
+
+    used += bytes;
+    last.swap(current);
+    lastHome = homeScore;
+    lastAway = awayScore;
+    ++ticks;
+    return true;
+}
+
+/**
+ * @brief Écrit l'index et l'en-tête, puis ramène le fichier à sa taille utile.
+ * @return True si la fermeture a réussi.
+ */
+bool MatchLogWriter::Close() {
+    if (fd < 0) {
+        return true;
+    }
+
+    // Index aligné sur 8 octets pour être lu en place ; le bourrage nul n'est pas un type d'enregistrement
+    const std::size_t tail = (alignof(match_log::IndexEntry) - used % alignof(match_log::IndexEntry)) %
+                             alignof(match_log::IndexEntry);
+    bool ok = Reserve(tail + index.size() * sizeof(match_log::IndexEntry));
+    if (ok) {
+        std::memset(map + used, 0, tail);
+        used += tail;
+        match_log::Header header{};
+        std::memcpy(header.magic, match_log::kMagic, sizeof(header.magic));
+        header.version = match_log::kVersion;
+        header.players = players;
+        header.keyframe_interval = keyframe_interval;
+        header.ticks = ticks;
+        header.index_offset = used;
+        header.index_count = index.size();
+
+        if (!index.empty()) {
+            std::memcpy(map + used, index.data(), index.size() * sizeof(match_log::IndexEntry));
+        }
+        used += index.size() * sizeof(match_log::IndexEntry);
+        std::memcpy(map, &header, sizeof(header));
+        ok = ::msync(map, used, MS_SYNC) == 0;
+    }
+
+    if (map) {
+        ::munmap(map, capacity);
+    }
+    ok = ::ftruncate(fd, static_cast<off_t>(used)) == 0 && ok;
+    ::close(fd);
+    fd = -1;
+    map = nullptr;
+    capacity = 0;
+    return ok;
+}
+
+/**
+ * @brief Destructeur : libère la projection.
+ */
+MatchLogReader::~MatchLogReader() {
+    Close();
+}
+
+/**
+ * @brief Ouvre et projette un journal.
+ * @param path Chemin du fichier.
+ * @return True si le fichier est un journal valide.
+ */
+bool MatchLogReader::Open(const std::string& path) {
+    Close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < match_log::kHeaderSize) {
+        ::close(fd);
+        return false;
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        size = 0;
+        return false;
+    }
+    map = static_cast<const unsigned char*>(mapped);
+
+    // Champs non fiables : bornes vérifiées par soustraction ou division, sans débordement ;
+    // une image delta (4 octets par joueur) doit tenir dans la zone des enregistrements
+    std::memcpy(&header, map, sizeof(header));
+    const bool valid = std::memcmp(header.magic, match_log::kMagic, sizeof(header.magic)) == 0 &&
+                       header.version == match_log::kVersion && header.index_offset >= match_log::kHeaderSize &&
+                       header.index_offset <= size && header.index_offset % alignof(match_log::IndexEntry) == 0 &&
+                       header.index_count <= (size - header.index_offset) / sizeof(match_log::IndexEntry) &&
+                       header.players <= (header.index_offset - match_log::kHeaderSize) / 4;
+    if (!valid) {
+        Close();
+        return false;
+    }
+    ::madvise(const_cast<unsigned char*>(map), size, MADV_SEQUENTIAL);
+
+    index = reinterpret_cast<const match_log::IndexEntry*>(map + header.index_offset);
+    frame = LogFrame{};
+    frame.positions.resize(header.players);
+    fixed.assign(2 * header.players, 0);
+    record = nullptr;
+    next = header.ticks ? map + match_log::kHeaderSize : nullptr;
+    return true;
+}
+
+/**
+ * @brief Libère la projection.
+ */
+void MatchLogReader::Close() {
+    if (map) {
+        ::munmap(const_cast<unsigned char*>(map), size);
+    }
+    map = nullptr;
+    size = 0;
+    index = nullptr;
+    record = nullptr;
+    next = nullptr;
+}
+
+/**
+ * @brief Se place sur un tick donné.
+ * @param tick Tick recherché.
+ * @return False si le tick est hors du journal.
+ */
+bool MatchLogReader::Seek(std::uint64_t tick) {
+    if (!map || tick >= header.ticks || header.index_count == 0) {
+        return false;
+    }
+    const match_log::IndexEntry* end = index + header.index_count;
+    const match_log::IndexEntry* key = std::upper_bound(
+        index, end, tick, [](std::uint64_t t, const match_log::IndexEntry& e) { return t < e.tick; });
+    if (key == index) {
+        return false;
+    }
+    --key;
+    if (key->offset < match_log::kHeaderSize || key->offset >= header.index_offset) {
+        return false;
+    }
+
+    next = map + key->offset;
+    if (!Next()) {
+        return false;
+    }
+    while (frame.tick < tick) {
+        if (!Next()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Avance au tick suivant.
+ * @return False à la fin du journal.
+ */
+bool MatchLogReader::Next() {
+    if (!next || next >= map + header.index_offset) {
+        return false;
+    }
+    const unsigned char* following = Decode(next, map + header.index_offset);
+    if (!following) {
+        return false;
+    }
+    record = next;
+    next = following;
+    return true;
+}
+
+/**
+ * @brief Décode un enregistrement dans l'état courant.
+ * @param at Début de l'enregistrement.
+ * @param end Fin de la zone des enregistrements.
+ * @return Pointeur vers l'enregistrement suivant, ou nullptr si l'enregistrement est invalide ou tronqué.
+ */
+const unsigned char* MatchLogReader::Decode(const unsigned char* at, const unsigned char* end) {
+    if (end - at < 2) {
+        return nullptr;
+    }
+    const std::size_t bytes = at[0] == match_log::kKeyFrame ? kKeyHeader + 8 * std::size_t{header.players}
+                                                            : kDeltaHeader + 4 * std::size_t{header.players};
+    if (static_cast<std::size_t>(end - at) < bytes) {
+        return nullptr;
+    }
+    std::uint8_t type;
+    std::int8_t possessor;
+    at = get(at, type);
+    at = get(at, possessor);
+
+    const std::uint32_t n = 2 * header.players;
+    if (type == match_log::kKeyFrame) {
+        std::uint16_t reserved;
+        std::uint32_t tick;
+        std::int32_t home, away;
+        at = get(at, reserved);
+        at = get(at, tick);
+        at = get(at, home);
+        at = get(at, away);
+        frame.tick = tick;
+        frame.homeScore = home;
+        frame.awayScore = away;
+        for (std::uint32_t i = 0; i < n; ++i) {
+            at = get(at, fixed[i]);
+        }
+    } else if (type == match_log::kDeltaFrame) {
+        std::int8_t dHome, dAway;
+        at = get(at, dHome);
+        at = get(at, dAway);
+        ++frame.tick;
+        frame.homeScore += dHome;
+        frame.awayScore += dAway;
+        for (std::uint32_t i = 0; i < n; ++i) {
+            std::int16_t d;
+            at = get(at, d);
+            fixed[i] += d;
+        }
+    } else {
+        return nullptr;
+    }
+    frame.possessor = possessor;
+
+    for (std::uint32_t i = 0; i < header.players; ++i) {
+        frame.positions[i] = Position{fixed[2 * i] / match_log::kScale, fixed[2 * i + 1] / match_log::kScale};
+    }
+    return at;
+}
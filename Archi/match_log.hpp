@@ -0,0 +1,220 @@
+/**
+ * @file match_log.hpp
+ * @brief Journal binaire des matchs écrit par projection mémoire (mmap), avec relecture indexée.
+ */
+
+#ifndef MATCH_LOG_HPP
+#define MATCH_LOG_HPP
+
+#include "basket.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Format du journal.
+ *
+ * Le fichier commence par un en-tête de 64 octets, suivi des enregistrements (un par tick),
+ * puis de l'index des images clés écrit à la fermeture.
+ * - Image clé : type, possesseur, tick, scores, puis les positions absolues en virgule fixe (int32).
+ * - Image delta : type, possesseur, écarts de score, puis les écarts de position en virgule fixe (int16)
+ *   par rapport au tick précédent.
+ * Les positions sont quantifiées au 1/kScale d'unité ; les deltas sont calculés sur les valeurs
+ * quantifiées, si bien que la relecture ne dérive pas.
+ */
+namespace match_log {
+
+constexpr char kMagic[8] = {'B', 'S', 'K', 'L', 'O', 'G', '1', '\0'}; ///< Signature du fichier.
+constexpr std::uint32_t kVersion = 1; ///< Version du format.
+constexpr float kScale = 256.f; ///< Pas de quantification : 1/256 d'unité.
+constexpr std::uint8_t kKeyFrame = 1; ///< Type d'une image clé.
+constexpr std::uint8_t kDeltaFrame = 2; ///< Type d'une image delta.
+constexpr std::size_t kHeaderSize = 64; ///< Taille de l'en-tête.
+
+/**
+ * @brief En-tête du fichier.
+ */
+struct Header {
+    char magic[8]; ///< Signature kMagic.
+    std::uint32_t version; ///< Version du format.
+    std::uint32_t players; ///< Nombre de joueurs par image.
+    std::uint32_t keyframe_interval; ///< Nombre de ticks entre deux images clés.
+    std::uint32_t reserved; ///< Réservé.
+    std::uint64_t ticks; ///< Nombre de ticks enregistrés.
+    std::uint64_t index_offset; ///< Position de l'index des images clés.
+    std::uint64_t index_count; ///< Nombre d'entrées de l'index.
+    std::uint8_t padding[16]; ///< Complément à 64 octets.
+};
+
+/**
+ * @brief Entrée de l'index : une image clé.
+ */
+struct IndexEntry {
+    std::uint64_t tick; ///< Tick de l'image clé.
+    std::uint64_t offset; ///< Position de l'enregistrement dans le fichier.
+};
+
+static_assert(sizeof(Header) == kHeaderSize, "En-tête de journal de taille inattendue");
+
+} // namespace match_log
+
+/**
+ * @brief État du jeu reconstitué pour un tick.
+ */
+struct LogFrame {
+    std::uint64_t tick = 0; ///< Numéro du tick.
+    int possessor = -1; ///< Indice du joueur possédant le ballon, -1 si aucun.
+    int homeScore = 0; ///< Score de l'équipe à domicile.
+    int awayScore = 0; ///< Score de l'équipe adverse.
+    std::vector<Position> positions; ///< Positions des joueurs, dans l'ordre de la liste enregistrée.
+};
+
+/**
+ * @brief Écrit un journal de match en ajout seul, à travers une projection mémoire du fichier.
+ */
+class MatchLogWriter {
+public:
+    /**
+     * @brief Constructeur.
+     * @param keyframe_interval Nombre de ticks entre deux images clés.
+     */
+    explicit MatchLogWriter(std::uint32_t keyframe_interval = 250);
+
+    /**
+     * @brief Destructeur : ferme le journal s'il est ouvert.
+     */
+    ~MatchLogWriter();
+
+    MatchLogWriter(const MatchLogWriter&) = delete; ///< Non copiable.
+    MatchLogWriter& operator=(const MatchLogWriter&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Crée (ou remplace) le fichier du journal.
+     * @param path Chemin du fichier.
+     * @return True si le fichier a été créé et projeté.
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Ajoute l'état d'un tick.
+     * @param players Joueurs du match (toujours le même nombre, dans le même ordre).
+     * @param ballon Ballon ; son possesseur doit appartenir à @p players ou être nul.
+     * @param homeScore Score de l'équipe à domicile.
+     * @param awayScore Score de l'équipe adverse.
+     * @return False si le journal n'est pas ouvert ou si l'écriture a échoué.
+     */
+    bool Append(const std::vector<Player>& players, const Ballon& ballon, int homeScore, int awayScore);
+
+    /**
+     * @brief Écrit l'index et l'en-tête, puis ramène le fichier à sa taille utile.
+     * @return True si la fermeture a réussi.
+     */
+    bool Close();
+
+    bool IsOpen() const { return fd >= 0; } ///< Indique si un journal est ouvert.
+    std::uint64_t Ticks() const { return ticks; } ///< Nombre de ticks enregistrés.
+    std::size_t Bytes() const { return used; } ///< Taille utile du journal.
+
+private:
+    std::uint32_t keyframe_interval; ///< Nombre de ticks entre deux images clés.
+    int fd = -1; ///< Descripteur du fichier.
+    unsigned char* map = nullptr; ///< Projection du fichier.
+    std::size_t capacity = 0; ///< Taille projetée.
+    std::size_t used = 0; ///< Octets écrits.
+    std::uint64_t ticks = 0; ///< Ticks enregistrés.
+    std::uint32_t players = 0; ///< Joueurs par image (fixé au premier ajout).
+    int lastHome = 0; ///< Score à domicile du tick précédent.
+    int lastAway = 0; ///< Score adverse du tick précédent.
+    std::vector<std::int32_t> last; ///< Positions quantifiées du tick précédent (x, y entrelacés).
+    std::vector<std::int32_t> current; ///< Positions quantifiées du tick courant.
+    std::vector<match_log::IndexEntry> index; ///< Index des images clés.
+
+    /**
+     * @brief Garantit la place pour @p bytes octets supplémentaires, en agrandissant la projection.
+     * @param bytes Nombre d'octets à écrire.
+     * @return False si l'agrandissement a échoué.
+     */
+    bool Reserve(std::size_t bytes);
+};
+
+/**
+ * @brief Relit un journal projeté en mémoire, avec accès direct à n'importe quel tick.
+ *
+ * Seek() trouve l'image clé précédente par recherche dichotomique dans l'index (O(log n)),
+ * puis rejoue au plus keyframe_interval deltas. Next() avance d'un tick en décodant
+ * l'enregistrement directement dans la projection, sans copie intermédiaire.
+ */
+class MatchLogReader {
+public:
+    MatchLogReader() = default; ///< Constructeur par défaut.
+
+    /**
+     * @brief Destructeur : libère la projection.
+     */
+    ~MatchLogReader();
+
+    MatchLogReader(const MatchLogReader&) = delete; ///< Non copiable.
+    MatchLogReader& operator=(const MatchLogReader&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Ouvre et projette un journal.
+     * @param path Chemin du fichier.
+     * @return True si le fichier est un journal valide.
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Libère la projection.
+     */
+    void Close();
+
+    /**
+     * @brief Se place sur un tick donné.
+     * @param tick Tick recherché.
+     * @return False si le tick est hors du journal.
+     */
+    bool Seek(std::uint64_t tick);
+
+    /**
+     * @brief Avance au tick suivant (au premier tick après Open()).
+     * @return False à la fin du journal.
+     */
+    bool Next();
+
+    /**
+     * @brief État du tick courant.
+     * @return L'image reconstituée.
+     */
+    const LogFrame& Current() const { return frame; }
+
+    /**
+     * @brief Enregistrement brut du tick courant, pointant dans la projection.
+     * @return Pointeur vers l'enregistrement, ou nullptr avant le premier tick.
+     */
+    const unsigned char* Record() const { return record; }
+
+    std::uint64_t Ticks() const { return header.ticks; } ///< Nombre de ticks du journal.
+    std::uint32_t Players() const { return header.players; } ///< Joueurs par image.
+    std::uint32_t KeyframeInterval() const { return header.keyframe_interval; } ///< Intervalle des images clés.
+
+private:
+    const unsigned char* map = nullptr; ///< Projection du fichier.
+    std::size_t size = 0; ///< Taille du fichier.
+    match_log::Header header{}; ///< En-tête lu.
+    const match_log::IndexEntry* index = nullptr; ///< Index des images clés (dans la projection).
+    const unsigned char* record = nullptr; ///< Enregistrement courant.
+    const unsigned char* next = nullptr; ///< Enregistrement suivant.
+    LogFrame frame; ///< État reconstitué.
+    std::vector<std::int32_t> fixed; ///< Positions quantifiées courantes.
+
+    /**
+     * @brief Décode l'enregistrement pointé par @p at dans l'état courant.
+     * @param at Début de l'enregistrement.
+     * @param end Fin de la zone des enregistrements (début de l'index).
+     * @return Pointeur vers l'enregistrement suivant, ou nullptr si l'enregistrement est invalide ou tronqué.
+     */
+    const unsigned char* Decode(const unsigned char* at, const unsigned char* end);
+};
+
+#endif // MATCH_LOG_HPP
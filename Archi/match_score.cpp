@@ -0,0 +1,81 @@
+#include "match_score.hpp"
+
+/**
+ * @brief Ajoute des points à une équipe, par un seul fetch_add.
+ * @param team 0 pour l'équipe à domicile, 1 pour l'équipe adverse.
+ * @param points Points marqués.
+ * @return Le score juste après cet ajout.
+ */
+ScoreSnapshot MatchScore::Add(int team, unsigned points) {
+    const std::uint64_t delta = (std::uint64_t(1) << kSequenceShift) |
+                                (std::uint64_t(points & kScoreMask) << (team == 0 ? kScoreBits : 0));
+    const std::uint64_t before = word.fetch_add(delta, std::memory_order_acq_rel);
+    return Unpack(before + delta);
+}
+
+/**
+ * @brief Impose un score.
+ * @param home Score de l'équipe à domicile.
+ * @param away Score de l'équipe adverse.
+ * @return Le score écrit.
+ */
+ScoreSnapshot MatchScore::Set(int home, int away) {
+    const std::uint64_t scores = (std::uint64_t(home) & kScoreMask) << kScoreBits |
+                                 (std::uint64_t(away) & kScoreMask);
+    std::uint64_t current = word.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    do {
+        next = ((current >> kSequenceShift) + 1) << kSequenceShift | scores;
+    } while (!word.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return Unpack(next);
+}
+
+/**
+ * @brief Registre partagé par tout le processus.
+ * @return Le registre global.
+ */
+ScoreRegistry& ScoreRegistry::Global() {
+    static ScoreRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Inscrit un score.
+ * @param match_id Identifiant du match.
+ * @param score Score du match.
+ * @return False si l'identifiant est déjà utilisé.
+ */
+bool ScoreRegistry::Register(std::uint64_t match_id, MatchScore* score) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return scores.emplace(match_id, score).second;
+}
+
+/**
+ * @brief Désinscrit un match.
+ * @param match_id Identifiant du match.
+ * @return True si le match était inscrit.
+ */
+bool ScoreRegistry::Unregister(std::uint64_t match_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return scores.erase(match_id) > 0;
+}
+
+/**
+ * @brief Recherche le score d'un match.
+ * @param match_id Identifiant du match.
+ * @return Le score, ou nullptr.
+ */
+MatchScore* ScoreRegistry::Find(std::uint64_t match_id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = scores.find(match_id);
+    return it == scores.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Nombre de matchs inscrits.
+ * @return Le nombre d'entrées.
+ */
+std::size_t ScoreRegistry::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return scores.size();
+}
@@ -0,0 +1,128 @@
+/**
+ * @file match_score.hpp
+ * @brief Score d'un match dans un seul mot atomique, et registre des scores par identifiant.
+ */
+
+#ifndef MATCH_SCORE_HPP
+#define MATCH_SCORE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Lecture cohérente d'un score : les trois champs proviennent du même instant.
+ */
+struct ScoreSnapshot {
+    int home; ///< Score de l'équipe à domicile.
+    int away; ///< Score de l'équipe adverse.
+    std::uint32_t sequence; ///< Numéro de la dernière modification (modulo 2^16).
+};
+
+/**
+ * @brief Score d'un match modifiable sans verrou par plusieurs threads.
+ *
+ * Domicile, extérieur et numéro de séquence sont rangés dans un seul mot de 64 bits :
+ * séquence sur les bits 48 à 63, domicile sur les bits 24 à 47, extérieur sur les bits
+ * 0 à 23. Ajouter des points est un unique fetch_add, qui incrémente aussi la séquence ;
+ * une lecture est un unique load, jamais déchirée. Chaque score est limité à 2^24 - 1
+ * points et la séquence reboucle après 65535 modifications.
+ */
+class MatchScore {
+public:
+    static constexpr int kScoreBits = 24; ///< Bits par score.
+    static constexpr int kSequenceShift = 48; ///< Position de la séquence.
+    static constexpr std::uint64_t kScoreMask = (std::uint64_t(1) << kScoreBits) - 1; ///< Masque d'un score.
+
+    /**
+     * @brief Ajoute des points à une équipe.
+     * @param team 0 pour l'équipe à domicile, 1 pour l'équipe adverse.
+     * @param points Points marqués.
+     * @return Le score juste après cet ajout.
+     */
+    ScoreSnapshot Add(int team, unsigned points);
+
+    /**
+     * @brief Impose un score (incrémente la séquence).
+     * @param home Score de l'équipe à domicile.
+     * @param away Score de l'équipe adverse.
+     * @return Le score écrit.
+     */
+    ScoreSnapshot Set(int home, int away);
+
+    /**
+     * @brief Remet le score et la séquence à zéro.
+     */
+    void Reset() { word.store(0, std::memory_order_relaxed); }
+
+    /**
+     * @brief Lecture cohérente du score.
+     * @return Le score courant.
+     */
+    ScoreSnapshot Snapshot() const { return Unpack(word.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief Décode un mot de score.
+     * @param packed Mot de 64 bits.
+     * @return Les trois champs.
+     */
+    static constexpr ScoreSnapshot Unpack(std::uint64_t packed) {
+        return ScoreSnapshot{static_cast<int>((packed >> kScoreBits) & kScoreMask),
+                             static_cast<int>(packed & kScoreMask),
+                             static_cast<std::uint32_t>(packed >> kSequenceShift)};
+    }
+
+private:
+    std::atomic<std::uint64_t> word{0}; ///< Séquence, domicile et extérieur.
+};
+
+/**
+ * @brief Registre thread-safe des scores de match, indexés par identifiant.
+ *
+ * Remplace Gamescore::GetInstance() pour le code qui doit retrouver le score d'un match
+ * sans le recevoir en paramètre. Le registre ne possède pas les scores : un match doit
+ * se désinscrire avant sa destruction.
+ */
+class ScoreRegistry {
+public:
+    /**
+     * @brief Registre partagé par tout le processus (construit au premier appel, sans course).
+     * @return Le registre global.
+     */
+    static ScoreRegistry& Global();
+
+    /**
+     * @brief Inscrit un score.
+     * @param match_id Identifiant du match.
+     * @param score Score du match.
+     * @return False si l'identifiant est déjà utilisé.
+     */
+    bool Register(std::uint64_t match_id, MatchScore* score);
+
+    /**
+     * @brief Désinscrit un match.
+     * @param match_id Identifiant du match.
+     * @return True si le match était inscrit.
+     */
+    bool Unregister(std::uint64_t match_id);
+
+    /**
+     * @brief Recherche le score d'un match.
+     * @param match_id Identifiant du match.
+     * @return Le score, ou nullptr.
+     */
+    MatchScore* Find(std::uint64_t match_id) const;
+
+    /**
+     * @brief Nombre de matchs inscrits.
+     * @return Le nombre d'entrées.
+     */
+    std::size_t Size() const;
+
+private:
+    mutable std::mutex mutex; ///< Protège la table.
+    std::unordered_map<std::uint64_t, MatchScore*> scores; ///< Scores par identifiant.
+};
+
+#endif // MATCH_SCORE_HPP
@@ -0,0 +1,287 @@
+#include "metrics.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/// Noms des compteurs, dans l'ordre de Counter.
+constexpr const char* kCounterNames[kCounters] = {
+    "ticks", "neighbour_searches", "neighbour_repairs", "passes_completed", "passes_failed",
+    "shots_taken", "shots_made", "observer_calls",
+};
+
+/// Noms des histogrammes, dans l'ordre de Histogram.
+constexpr const char* kHistogramNames[kHistograms] = {"tick_ns", "dispatch_ns"};
+
+/**
+ * @brief Borne haute (incluse) d'un seau.
+ * @param bucket Indice du seau.
+ * @return 2^bucket - 1.
+ */
+std::uint64_t bucket_bound(int bucket) {
+    return (std::uint64_t{1} << bucket) - 1;
+}
+
+#ifdef BASKET_METRICS
+
+/**
+ * @brief Blocs des threads vivants et cumul des threads terminés.
+ */
+struct Registry {
+    std::mutex mutex; ///< Protège live et retired.
+    std::vector<ThreadMetrics*> live; ///< Blocs des threads vivants.
+    MetricsSnapshot retired; ///< Valeurs des threads terminés.
+};
+
+/**
+ * @brief Registre, jamais détruit : des threads peuvent se terminer après la sortie de main.
+ */
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+/**
+ * @brief Ajoute un bloc à un cumul.
+ * @param into Cumul.
+ * @param metrics Bloc lu.
+ */
+void accumulate(MetricsSnapshot& into, const ThreadMetrics& metrics) {
+    for (int c = 0; c < kCounters; ++c) {
+        into.counters[c] += metrics.counters[c].load(std::memory_order_relaxed);
+    }
+    for (int h = 0; h < kHistograms; ++h) {
+        for (int b = 0; b < kLatencyBuckets; ++b) {
+            const std::uint64_t n = metrics.buckets[h][b].load(std::memory_order_relaxed);
+            into.buckets[h][b] += n;
+            into.count[h] += n;
+        }
+        into.sum[h] += metrics.sum[h].load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Propriétaire du bloc d'un thread : le verse au cumul à la fin du thread.
+ */
+struct ThreadMetricsOwner {
+    std::unique_ptr<ThreadMetrics> metrics = std::make_unique<ThreadMetrics>(); ///< Bloc du thread.
+
+    ThreadMetricsOwner() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(metrics.get());
+    }
+
+    ~ThreadMetricsOwner() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        accumulate(r.retired, *metrics);
+        r.live.erase(std::find(r.live.begin(), r.live.end(), metrics.get()));
+        t_metrics = nullptr;
+    }
+};
+
+#endif // BASKET_METRICS
+
+} // namespace
+
+/**
+ * @brief Nom d'un compteur dans les exports.
+ * @param counter Compteur.
+ * @return Le nom, en snake_case.
+ */
+const char* CounterName(Counter counter) {
+    return kCounterNames[static_cast<int>(counter)];
+}
+
+/**
+ * @brief Nom d'un histogramme dans les exports.
+ * @param histogram Histogramme.
+ * @return Le nom, en snake_case.
+ */
+const char* HistogramName(Histogram histogram) {
+    return kHistogramNames[static_cast<int>(histogram)];
+}
+
+#ifdef BASKET_METRICS
+
+/**
+ * @brief Crée et inscrit le bloc du thread appelant.
+ * @return Le bloc.
+ */
+ThreadMetrics& RegisterThreadMetrics() {
+    thread_local ThreadMetricsOwner owner;
+    t_metrics = owner.metrics.get();
+    return *owner.metrics;
+}
+
+/**
+ * @brief Enregistre une latence dans le seau de sa puissance de deux.
+ * @param histogram Histogramme.
+ * @param ns Durée en nanosecondes.
+ */
+void RecordLatency(Histogram histogram, std::uint64_t ns) {
+    ThreadMetrics& metrics = LocalMetrics();
+    const int h = static_cast<int>(histogram);
+    const int b = std::min(static_cast<int>(std::bit_width(ns)), kLatencyBuckets - 1);
+    std::atomic<std::uint64_t>& bucket = metrics.buckets[h][b];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    metrics.sum[h].store(metrics.sum[h].load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Horloge monotone en nanosecondes.
+ */
+std::uint64_t LatencyTimer::Now() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/**
+ * @brief Fusionne les blocs des threads vivants au cumul des threads terminés.
+ * @return Les valeurs fusionnées.
+ */
+MetricsSnapshot ScrapeMetrics() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    MetricsSnapshot snapshot = r.retired;
+    for (const ThreadMetrics* metrics : r.live) {
+        accumulate(snapshot, *metrics);
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Remet toutes les valeurs à zéro.
+ */
+void ResetMetrics() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired = MetricsSnapshot();
+    for (ThreadMetrics* metrics : r.live) {
+        for (auto& value : metrics->counters) {
+            value.store(0, std::memory_order_relaxed);
+        }
+        for (auto& buckets : metrics->buckets) {
+            for (auto& value : buckets) {
+                value.store(0, std::memory_order_relaxed);
+            }
+        }
+        for (auto& value : metrics->sum) {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+#else
+
+/**
+ * @brief Sans BASKET_METRICS, rien n'est mesuré.
+ * @return Des valeurs nulles.
+ */
+MetricsSnapshot ScrapeMetrics() {
+    return MetricsSnapshot();
+}
+
+/**
+ * @brief Sans BASKET_METRICS, rien à remettre à zéro.
+ */
+void ResetMetrics() {}
+
+#endif // BASKET_METRICS
+
+/**
+ * @brief Écrit des valeurs au format texte Prometheus.
+ *
+ * Les compteurs deviennent basket_<nom>_total ; les histogrammes ont des seaux cumulés
+ * de bornes 2^b - 1 nanosecondes, plus _sum et _count.
+ *
+ * @param snapshot Valeurs.
+ * @param out Flux de sortie.
+ */
+void WriteMetricsPrometheus(const MetricsSnapshot& snapshot, std::ostream& out) {
+    for (int c = 0; c < kCounters; ++c) {
+        out << "# TYPE basket_" << kCounterNames[c] << "_total counter\n"
+            << "basket_" << kCounterNames[c] << "_total " << snapshot.counters[c] << '\n';
+    }
+    for (int h = 0; h < kHistograms; ++h) {
+        const char* name = kHistogramNames[h];
+        out << "# TYPE basket_" << name << " histogram\n";
+        std::uint64_t cumulative = 0;
+        for (int b = 0; b < kLatencyBuckets - 1; ++b) {
+            cumulative += snapshot.buckets[h][b];
+            out << "basket_" << name << "_bucket{le=\"" << bucket_bound(b) << "\"} " << cumulative << '\n';
+        }
+        out << "basket_" << name << "_bucket{le=\"+Inf\"} " << snapshot.count[h] << '\n'
+            << "basket_" << name << "_sum " << snapshot.sum[h] << '\n'
+            << "basket_" << name << "_count " << snapshot.count[h] << '\n';
+    }
+}
+
+/**
+ * @brief Écrit des valeurs en JSON.
+ *
+ * {"counters": {nom: valeur}, "histograms": {nom: {"bounds", "buckets", "sum", "count"}}},
+ * les seaux n'étant pas cumulés.
+ *
+ * @param snapshot Valeurs.
+ * @param out Flux de sortie.
+ */
+void WriteMetricsJson(const MetricsSnapshot& snapshot, std::ostream& out) {
+    out << "{\"counters\":{";
+    for (int c = 0; c < kCounters; ++c) {
+        out << (c ? "," : "") << '"' << kCounterNames[c] << "\":" << snapshot.counters[c];
+    }
+    out << "},\"histograms\":{";
+    for (int h = 0; h < kHistograms; ++h) {
+        out << (h ? "," : "") << '"' << kHistogramNames[h] << "\":{\"bounds\":[";
+        for (int b = 0; b < kLatencyBuckets - 1; ++b) {
+            out << (b ? "," : "") << bucket_bound(b);
+        }
+        out << "],\"buckets\":[";
+        for (int b = 0; b < kLatencyBuckets; ++b) {
+            out << (b ? "," : "") << snapshot.buckets[h][b];
+        }
+        out << "],\"sum\":" << snapshot.sum[h] << ",\"count\":" << snapshot.count[h] << '}';
+    }
+    out << "}}\n";
+}
+
+/**
+ * @brief Fusionne les valeurs et les écrit dans un fichier local.
+ * @param path Chemin du fichier.
+ * @param format Format d'export.
+ * @return False si le fichier n'a pas pu être écrit.
+ */
+bool DumpMetrics(const std::string& path, MetricsFormat format) {
+    const MetricsSnapshot snapshot = ScrapeMetrics();
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        if (format == MetricsFormat::Json) {
+            WriteMetricsJson(snapshot, out);
+        } else {
+            WriteMetricsPrometheus(snapshot, out);
+        }
+        out.flush();
+        if (!out) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
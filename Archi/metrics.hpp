@@ -0,0 +1,232 @@
+/**
+ * @file metrics.hpp
+ * @brief Compteurs et histogrammes de latence par thread autour des chemins critiques de la simulation.
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Compteurs d'événements.
+ */
+enum class Counter : int {
+    Ticks, ///< Ticks de match exécutés.
+    NeighbourSearches, ///< Listes de voisins (coéquipiers ou adversaires d'un joueur) recalculées, partout.
+    NeighbourRepairs, ///< Listes de voisins dont l'ordre a changé.
+    PassesCompleted, ///< Passes réussies en match (évaluateur de passes ou coéquipier le plus proche).
+    PassesFailed, ///< Passes impossibles en match, faute de receveur.
+    ShotsTaken, ///< Tirs tentés.
+    ShotsMade, ///< Tirs réussis.
+    ObserverCalls, ///< Appels d'observateurs (registre et arbitres).
+    Count ///< Nombre de compteurs.
+};
+
+/**
+ * @brief Histogrammes de latence, en nanosecondes.
+ */
+enum class Histogram : int {
+    TickNs, ///< Durée d'un tick de match (échantillonnée).
+    DispatchNs, ///< Durée d'une diffusion aux observateurs (échantillonnée).
+    Count ///< Nombre d'histogrammes.
+};
+
+constexpr int kCounters = static_cast<int>(Counter::Count); ///< Nombre de compteurs.
+constexpr int kHistograms = static_cast<int>(Histogram::Count); ///< Nombre d'histogrammes.
+constexpr int kLatencyBuckets = 32; ///< Seaux d'un histogramme : le seau b compte les valeurs de [2^(b-1), 2^b).
+constexpr unsigned kLatencySampling = 16; ///< Un chronométrage sur kLatencySampling est enregistré.
+
+/**
+ * @brief Valeurs fusionnées de tous les threads.
+ */
+struct MetricsSnapshot {
+    std::uint64_t counters[kCounters] = {}; ///< Compteurs.
+    std::uint64_t buckets[kHistograms][kLatencyBuckets] = {}; ///< Seaux des histogrammes.
+    std::uint64_t sum[kHistograms] = {}; ///< Somme des valeurs enregistrées.
+    std::uint64_t count[kHistograms] = {}; ///< Nombre de valeurs enregistrées.
+
+    std::uint64_t operator[](Counter c) const { return counters[static_cast<int>(c)]; } ///< Valeur d'un compteur.
+};
+
+/**
+ * @brief Format d'export.
+ */
+enum class MetricsFormat {
+    Prometheus, ///< Format texte d'exposition Prometheus.
+    Json ///< Objet JSON.
+};
+
+/**
+ * @brief Nom d'un compteur dans les exports.
+ * @param counter Compteur.
+ * @return Le nom, en snake_case.
+ */
+const char* CounterName(Counter counter);
+
+/**
+ * @brief Nom d'un histogramme dans les exports.
+ * @param histogram Histogramme.
+ * @return Le nom, en snake_case.
+ */
+const char* HistogramName(Histogram histogram);
+
+/**
+ * @brief Fusionne les valeurs de tous les threads, vivants ou terminés.
+ *
+ * Seule opération qui parcourt les blocs des threads ; elle peut être appelée pendant la simulation.
+ *
+ * @return Les valeurs fusionnées (toutes nulles sans BASKET_METRICS).
+ */
+MetricsSnapshot ScrapeMetrics();
+
+/**
+ * @brief Remet toutes les valeurs à zéro.
+ *
+ * À appeler quand aucun thread ne mesure : une mesure concurrente peut être perdue ou conservée.
+ */
+void ResetMetrics();
+
+/**
+ * @brief Écrit des valeurs au format texte Prometheus.
+ * @param snapshot Valeurs.
+ * @param out Flux de sortie.
+ */
+void WriteMetricsPrometheus(const MetricsSnapshot& snapshot, std::ostream& out);
+
+/**
+ * @brief Écrit des valeurs en JSON.
+ * @param snapshot Valeurs.
+ * @param out Flux de sortie.
+ */
+void WriteMetricsJson(const MetricsSnapshot& snapshot, std::ostream& out);
+
+/**
+ * @brief Fusionne les valeurs et les écrit dans un fichier local.
+ *
+ * Le fichier est écrit à côté puis renommé : un lecteur ne voit jamais un export partiel.
+ *
+ * @param path Chemin du fichier.
+ * @param format Format d'export.
+ * @return False si le fichier n'a pas pu être écrit.
+ */
+bool DumpMetrics(const std::string& path, MetricsFormat format);
+
+#ifdef BASKET_METRICS
+
+/**
+ * @brief Bloc de mesures d'un thread.
+ *
+ * Seul son thread écrit ; ScrapeMetrics() lit en concurrence. Les valeurs sont atomiques
+ * mais modifiées par chargement puis écriture relâchés : aucun préfixe lock sur le
+ * chemin critique.
+ */
+struct alignas(64) ThreadMetrics {
+    std::atomic<std::uint64_t> counters[kCounters] = {}; ///< Compteurs.
+    std::atomic<std::uint64_t> buckets[kHistograms][kLatencyBuckets] = {}; ///< Seaux des histogrammes.
+    std::atomic<std::uint64_t> sum[kHistograms] = {}; ///< Sommes.
+    unsigned sampling = 0; ///< Décompte de l'échantillonnage des chronométrages.
+};
+
+/**
+ * @brief Crée et inscrit le bloc du thread appelant (premier appel du thread).
+ * @return Le bloc.
+ */
+ThreadMetrics& RegisterThreadMetrics();
+
+inline thread_local ThreadMetrics* t_metrics = nullptr; ///< Bloc du thread, nul avant la première mesure.
+
+/**
+ * @brief Bloc du thread appelant.
+ * @return Le bloc.
+ */
+inline ThreadMetrics& LocalMetrics() {
+    ThreadMetrics* metrics = t_metrics;
+    return metrics ? *metrics : RegisterThreadMetrics();
+}
+
+/**
+ * @brief Ajoute à un compteur.
+ * @param counter Compteur.
+ * @param n Valeur ajoutée.
+ */
+inline void CountMetric(Counter counter, std::uint64_t n = 1) {
+    std::atomic<std::uint64_t>& value = LocalMetrics().counters[static_cast<int>(counter)];
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enregistre une latence.
+ * @param histogram Histogramme.
+ * @param ns Durée en nanosecondes.
+ */
+void RecordLatency(Histogram histogram, std::uint64_t ns);
+
+/**
+ * @brief Chronomètre une portée, une fois sur kLatencySampling par thread.
+ *
+ * Les portées non échantillonnées ne lisent pas l'horloge.
+ */
+class LatencyTimer {
+public:
+    /**
+     * @brief Démarre le chronométrage si la portée est échantillonnée.
+     * @param histogram Histogramme destinataire.
+     */
+    explicit LatencyTimer(Histogram histogram) : histogram(histogram) {
+        ThreadMetrics& metrics = LocalMetrics();
+        if (++metrics.sampling >= kLatencySampling) {
+            metrics.sampling = 0;
+            start = Now();
+        }
+    }
+
+    /**
+     * @brief Enregistre la durée de la portée échantillonnée.
+     */
+    ~LatencyTimer() {
+        if (start) {
+            RecordLatency(histogram, Now() - start);
+        }
+    }
+
+    LatencyTimer(const LatencyTimer&) = delete; ///< Non copiable.
+    LatencyTimer& operator=(const LatencyTimer&) = delete; ///< Non copiable.
+
+private:
+    Histogram histogram; ///< Histogramme destinataire.
+    std::uint64_t start = 0; ///< Début en nanosecondes, 0 si la portée n'est pas échantillonnée.
+
+    /**
+     * @brief Horloge monotone en nanosecondes.
+     */
+    static std::uint64_t Now();
+};
+
+#else
+
+/**
+ * @brief Compteur neutralisé : sans BASKET_METRICS, les mesures disparaissent à la compilation.
+ */
+inline void CountMetric(Counter, std::uint64_t = 1) {}
+
+/**
+ * @brief Latence neutralisée.
+ */
+inline void RecordLatency(Histogram, std::uint64_t) {}
+
+/**
+ * @brief Chronomètre neutralisé.
+ */
+class LatencyTimer {
+public:
+    explicit LatencyTimer(Histogram) {}
+};
+
+#endif // BASKET_METRICS
+
+#endif // METRICS_HPP
@@ -0,0 +1,321 @@
+#include "motion_batch.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr float kMinNorm2 = 1e-12f; ///< Norme au carré minimale, évite la division par zéro.
+
+/**
+ * @brief Intègre un corps d'un paquet (repli scalaire).
+ * @param m Paquet.
+ * @param i Case du corps.
+ * @param dt Pas de temps.
+ * @param court_x Largeur du terrain.
+ * @param court_y Hauteur du terrain.
+ */
+[[maybe_unused]] void integrate_lane(MotionBlock& m, int i, float dt, float court_x, float court_y) {
+    const float a2 = std::fmax(m.ax[i] * m.ax[i] + m.ay[i] * m.ay[i], kMinNorm2);
+    const float as = std::fmin(1.f, m.max_accel[i] / std::sqrt(a2));
+    float vx = m.vx[i] + m.ax[i] * as * dt;
+    float vy = m.vy[i] + m.ay[i] * as * dt;
+
+    const float v2 = std::fmax(vx * vx + vy * vy, kMinNorm2);
+    const float vs = std::fmin(1.f, m.max_speed[i] / std::sqrt(v2));
+    vx *= vs;
+    vy *= vs;
+
+    const float x = m.x[i] + vx * dt;
+    const float y = m.y[i] + vy * dt;
+    m.x[i] = std::fmin(std::fmax(x, 0.f), court_x);
+    m.y[i] = std::fmin(std::fmax(y, 0.f), court_y);
+    m.vx[i] = m.x[i] == x ? vx : 0.f;
+    m.vy[i] = m.y[i] == y ? vy : 0.f;
+}
+
+} // namespace
+
+/**
+ * @brief Intègre un pas de temps pour une série de paquets.
+ * @param blocks Paquets à intégrer.
+ * @param count Nombre de paquets.
+ * @param dt Pas de temps en secondes.
+ * @param court_x Largeur du terrain.
+ * @param court_y Hauteur du terrain.
+ */
+void integrate_motion(MotionBlock* blocks, std::size_t count, float dt, float court_x, float court_y) {
+#if defined(__AVX512F__)
+    const __m512 dt16 = _mm512_set1_ps(dt);
+    const __m512 zero16 = _mm512_setzero_ps();
+    const __m512 one16 = _mm512_set1_ps(1.f);
+    const __m512 tiny16 = _mm512_set1_ps(kMinNorm2);
+    const __m512 cx16 = _mm512_set1_ps(court_x);
+    const __m512 cy16 = _mm512_set1_ps(court_y);
+    for (std::size_t b = 0; b < count; ++b) {
+        MotionBlock& m = blocks[b];
+        const __m512 ax = _mm512_load_ps(m.ax);
+        const __m512 ay = _mm512_load_ps(m.ay);
+        const __m512 a2 = _mm512_max_ps(_mm512_add_ps(_mm512_mul_ps(ax, ax), _mm512_mul_ps(ay, ay)), tiny16);
+        const __m512 as = _mm512_mul_ps(
+            _mm512_min_ps(one16, _mm512_div_ps(_mm512_load_ps(m.max_accel), _mm512_sqrt_ps(a2))), dt16);
+        __m512 vx = _mm512_add_ps(_mm512_load_ps(m.vx), _mm512_mul_ps(ax, as));
+        __m512 vy = _mm512_add_ps(_mm512_load_ps(m.vy), _mm512_mul_ps(ay, as));
+
+        const __m512 v2 = _mm512_max_ps(_mm512_add_ps(_mm512_mul_ps(vx, vx), _mm512_mul_ps(vy, vy)), tiny16);
+        const __m512 vs = _mm512_min_ps(one16, _mm512_div_ps(_mm512_load_ps(m.max_speed), _mm512_sqrt_ps(v2)));
+        vx = _mm512_mul_ps(vx, vs);
+        vy = _mm512_mul_ps(vy, vs);
+
+        const __m512 x = _mm512_add_ps(_mm512_load_ps(m.x), _mm512_mul_ps(vx, dt16));
+        const __m512 y = _mm512_add_ps(_mm512_load_ps(m.y), _mm512_mul_ps(vy, dt16));
+        const __m512 bx = _mm512_min_ps(_mm512_max_ps(x, zero16), cx16);
+        const __m512 by = _mm512_min_ps(_mm512_max_ps(y, zero16), cy16);
+        _mm512_store_ps(m.x, bx);
+        _mm512_store_ps(m.y, by);
+        _mm512_store_ps(m.vx, _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(bx, x, _CMP_EQ_OQ), vx));
+        _mm512_store_ps(m.vy, _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(by, y, _CMP_EQ_OQ), vy));
+    }
+#elif defined(__AVX__)
+    const __m256 dt8 = _mm256_set1_ps(dt);
+    const __m256 zero8 = _mm256_setzero_ps();
+    const __m256 one8 = _mm256_set1_ps(1.f);
+    const __m256 tiny8 = _mm256_set1_ps(kMinNorm2);
+    const __m256 cx8 = _mm256_set1_ps(court_x);
+    const __m256 cy8 = _mm256_set1_ps(court_y);
+    for (std::size_t b = 0; b < count; ++b) {
+        MotionBlock& m = blocks[b];
+        for (int o = 0; o < MotionBlock::kLanes; o += 8) {
+            const __m256 ax = _mm256_load_ps(m.ax + o);
+            const __m256 ay = _mm256_load_ps(m.ay + o);
+            const __m256 a2 = _mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(ax, ax), _mm256_mul_ps(ay, ay)), tiny8);
+            const __m256 as = _mm256_mul_ps(
+                _mm256_min_ps(one8, _mm256_div_ps(_mm256_load_ps(m.max_accel + o), _mm256_sqrt_ps(a2))), dt8);
+            __m256 vx = _mm256_add_ps(_mm256_load_ps(m.vx + o), _mm256_mul_ps(ax, as));
+            __m256 vy = _mm256_add_ps(_mm256_load_ps(m.vy + o), _mm256_mul_ps(ay, as));
+
+            const __m256 v2 = _mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), tiny8);
+            const __m256 vs =
+                _mm256_min_ps(one8, _mm256_div_ps(_mm256_load_ps(m.max_speed + o), _mm256_sqrt_ps(v2)));
+            vx = _mm256_mul_ps(vx, vs);
+            vy = _mm256_mul_ps(vy, vs);
+
+            const __m256 x = _mm256_add_ps(_mm256_load_ps(m.x + o), _mm256_mul_ps(vx, dt8));
+            const __m256 y = _mm256_add_ps(_mm256_load_ps(m.y + o), _mm256_mul_ps(vy, dt8));
+            const __m256 bx = _mm256_min_ps(_mm256_max_ps(x, zero8), cx8);
+            const __m256 by = _mm256_min_ps(_mm256_max_ps(y, zero8), cy8);
+            _mm256_store_ps(m.x + o, bx);
+            _mm256_store_ps(m.y + o, by);
+            _mm256_store_ps(m.vx + o, _mm256_and_ps(_mm256_cmp_ps(bx, x, _CMP_EQ_OQ), vx));
+            _mm256_store_ps(m.vy + o, _mm256_and_ps(_mm256_cmp_ps(by, y, _CMP_EQ_OQ), vy));
+        }
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 dt4 = _mm_set1_ps(dt);
+    const __m128 zero4 = _mm_setzero_ps();
+    const __m128 one4 = _mm_set1_ps(1.f);
+    const __m128 tiny4 = _mm_set1_ps(kMinNorm2);
+    const __m128 cx4 = _mm_set1_ps(court_x);
+    const __m128 cy4 = _mm_set1_ps(court_y);
+    for (std::size_t b = 0; b < count; ++b) {
+        MotionBlock& m = blocks[b];
+        for (int o = 0; o < MotionBlock::kLanes; o += 4) {
+            const __m128 ax = _mm_load_ps(m.ax + o);
+            const __m128 ay = _mm_load_ps(m.ay + o);
+            const __m128 a2 = _mm_max_ps(_mm_add_ps(_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), tiny4);
+            const __m128 as =
+                _mm_mul_ps(_mm_min_ps(one4, _mm_div_ps(_mm_load_ps(m.max_accel + o), _mm_sqrt_ps(a2))), dt4);
+            __m128 vx = _mm_add_ps(_mm_load_ps(m.vx + o), _mm_mul_ps(ax, as));
+            __m128 vy = _mm_add_ps(_mm_load_ps(m.vy + o), _mm_mul_ps(ay, as));
+
+            const __m128 v2 = _mm_max_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), tiny4);
+            const __m128 vs = _mm_min_ps(one4, _mm_div_ps(_mm_load_ps(m.max_speed + o), _mm_sqrt_ps(v2)));
+            vx = _mm_mul_ps(vx, vs);
+            vy = _mm_mul_ps(vy, vs);
+
+            const __m128 x = _mm_add_ps(_mm_load_ps(m.x + o), _mm_mul_ps(vx, dt4));
+            const __m128 y = _mm_add_ps(_mm_load_ps(m.y + o), _mm_mul_ps(vy, dt4));
+            const __m128 bx = _mm_min_ps(_mm_max_ps(x, zero4), cx4);
+            const __m128 by = _mm_min_ps(_mm_max_ps(y, zero4), cy4);
+            _mm_store_ps(m.x + o, bx);
+            _mm_store_ps(m.y + o, by);
+            _mm_store_ps(m.vx + o, _mm_and_ps(_mm_cmpeq_ps(bx, x), vx));
+            _mm_store_ps(m.vy + o, _mm_and_ps(_mm_cmpeq_ps(by, y), vy));
+        }
+    }
+#else
+    for (std::size_t b = 0; b < count; ++b) {
+        for (int i = 0; i < MotionBlock::kLanes; ++i) {
+            integrate_lane(blocks[b], i, dt, court_x, court_y);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Constructeur.
+ * @param games Nombre de matchs.
+ * @param limits Limites physiques.
+ */
+template <class Rules>
+BasicMotionBatch<Rules>::BasicMotionBatch(std::size_t games, const MotionLimits& limits) : limits(limits) {
+    Resize(games);
+}
+
+/**
+ * @brief Change le nombre de matchs.
+ *
+ * Les cases au-delà du dernier corps gardent des limites nulles et restent immobiles.
+ *
+ * @param count Nombre de matchs.
+ */
+template <class Rules>
+void BasicMotionBatch<Rules>::Resize(std::size_t count) {
+    const std::size_t first = std::min(Bodies(), count * kBodies);
+    games = count;
+    blocks.resize((Bodies() + MotionBlock::kLanes - 1) / MotionBlock::kLanes, MotionBlock{});
+    for (std::size_t body = first; body < blocks.size() * MotionBlock::kLanes; ++body) {
+        MotionBlock& m = blocks[body / MotionBlock::kLanes];
+        const int lane = static_cast<int>(body % MotionBlock::kLanes);
+        const bool used = body < Bodies();
+        const bool is_ball = body % kBodies == kBall;
+        m.x[lane] = m.y[lane] = m.vx[lane] = m.vy[lane] = m.ax[lane] = m.ay[lane] = 0.f;
+        m.max_speed[lane] = used ? (is_ball ? limits.ball_speed : limits.player_speed) : 0.f;
+        m.max_accel[lane] = used ? (is_ball ? limits.ball_accel : limits.player_accel) : 0.f;
+    }
+}
+
+/**
+ * @brief Avance tous les matchs d'un pas de temps.
+ * @param dt Pas de temps en secondes.
+ */
+template <class Rules>
+void BasicMotionBatch<Rules>::Step(float dt) {
+    integrate_motion(blocks.data(), blocks.size(), dt, Rules::court_x, Rules::court_y);
+}
+
+/**
+ * @brief Paquet et case d'un corps.
+ * @param game Indice du match.
+ * @param body Indice du corps.
+ * @param lane Reçoit la case dans le paquet.
+ * @return Le paquet.
+ */
+template <class Rules>
+MotionBlock& BasicMotionBatch<Rules>::BlockOf(std::size_t game, int body, int& lane) {
+    const std::size_t index = game * kBodies + body;
+    lane = static_cast<int>(index % MotionBlock::kLanes);
+    return blocks[index / MotionBlock::kLanes];
+}
+
+/**
+ * @brief Paquet et case d'un corps.
+ * @param game Indice du match.
+ * @param body Indice du corps.
+ * @param lane Reçoit la case dans le paquet.
+ * @return Le paquet.
+ */
+template <class Rules>
+const MotionBlock& BasicMotionBatch<Rules>::BlockOf(std::size_t game, int body, int& lane) const {
+    const std::size_t index = game * kBodies + body;
+    lane = static_cast<int>(index % MotionBlock::kLanes);
+    return blocks[index / MotionBlock::kLanes];
+}
+
+/**
+ * @brief Place un corps.
+ * @param game Indice du match.
+ * @param body Indice du corps.
+ * @param position Position.
+ * @param vx Vitesse X.
+ * @param vy Vitesse Y.
+ */
+template <class Rules>
+void BasicMotionBatch<Rules>::SetBody(std::size_t game, int body, const Position& position, float vx, float vy) {
+    int lane;
+    MotionBlock& m = BlockOf(game, body, lane);
+    m.x[lane] = position.x;
+    m.y[lane] = position.y;
+    m.vx[lane] = vx;
+    m.vy[lane] = vy;
+}
+
+/**
+ * @brief Fixe l'accélération demandée pour un corps.
+ * @param game Indice du match.
+ * @param body Indice du corps.
+ * @param ax Accélération X.
+ * @param ay Accélération Y.
+ */
+template <class Rules>
+void BasicMotionBatch<Rules>::SetAcceleration(std::size_t game, int body, float ax, float ay) {
+    int lane;
+    MotionBlock& m = BlockOf(game, body, lane);
+    m.ax[lane] = ax;
+    m.ay[lane] = ay;
+}
+
+/**
+ * @brief Position d'un corps.
+ * @param game Indice du match.
+ * @param body Indice du corps.
+ * @return La position.
+ */
+template <class Rules>
+Position BasicMotionBatch<Rules>::GetPosition(std::size_t game, int body) const {
+    int lane;
+    const MotionBlock& m = BlockOf(game, body, lane);
+    return Position{m.x[lane], m.y[lane]};
+}
+
+/**
+ * @brief Vitesse d'un corps.
+ * @param game Indice du match.
+ * @param body Indice du corps.
+ * @return La vitesse.
+ */
+template <class Rules>
+Position BasicMotionBatch<Rules>::GetVelocity(std::size_t game, int body) const {
+    int lane;
+    const MotionBlock& m = BlockOf(game, body, lane);
+    return Position{m.vx[lane], m.vy[lane]};
+}
+
+/**
+ * @brief Copie les positions des joueurs et du ballon d'un match et annule leurs vitesses.
+ * @param game Indice du match.
+ * @param players Joueurs.
+ * @param ball Ballon.
+ */
+template <class Rules>
+void BasicMotionBatch<Rules>::Load(std::size_t game, const std::vector<PlayerType>& players, const BallonType& ball) {
+    for (int i = 0; i < Rules::players; ++i) {
+        SetBody(game, i, players[i].position);
+        SetAcceleration(game, i, 0.f, 0.f);
+    }
+    SetBody(game, kBall, ball.position);
+    SetAcceleration(game, kBall, 0.f, 0.f);
+}
+
+/**
+ * @brief Recopie les positions intégrées dans les joueurs et le ballon d'un match.
+ * @param game Indice du match.
+ * @param players Joueurs.
+ * @param ball Ballon.
+ */
+template <class Rules>
+void BasicMotionBatch<Rules>::Store(std::size_t game, std::vector<PlayerType>& players, BallonType& ball) const {
+    for (int i = 0; i < Rules::players; ++i) {
+        players[i].position = GetPosition(game, i);
+    }
+    ball.position = GetPosition(game, kBall);
+}
+
+template class BasicMotionBatch<Rules5x5>;
+template class BasicMotionBatch<Rules3x3>;
+template class BasicMotionBatch<RulesDrill2x2>;
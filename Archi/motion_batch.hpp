@@ -0,0 +1,172 @@
+/**
+ * @file motion_batch.hpp
+ * @brief Intégration vectorisée des déplacements de milliers de matchs (disposition AoSoA).
+ */
+
+#ifndef MOTION_BATCH_HPP
+#define MOTION_BATCH_HPP
+
+#include "basket.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Paquet de 16 corps (joueurs ou ballons) rangés composante par composante.
+ *
+ * Seize flottants occupent une ligne de cache de 64 octets : un registre AVX-512,
+ * deux registres AVX ou quatre registres SSE par champ.
+ */
+struct alignas(64) MotionBlock {
+    static constexpr int kLanes = 16; ///< Corps par paquet.
+
+    float x[kLanes]; ///< Positions X.
+    float y[kLanes]; ///< Positions Y.
+    float vx[kLanes]; ///< Vitesses X (unités par seconde).
+    float vy[kLanes]; ///< Vitesses Y (unités par seconde).
+    float ax[kLanes]; ///< Accélérations X demandées.
+    float ay[kLanes]; ///< Accélérations Y demandées.
+    float max_speed[kLanes]; ///< Norme maximale de la vitesse.
+    float max_accel[kLanes]; ///< Norme maximale de l'accélération.
+};
+
+/**
+ * @brief Intègre un pas de temps pour une série de paquets.
+ *
+ * Pour chaque corps : l'accélération demandée est ramenée à max_accel, la vitesse est
+ * intégrée puis ramenée à max_speed, la position est intégrée puis bornée au rectangle
+ * [0, court_x] × [0, court_y] ; la composante de vitesse qui pousse contre un bord est
+ * annulée. Noyau AVX-512 (16 corps), AVX (2 × 8) ou SSE2 (4 × 4), avec repli scalaire.
+ * Un corps de max_speed et max_accel nuls ne bouge pas (cases de remplissage).
+ *
+ * @param blocks Paquets à intégrer.
+ * @param count Nombre de paquets.
+ * @param dt Pas de temps en secondes.
+ * @param court_x Largeur du terrain.
+ * @param court_y Hauteur du terrain.
+ */
+void integrate_motion(MotionBlock* blocks, std::size_t count, float dt, float court_x, float court_y);
+
+/**
+ * @brief Limites physiques des joueurs et du ballon.
+ */
+struct MotionLimits {
+    float player_speed = 6.f; ///< Vitesse maximale d'un joueur (unités par seconde).
+    float player_accel = 20.f; ///< Accélération maximale d'un joueur.
+    float ball_speed = 20.f; ///< Vitesse maximale du ballon.
+    float ball_accel = 200.f; ///< Accélération maximale du ballon.
+};
+
+/**
+ * @brief Corps de plusieurs matchs simultanés, intégrés ensemble.
+ *
+ * Chaque match compte Rules::players joueurs suivis du ballon ; le corps `body` du
+ * match `game` est la case (game * kBodies + body) de la suite des paquets, sans
+ * remplissage entre matchs. Les pilotes écrivent les accélérations voulues puis
+ * appellent Step() une fois par tick pour tous les matchs.
+ *
+ * @tparam Rules Règles de la variante de jeu (effectif et dimensions du terrain).
+ */
+template <class Rules>
+class BasicMotionBatch {
+public:
+    using PlayerType = BasicPlayer<Rules>; ///< Type des joueurs.
+    using BallonType = BasicBallon<Rules>; ///< Type du ballon.
+
+    static constexpr int kBodies = Rules::players + 1; ///< Corps par match : les joueurs puis le ballon.
+    static constexpr int kBall = Rules::players; ///< Indice du ballon dans un match.
+
+    /**
+     * @brief Constructeur.
+     * @param games Nombre de matchs.
+     * @param limits Limites physiques.
+     */
+    explicit BasicMotionBatch(std::size_t games = 0, const MotionLimits& limits = MotionLimits());
+
+    /**
+     * @brief Change le nombre de matchs ; les nouveaux corps sont immobiles à l'origine.
+     * @param games Nombre de matchs.
+     */
+    void Resize(std::size_t games);
+
+    /**
+     * @brief Avance tous les matchs d'un pas de temps.
+     * @param dt Pas de temps en secondes.
+     */
+    void Step(float dt);
+
+    /**
+     * @brief Copie les positions des joueurs et du ballon d'un match et annule leurs vitesses.
+     * @param game Indice du match.
+     * @param players Joueurs, dans l'ordre de leur numéro.
+     * @param ball Ballon.
+     */
+    void Load(std::size_t game, const std::vector<PlayerType>& players, const BallonType& ball);
+
+    /**
+     * @brief Recopie les positions intégrées dans les joueurs et le ballon d'un match.
+     * @param game Indice du match.
+     * @param players Joueurs, dans l'ordre de leur numéro.
+     * @param ball Ballon.
+     */
+    void Store(std::size_t game, std::vector<PlayerType>& players, BallonType& ball) const;
+
+    /**
+     * @brief Place un corps.
+     * @param game Indice du match.
+     * @param body Indice du corps (kBall pour le ballon).
+     * @param position Position.
+     * @param vx Vitesse X.
+     * @param vy Vitesse Y.
+     */
+    void SetBody(std::size_t game, int body, const Position& position, float vx = 0.f, float vy = 0.f);
+
+    /**
+     * @brief Fixe l'accélération demandée pour un corps.
+     * @param game Indice du match.
+     * @param body Indice du corps.
+     * @param ax Accélération X.
+     * @param ay Accélération Y.
+     */
+    void SetAcceleration(std::size_t game, int body, float ax, float ay);
+
+    /**
+     * @brief Position d'un corps.
+     * @param game Indice du match.
+     * @param body Indice du corps.
+     * @return La position.
+     */
+    Position GetPosition(std::size_t game, int body) const;
+
+    /**
+     * @brief Vitesse d'un corps.
+     * @param game Indice du match.
+     * @param body Indice du corps.
+     * @return La vitesse, rangée dans une Position.
+     */
+    Position GetVelocity(std::size_t game, int body) const;
+
+    std::size_t Games() const { return games; } ///< Nombre de matchs.
+    std::size_t Bodies() const { return games * kBodies; } ///< Nombre de corps intégrés.
+    MotionBlock* Blocks() { return blocks.data(); } ///< Paquets, pour les pilotes vectorisés.
+    std::size_t BlockCount() const { return blocks.size(); } ///< Nombre de paquets.
+    const MotionLimits& Limits() const { return limits; } ///< Limites physiques.
+
+private:
+    MotionLimits limits; ///< Limites physiques.
+    std::size_t games = 0; ///< Nombre de matchs.
+    std::vector<MotionBlock> blocks; ///< Corps de tous les matchs.
+
+    /**
+     * @brief Paquet et case d'un corps.
+     */
+    MotionBlock& BlockOf(std::size_t game, int body, int& lane);
+    const MotionBlock& BlockOf(std::size_t game, int body, int& lane) const;
+};
+
+extern template class BasicMotionBatch<Rules5x5>;
+extern template class BasicMotionBatch<Rules3x3>;
+extern template class BasicMotionBatch<RulesDrill2x2>;
+
+using MotionBatch = BasicMotionBatch<Rules5x5>; ///< Déplacements de matchs à cinq contre cinq.
+
+#endif // MOTION_BATCH_HPP
@@ -0,0 +1,158 @@
+#include "neighbour_tracker.hpp"
+#include "metrics.hpp"
+#include <cfloat>
+
+/**
+ * @brief Recalcule les distances, réordonne et renouvelle la marge.
+ *
+ * La liste est presque toujours déjà triée : le tri par insertion est alors linéaire.
+ *
+ * @param xs Coordonnées X de l'effectif.
+ * @param ys Coordonnées Y de l'effectif.
+ * @param x Coordonnée X du joueur.
+ * @param y Coordonnée Y du joueur.
+ * @return True si l'ordre a changé.
+ */
+template <class Rules>
+template <int N>
+bool BasicNeighbourTracker<Rules>::SortedList<N>::Refresh(const float* xs, const float* ys, float x, float y) {
+    unrolled<N>([&](auto k) {
+        const float dx = xs[index[k]] - x;
+        const float dy = ys[index[k]] - y;
+        dist[k] = std::sqrt(dx * dx + dy * dy);
+    });
+
+    bool changed = false;
+    for (int k = 1; k < N; ++k) {
+        const float d = dist[k];
+        const int idx = index[k];
+        int pos = k;
+        while (pos > 0 && d < dist[pos - 1]) {
+            dist[pos] = dist[pos - 1];
+            index[pos] = index[pos - 1];
+            --pos;
+        }
+        if (pos != k) {
+            dist[pos] = d;
+            index[pos] = idx;
+            changed = true;
+        }
+    }
+
+    float gap = FLT_MAX;
+    for (int k = 1; k < N; ++k) {
+        gap = std::fmin(gap, dist[k] - dist[k - 1]);
+    }
+    slack = N > 1 ? 0.5f * gap : FLT_MAX;
+    return changed;
+}
+
+/**
+ * @brief Recopie une liste dans la table de pointeurs correspondante.
+ * @param list Liste triée.
+ * @param table Table `Teammates` ou `Opponents` du joueur.
+ * @param players Effectif suivi.
+ */
+template <class Rules>
+template <int N>
+void BasicNeighbourTracker<Rules>::Publish(const SortedList<N>& list, PlayerType* (&table)[N],
+                                           std::vector<PlayerType>& players) {
+    unrolled<N>([&](auto k) { table[k] = &players[list.index[k]]; });
+}
+
+/**
+ * @brief Reconstruit toutes les listes et remplit les tables de voisins de tous les joueurs.
+ * @param players Effectif complet ; les tables pointent dans ce vecteur.
+ */
+template <class Rules>
+void BasicNeighbourTracker<Rules>::Reset(std::vector<PlayerType>& players) {
+    base = players.data();
+    count = players.size();
+    last_repairs = last_checks = 0;
+    total_repairs = total_checks = 0;
+    if (count != static_cast<std::size_t>(kPlayers)) {
+        return;
+    }
+
+    for (int i = 0; i < kPlayers; ++i) {
+        xs[i] = players[i].position.x;
+        ys[i] = players[i].position.y;
+    }
+    for (int i = 0; i < kPlayers; ++i) {
+        const int team = Rules::team_of(players[i].number);
+        int m = 0;
+        int o = 0;
+        for (int j = 0; j < kPlayers; ++j) {
+            if (Rules::team_of(players[j].number) != team) {
+                opps[i].index[o++] = j;
+            } else if (j != i) {
+                mates[i].index[m++] = j;
+            }
+        }
+        mates[i].Refresh(xs, ys, xs[i], ys[i]);
+        opps[i].Refresh(xs, ys, xs[i], ys[i]);
+        Publish(mates[i], players[i].Teammates, players);
+        Publish(opps[i], players[i].Opponents, players);
+    }
+    CountMetric(Counter::NeighbourSearches, 2 * kPlayers);
+}
+
+/**
+ * @brief Met à jour les listes après un déplacement des joueurs.
+ * @param players Effectif, dans le même ordre que lors de Reset().
+ * @return Le nombre de listes réparées pendant ce tick.
+ */
+template <class Rules>
+int BasicNeighbourTracker<Rules>::Update(std::vector<PlayerType>& players) {
+    if (players.data() != base || players.size() != count) {
+        Reset(players);
+        return last_repairs;
+    }
+    if (count != static_cast<std::size_t>(kPlayers)) {
+        return 0;
+    }
+
+    float fastest = 0.f;
+    for (int i = 0; i < kPlayers; ++i) {
+        const float x = players[i].position.x;
+        const float y = players[i].position.y;
+        const float dx = x - xs[i];
+        const float dy = y - ys[i];
+        moved[i] = std::sqrt(dx * dx + dy * dy);
+        fastest = std::fmax(fastest, moved[i]);
+        xs[i] = x;
+        ys[i] = y;
+    }
+
+    int repairs = 0;
+    int checks = 0;
+    for (int i = 0; i < kPlayers; ++i) {
+        const float spent = moved[i] + fastest;
+        if ((mates[i].slack -= spent) < 0.f) {
+            ++checks;
+            if (mates[i].Refresh(xs, ys, xs[i], ys[i])) {
+                ++repairs;
+                Publish(mates[i], players[i].Teammates, players);
+            }
+        }
+        if ((opps[i].slack -= spent) < 0.f) {
+            ++checks;
+            if (opps[i].Refresh(xs, ys, xs[i], ys[i])) {
+                ++repairs;
+                Publish(opps[i], players[i].Opponents, players);
+            }
+        }
+    }
+
+    last_repairs = repairs;
+    last_checks = checks;
+    total_repairs += repairs;
+    total_checks += checks;
+    CountMetric(Counter::NeighbourSearches, checks);
+    CountMetric(Counter::NeighbourRepairs, repairs);
+    return repairs;
+}
+
+template class BasicNeighbourTracker<Rules5x5>;
+template class BasicNeighbourTracker<Rules3x3>;
+template class BasicNeighbourTracker<RulesDrill2x2>;
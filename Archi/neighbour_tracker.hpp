@@ -0,0 +1,106 @@
+/**
+ * @file neighbour_tracker.hpp
+ * @brief Maintien incrémental (cinétique) des coéquipiers et adversaires les plus proches.
+ */
+
+#ifndef NEIGHBOUR_TRACKER_HPP
+#define NEIGHBOUR_TRACKER_HPP
+
+#include "basket.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Maintient triées les listes de voisins d'un effectif complet d'un tick à l'autre.
+ *
+ * Pour chaque joueur, les coéquipiers et les adversaires sont gardés triés par distance,
+ * avec une marge : la moitié du plus petit écart entre deux distances consécutives. Entre
+ * deux ticks, l'écart entre deux voisins a et b du joueur i ne peut diminuer de plus de
+ * 2 * m_i + m_a + m_b (m : déplacement du tick), donc de plus de 2 * (m_i + M) où M est
+ * le plus grand déplacement du tick. Chaque liste consomme m_i + M de sa marge ; tant que
+ * la marge reste positive, l'ordre est garanti sans aucun calcul de distance. Une marge
+ * épuisée déclenche une vérification : les distances de la liste sont recalculées et
+ * l'ordre réparé par tri par insertion.
+ *
+ * Le coût d'un tick est donc linéaire en nombre de joueurs, plus un terme proportionnel
+ * au mouvement réel, au lieu d'un recalcul complet quadratique.
+ *
+ * @tparam Rules Règles de la variante de jeu ; l'effectif suivi compte Rules::players joueurs.
+ */
+template <class Rules>
+class BasicNeighbourTracker {
+public:
+    using PlayerType = BasicPlayer<Rules>; ///< Type des joueurs.
+
+    static constexpr int kPlayers = Rules::players; ///< Joueurs suivis.
+
+    /**
+     * @brief Reconstruit toutes les listes et remplit les tables de voisins de tous les joueurs.
+     * @param players Effectif complet ; les tables pointent dans ce vecteur.
+     */
+    void Reset(std::vector<PlayerType>& players);
+
+    /**
+     * @brief Met à jour les listes après un déplacement des joueurs.
+     *
+     * Seules les tables `Teammates` et `Opponents` dont l'ordre a changé sont réécrites.
+     * Un effectif d'une autre taille que kPlayers, ou un vecteur déplacé, provoque un Reset().
+     *
+     * @param players Effectif, dans le même ordre que lors de Reset().
+     * @return Le nombre de listes réparées pendant ce tick.
+     */
+    int Update(std::vector<PlayerType>& players);
+
+    int Repairs() const { return last_repairs; } ///< Listes dont l'ordre a changé au dernier tick.
+    int Checks() const { return last_checks; } ///< Listes vérifiées (marge épuisée) au dernier tick.
+    std::uint64_t TotalRepairs() const { return total_repairs; } ///< Listes réparées depuis Reset().
+    std::uint64_t TotalChecks() const { return total_checks; } ///< Listes vérifiées depuis Reset().
+
+private:
+    /**
+     * @brief Liste de voisins triée par distance croissante, avec sa marge.
+     * @tparam N Taille de la liste.
+     */
+    template <int N>
+    struct SortedList {
+        int index[N]; ///< Indices des voisins.
+        float dist[N]; ///< Distances lors de la dernière vérification.
+        float slack; ///< Marge restante avant qu'une inversion devienne possible.
+
+        /**
+         * @brief Recalcule les distances, réordonne et renouvelle la marge.
+         * @param xs Coordonnées X de l'effectif.
+         * @param ys Coordonnées Y de l'effectif.
+         * @param x Coordonnée X du joueur.
+         * @param y Coordonnée Y du joueur.
+         * @return True si l'ordre a changé.
+         */
+        bool Refresh(const float* xs, const float* ys, float x, float y);
+    };
+
+    const PlayerType* base = nullptr; ///< Début du vecteur suivi (détection d'un déplacement).
+    std::size_t count = 0; ///< Taille de l'effectif suivi.
+    float xs[kPlayers]; ///< Positions X au tick courant.
+    float ys[kPlayers]; ///< Positions Y au tick courant.
+    float moved[kPlayers]; ///< Déplacement de chaque joueur pendant le tick.
+    SortedList<Rules::teammates> mates[kPlayers]; ///< Coéquipiers de chaque joueur.
+    SortedList<Rules::opponents> opps[kPlayers]; ///< Adversaires de chaque joueur.
+    int last_repairs = 0; ///< Listes réparées au dernier tick.
+    int last_checks = 0; ///< Listes vérifiées au dernier tick.
+    std::uint64_t total_repairs = 0; ///< Listes réparées depuis Reset().
+    std::uint64_t total_checks = 0; ///< Listes vérifiées depuis Reset().
+
+    /**
+     * @brief Recopie une liste dans la table de pointeurs correspondante.
+     */
+    template <int N>
+    static void Publish(const SortedList<N>& list, PlayerType* (&table)[N], std::vector<PlayerType>& players);
+};
+
+extern template class BasicNeighbourTracker<Rules5x5>;
+extern template class BasicNeighbourTracker<Rules3x3>;
+extern template class BasicNeighbourTracker<RulesDrill2x2>;
+
+using NeighbourTracker = BasicNeighbourTracker<Rules5x5>; ///< Suivi des voisins d'un match à cinq contre cinq.
+
+#endif // NEIGHBOUR_TRACKER_HPP
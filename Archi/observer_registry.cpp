@@ -0,0 +1,212 @@
+#include "observer_registry.hpp"
+#include "metrics.hpp"
+#include <bit>
+
+/**
+ * @brief Constructeur : publie un instantané vide.
+ */
+ObserverRegistry::ObserverRegistry() : current(new Snapshot()) {}
+
+/**
+ * @brief Destructeur : libère l'instantané courant et les instantanés remplacés.
+ */
+ObserverRegistry::~ObserverRegistry() {
+    delete current.load();
+    for (const Snapshot* snapshot : retired) {
+        delete snapshot;
+    }
+}
+
+/**
+ * @brief Abonne un observateur.
+ * @param observer Observateur.
+ * @param mask Types d'événements reçus.
+ * @return La poignée d'abonnement.
+ */
+Subscription ObserverRegistry::Subscribe(const std::shared_ptr<GameObserver>& observer, EventMask mask) {
+    if (!observer) {
+        return Subscription();
+    }
+    std::unique_lock<std::mutex> lock(writer);
+    std::uint32_t slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    slots[slot].observer = observer;
+    slots[slot].mask = mask & kAllEvents;
+    ++live;
+    std::vector<const Snapshot*> released = Publish();
+    const Subscription subscription{slot, slots[slot].generation};
+    lock.unlock();
+    Release(released);
+    return subscription;
+}
+
+/**
+ * @brief Désabonne une poignée.
+ * @param subscription Poignée renvoyée par Subscribe().
+ * @return False si la poignée est invalide ou périmée.
+ */
+bool ObserverRegistry::Unsubscribe(Subscription subscription) {
+    std::unique_lock<std::mutex> lock(writer);
+    if (!Live(subscription)) {
+        return false;
+    }
+    Slot& slot = slots[subscription.slot];
+    slot.observer.reset();
+    slot.mask = 0;
+    ++slot.generation;
+    free_slots.push_back(subscription.slot);
+    --live;
+    std::vector<const Snapshot*> released = Publish();
+    lock.unlock();
+    Release(released);
+    return true;
+}
+
+/**
+ * @brief Change les types d'événements reçus par un abonnement.
+ * @param subscription Poignée de l'abonnement.
+ * @param mask Nouveau masque.
+ * @return False si la poignée est invalide ou périmée.
+ */
+bool ObserverRegistry::SetMask(Subscription subscription, EventMask mask) {
+    std::unique_lock<std::mutex> lock(writer);
+    if (!Live(subscription)) {
+        return false;
+    }
+    slots[subscription.slot].mask = mask & kAllEvents;
+    std::vector<const Snapshot*> released = Publish();
+    lock.unlock();
+    Release(released);
+    return true;
+}
+
+/**
+ * @brief Vérifie qu'une poignée désigne un abonnement actif.
+ * @param subscription Poignée à vérifier.
+ * @return True si l'emplacement est occupé par la même génération.
+ */
+bool ObserverRegistry::Live(Subscription subscription) const {
+    return subscription.slot < slots.size() && slots[subscription.slot].observer &&
+           slots[subscription.slot].generation == subscription.generation;
+}
+
+/**
+ * @brief Construit et publie un nouvel instantané.
+ *
+ * L'ancien instantané est mis de côté, puis rendu à l'appelant si aucune diffusion n'est en
+ * cours ; sinon, la dernière diffusion à se terminer s'en charge (voir Notify()).
+ *
+ * @return Les instantanés à libérer par Release(), une fois writer relâché.
+ */
+std::vector<const ObserverRegistry::Snapshot*> ObserverRegistry::Publish() {
+    Snapshot* next = new Snapshot();
+    next->owners.reserve(live);
+    for (const Slot& slot : slots) {
+        if (!slot.observer) {
+            continue;
+        }
+        next->owners.push_back(slot.observer);
+        for (int type = 0; type < kEventTypes; ++type) {
+            if (slot.mask & (1u << type)) {
+                next->by_type[type].push_back(slot.observer.get());
+            }
+        }
+    }
+
+    retired.push_back(current.exchange(next));
+    pending.store(true);
+    return Reclaim();
+}
+
+/**
+ * @brief Retire les instantanés remplacés si aucune diffusion n'est en cours.
+ *
+ * Une diffusion qui commence ensuite ne peut voir que l'instantané courant.
+ *
+ * @return Les instantanés à libérer par Release(), une fois writer relâché.
+ */
+std::vector<const ObserverRegistry::Snapshot*> ObserverRegistry::Reclaim() const {
+    std::vector<const Snapshot*> released;
+    if (readers.load() != 0) {
+        return released;
+    }
+    released.swap(retired);
+    pending.store(false);
+    return released;
+}
+
+/**
+ * @brief Libère des instantanés retirés, writer relâché.
+ *
+ * Un instantané peut tenir la dernière référence d'un observateur désabonné : son
+ * destructeur peut alors rappeler Subscribe() ou Unsubscribe() sur ce registre.
+ *
+ * @param snapshots Instantanés renvoyés par Publish() ou Reclaim().
+ */
+void ObserverRegistry::Release(const std::vector<const Snapshot*>& snapshots) {
+    for (const Snapshot* snapshot : snapshots) {
+        delete snapshot;
+    }
+}
+
+/**
+ * @brief Diffuse un événement aux observateurs intéressés par son type.
+ *
+ * Sans verrou : un compteur de diffusions en cours protège l'instantané lu. La dernière
+ * diffusion à se terminer libère les instantanés remplacés entre-temps : un instantané
+ * mis de côté pendant une diffusion ne survit pas à celle-ci, ni les observateurs
+ * désabonnés qu'il gardait en vie. Publish() lève pending avant de compter les
+ * diffusions, et une diffusion décompte avant de lire pending : l'un des deux au moins
+ * voit l'autre.
+ *
+ * @param event L'événement.
+ */
+void ObserverRegistry::Notify(const GameEvent& event) const {
+    const int type = std::countr_zero(MaskOf(event.type));
+    if (type >= kEventTypes) {
+        return;
+    }
+
+    readers.fetch_add(1);
+    const Snapshot* snapshot = current.load();
+    const std::vector<GameObserver*>& observers = snapshot->by_type[type];
+    if (!observers.empty()) {
+        CountMetric(Counter::ObserverCalls, observers.size());
+        LatencyTimer timer(Histogram::DispatchNs);
+        for (GameObserver* observer : observers) {
+            observer->OnEvent(event);
+        }
+    }
+    if (readers.fetch_sub(1) == 1 && pending.load()) {
+        std::unique_lock<std::mutex> lock(writer);
+        const std::vector<const Snapshot*> released = Reclaim();
+        lock.unlock();
+        Release(released);
+    }
+}
+
+/**
+ * @brief Nombre d'observateurs abonnés à un type d'événement.
+ * @param type Type d'événement.
+ * @return Le nombre d'observateurs.
+ */
+std::size_t ObserverRegistry::Count(EventType type) const {
+    const int index = std::countr_zero(MaskOf(type));
+    std::lock_guard<std::mutex> lock(writer);
+    return index < kEventTypes ? current.load()->by_type[index].size() : 0;
+}
+
+/**
+ * @brief Nombre d'abonnements actifs.
+ * @return Le nombre d'abonnements.
+ */
+std::size_t ObserverRegistry::Size() const {
+    std::lock_guard<std::mutex> lock(writer);
+    return live;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file observer_registry.hpp
+ * @brief Registre d'observateurs par poignées, avec diffusion copie-sur-écriture et filtres d'événements.
+ */
+
+#ifndef OBSERVER_REGISTRY_HPP
+#define OBSERVER_REGISTRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Strategy;
+
+/**
+ * @brief Types d'événements de jeu, combinables en masque.
+ */
+enum class EventType : std::uint32_t {
+    Score = 1u << 0, ///< Le score a changé.
+    Possession = 1u << 1, ///< Le ballon a changé de porteur.
+    Strategy = 1u << 2 ///< Un coach a changé de stratégie.
+};
+
+using EventMask = std::uint32_t; ///< Combinaison de EventType.
+
+constexpr EventMask kAllEvents = 0x7; ///< Tous les types d'événements.
+constexpr int kEventTypes = 3; ///< Nombre de types d'événements.
+
+/**
+ * @brief Masque d'un type d'événement.
+ * @param type Type d'événement.
+ * @return Le bit correspondant.
+ */
+constexpr EventMask MaskOf(EventType type) {
+    return static_cast<EventMask>(type);
+}
+
+/**
+ * @brief Événement de jeu diffusé aux observateurs.
+ */
+struct GameEvent {
+    EventType type; ///< Type de l'événement.
+    int homeScore = 0; ///< Score de l'équipe à domicile (Score).
+    int awayScore = 0; ///< Score de l'équipe adverse (Score).
+    int player = -1; ///< Numéro du nouveau porteur (Possession).
+    int team = -1; ///< Équipe concernée (Possession, Strategy).
+    const Strategy* strategy = nullptr; ///< Nouvelle stratégie (Strategy).
+};
+
+/**
+ * @brief Observateur d'événements de jeu.
+ */
+class GameObserver {
+public:
+    virtual ~GameObserver() = default;
+
+    /**
+     * @brief Reçoit un événement dont le type figure dans le masque d'abonnement.
+     * @param event L'événement.
+     */
+    virtual void OnEvent(const GameEvent& event) = 0;
+};
+
+/**
+ * @brief Poignée d'abonnement : emplacement stable et génération.
+ *
+ * Une poignée périmée (emplacement réutilisé depuis) est reconnue et ignorée.
+ */
+struct Subscription {
+    std::uint32_t slot = UINT32_MAX; ///< Emplacement dans le registre.
+    std::uint32_t generation = 0; ///< Génération de l'emplacement lors de l'abonnement.
+
+    bool Valid() const { return slot != UINT32_MAX; } ///< Vrai si la poignée désigne un abonnement.
+};
+
+/**
+ * @brief Registre d'observateurs à diffusion copie-sur-écriture.
+ *
+ * Les abonnements occupent des emplacements stables, recyclés par une liste libre : une
+ * poignée retrouve son emplacement en O(1), sans recherche. Chaque modification publie
+ * un nouvel instantané immuable contenant, pour chaque type d'événement, la liste dense
+ * des seuls observateurs intéressés : s'abonner, se désabonner ou changer de masque
+ * coûte O(n) en abonnements, pour que Notify() parcoure l'instantané courant sans
+ * verrou ni compteur de références par observateur. S'abonner ou se désabonner pendant
+ * une diffusion (y compris depuis OnEvent) est donc sûr : la diffusion en cours termine
+ * sur l'ancien instantané, qui garde ses observateurs en vie. Les anciens instantanés
+ * sont libérés dès que la dernière diffusion en cours se termine.
+ */
+class ObserverRegistry {
+public:
+    ObserverRegistry();
+    ~ObserverRegistry();
+
+    ObserverRegistry(const ObserverRegistry&) = delete; ///< Non copiable.
+    ObserverRegistry& operator=(const ObserverRegistry&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Abonne un observateur.
+     * @param observer Observateur (partagé avec le registre).
+     * @param mask Types d'événements reçus.
+     * @return La poignée d'abonnement.
+     */
+    Subscription Subscribe(const std::shared_ptr<GameObserver>& observer, EventMask mask = kAllEvents);
+
+    /**
+     * @brief Désabonne une poignée.
+     * @param subscription Poignée renvoyée par Subscribe().
+     * @return False si la poignée est invalide ou périmée.
+     */
+    bool Unsubscribe(Subscription subscription);
+
+    /**
+     * @brief Change les types d'événements reçus par un abonnement.
+     * @param subscription Poignée de l'abonnement.
+     * @param mask Nouveau masque.
+     * @return False si la poignée est invalide ou périmée.
+     */
+    bool SetMask(Subscription subscription, EventMask mask);
+
+    /**
+     * @brief Diffuse un événement aux observateurs intéressés par son type.
+     * @param event L'événement.
+     */
+    void Notify(const GameEvent& event) const;
+
+    /**
+     * @brief Nombre d'observateurs abonnés à un type d'événement.
+     * @param type Type d'événement.
+     * @return Le nombre d'observateurs.
+     */
+    std::size_t Count(EventType type) const;
+
+    /**
+     * @brief Nombre d'abonnements actifs.
+     * @return Le nombre d'abonnements.
+     */
+    std::size_t Size() const;
+
+private:
+    /**
+     * @brief Emplacement d'abonnement.
+     */
+    struct Slot {
+        std::shared_ptr<GameObserver> observer; ///< Observateur, nul si l'emplacement est libre.
+        EventMask mask = 0; ///< Types reçus.
+        std::uint32_t generation = 0; ///< Incrémentée à chaque libération.
+    };
+
+    /**
+     * @brief Instantané immuable des listes de diffusion.
+     */
+    struct Snapshot {
+        std::vector<GameObserver*> by_type[kEventTypes]; ///< Observateurs intéressés, par type.
+        std::vector<std::shared_ptr<GameObserver>> owners; ///< Maintient les observateurs en vie.
+    };
+
+    mutable std::mutex writer; ///< Sérialise les modifications.
+    std::vector<Slot> slots; ///< Emplacements d'abonnement.
+    std::vector<std::uint32_t> free_slots; ///< Emplacements libres.
+    std::size_t live = 0; ///< Abonnements actifs.
+    std::atomic<const Snapshot*> current; ///< Instantané diffusé.
+    mutable std::vector<const Snapshot*> retired; ///< Instantanés remplacés, en attente de libération.
+    mutable std::atomic<std::uint32_t> readers{0}; ///< Diffusions en cours.
+    mutable std::atomic<bool> pending{false}; ///< Vrai si des instantanés attendent leur libération.
+
+    /**
+     * @brief Construit et publie un nouvel instantané (writer tenu).
+     */
+    std::vector<const Snapshot*> Publish();
+
+    /**
+     * @brief Retire les instantanés remplacés si aucune diffusion n'est en cours (writer tenu).
+     */
+    std::vector<const Snapshot*> Reclaim() const;
+
+    /**
+     * @brief Libère des instantanés retirés (writer relâché).
+     */
+    static void Release(const std::vector<const Snapshot*>& snapshots);
+
+    /**
+     * @brief Vérifie qu'une poignée désigne un abonnement actif (writer tenu).
+     */
+    bool Live(Subscription subscription) const;
+};
+
+#endif // OBSERVER_REGISTRY_HPP
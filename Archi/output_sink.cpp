@@ -0,0 +1,232 @@
+#include "output_sink.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <iostream>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kLineReserve = 4096; ///< Capacité initiale du tampon de chaque thread.
+
+std::atomic<OutputSink*> g_sink{nullptr}; ///< Puits courant, nullptr pour std::cout.
+std::atomic<std::size_t> g_threshold{0}; ///< Seuil d'envoi du tampon.
+
+/**
+ * @brief Puits par défaut sur std::cout, créé à la première utilisation.
+ */
+StreamSink& default_sink() {
+    static StreamSink sink(std::cout);
+    return sink;
+}
+
+/**
+ * @brief Tampon de lignes propre à un thread, envoyé au puits à la fin du thread.
+ */
+struct ThreadBuffer {
+    std::vector<char> bytes; ///< Lignes complètes en attente.
+
+    ThreadBuffer() { bytes.reserve(kLineReserve); }
+    ~ThreadBuffer() { Send(); }
+
+    /**
+     * @brief Envoie les lignes en attente au puits courant.
+     */
+    void Send() {
+        if (!bytes.empty()) {
+            GetOutputSink().Write(bytes.data(), bytes.size());
+            bytes.clear();
+        }
+    }
+};
+
+/**
+ * @brief Tampon du thread appelant.
+ */
+ThreadBuffer& thread_buffer() {
+    thread_local ThreadBuffer buffer;
+    return buffer;
+}
+
+} // namespace
+
+/**
+ * @brief Écrit dans le flux.
+ * @param data Octets à écrire.
+ * @param size Nombre d'octets.
+ */
+void StreamSink::Write(const char* data, std::size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    out->write(data, static_cast<std::streamsize>(size));
+}
+
+/**
+ * @brief Vide le flux.
+ */
+void StreamSink::Flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    out->flush();
+}
+
+/**
+ * @brief Écrit tout le bloc, en reprenant après une écriture partielle ou une interruption.
+ * @param data Octets à écrire.
+ * @param size Nombre d'octets.
+ */
+void FdSink::Write(const char* data, std::size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (size) {
+        const ssize_t n = ::write(fd, data, size);
+        ++syscalls;
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+/**
+ * @brief Constructeur.
+ * @param capacity Nombre d'octets conservés.
+ */
+RingSink::RingSink(std::size_t capacity) : buffer(capacity ? capacity : 1) {}
+
+/**
+ * @brief Ajoute un bloc à l'anneau ; seuls les Capacity() derniers octets sont conservés.
+ * @param data Octets à écrire.
+ * @param size Nombre d'octets.
+ */
+void RingSink::Write(const char* data, std::size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::size_t capacity = buffer.size();
+    written += size;
+    if (size > capacity) {
+        data += size - capacity;
+        size = capacity;
+    }
+    std::size_t pos = (written - size) % capacity;
+    const std::size_t first = std::min(size, capacity - pos);
+    std::copy(data, data + first, buffer.begin() + pos);
+    std::copy(data + first, data + size, buffer.begin());
+}
+
+/**
+ * @brief Derniers octets écrits, du plus ancien au plus récent.
+ * @return Au plus Capacity() octets.
+ */
+std::string RingSink::Contents() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::size_t capacity = buffer.size();
+    if (written <= capacity) {
+        return std::string(buffer.begin(), buffer.begin() + written);
+    }
+    const std::size_t pos = written % capacity;
+    std::string contents(buffer.begin() + pos, buffer.end());
+    contents.append(buffer.begin(), buffer.begin() + pos);
+    return contents;
+}
+
+/**
+ * @brief Octets écrits depuis la création ou le dernier Clear().
+ * @return Le nombre d'octets, lu sous le verrou des écrivains.
+ */
+std::uint64_t RingSink::Written() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return written;
+}
+
+/**
+ * @brief Vide l'anneau.
+ */
+void RingSink::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    written = 0;
+}
+
+/**
+ * @brief Remplace le puits des rapports.
+ * @param sink Nouveau puits, nullptr pour std::cout.
+ */
+void SetOutputSink(OutputSink* sink) {
+    thread_buffer().Send();
+    g_sink.store(sink, std::memory_order_release);
+}
+
+/**
+ * @brief Puits courant des rapports.
+ * @return Le puits.
+ */
+OutputSink& GetOutputSink() {
+    OutputSink* sink = g_sink.load(std::memory_order_acquire);
+    return sink ? *sink : default_sink();
+}
+
+/**
+ * @brief Taille à partir de laquelle le tampon d'un thread est envoyé au puits.
+ * @param bytes Seuil en octets.
+ */
+void SetReportFlushThreshold(std::size_t bytes) {
+    g_threshold.store(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Envoie le tampon du thread appelant au puits, puis vide le puits.
+ */
+void FlushReports() {
+    thread_buffer().Send();
+    GetOutputSink().Flush();
+}
+
+#ifndef BASKET_NULL_SINK
+
+/**
+ * @brief Termine la ligne et l'envoie au puits si le tampon dépasse le seuil.
+ */
+ReportLine::~ReportLine() {
+    ThreadBuffer& buffer = thread_buffer();
+    buffer.bytes.push_back('\n');
+    if (buffer.bytes.size() > g_threshold.load(std::memory_order_relaxed)) {
+        buffer.Send();
+    }
+}
+
+/**
+ * @brief Ajoute du texte.
+ * @param text Texte à ajouter.
+ * @return La ligne.
+ */
+ReportLine& ReportLine::operator<<(std::string_view text) {
+    std::vector<char>& bytes = thread_buffer().bytes;
+    bytes.insert(bytes.end(), text.begin(), text.end());
+    return *this;
+}
+
+/**
+ * @brief Ajoute un entier.
+ * @param value Valeur à formater.
+ * @return La ligne.
+ */
+ReportLine& ReportLine::operator<<(int value) {
+    char digits[16];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    return *this << std::string_view(digits, result.ptr - digits);
+}
+
+/**
+ * @brief Ajoute un flottant, au format général à 6 chiffres significatifs.
+ * @param value Valeur à formater.
+ * @return La ligne.
+ */
+ReportLine& ReportLine::operator<<(float value) {
+    char digits[32];
+    const std::to_chars_result result =
+        std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+    return *this << std::string_view(digits, result.ptr - digits);
+}
+
+#endif // BASKET_NULL_SINK
@@ -0,0 +1,196 @@
+/**
+ * @file output_sink.hpp
+ * @brief Sortie des rapports console (arbitres, coachs, équipes) à travers un puits interchangeable.
+ */
+
+#ifndef OUTPUT_SINK_HPP
+#define OUTPUT_SINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Destination des lignes de rapport.
+ *
+ * Write() peut être appelé depuis plusieurs threads : chaque implémentation est thread-safe.
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    /**
+     * @brief Écrit un bloc de lignes complètes.
+     * @param data Octets à écrire.
+     * @param size Nombre d'octets.
+     */
+    virtual void Write(const char* data, std::size_t size) = 0;
+
+    /**
+     * @brief Pousse les données en attente vers leur destination finale.
+     */
+    virtual void Flush() {}
+};
+
+/**
+ * @brief Puits écrivant dans un flux C++ (std::cout par défaut), sans vidage par ligne.
+ */
+class StreamSink : public OutputSink {
+public:
+    /**
+     * @brief Constructeur.
+     * @param out Flux de destination.
+     */
+    explicit StreamSink(std::ostream& out) : out(&out) {}
+
+    void Write(const char* data, std::size_t size) override; ///< Écrit dans le flux.
+    void Flush() override; ///< Vide le flux.
+
+private:
+    std::ostream* out; ///< Flux de destination.
+    std::mutex mutex; ///< Sérialise les écritures concurrentes.
+};
+
+/**
+ * @brief Puits écrivant directement dans un descripteur de fichier (un appel système par bloc).
+ */
+class FdSink : public OutputSink {
+public:
+    /**
+     * @brief Constructeur.
+     * @param fd Descripteur ouvert en écriture (non fermé par le puits).
+     */
+    explicit FdSink(int fd) : fd(fd) {}
+
+    void Write(const char* data, std::size_t size) override; ///< Écrit tout le bloc.
+
+    /**
+     * @brief Nombre d'appels système write() effectués.
+     * @return Le nombre d'appels.
+     */
+    std::uint64_t Syscalls() const { return syscalls; }
+
+private:
+    int fd; ///< Descripteur de destination.
+    std::mutex mutex; ///< Garde les blocs entiers d'un seul tenant.
+    std::uint64_t syscalls = 0; ///< Appels système effectués.
+};
+
+/**
+ * @brief Puits en mémoire conservant les derniers octets écrits (anneau de taille fixe).
+ */
+class RingSink : public OutputSink {
+public:
+    /**
+     * @brief Constructeur.
+     * @param capacity Nombre d'octets conservés.
+     */
+    explicit RingSink(std::size_t capacity = 1 << 16);
+
+    void Write(const char* data, std::size_t size) override; ///< Ajoute à l'anneau.
+
+    /**
+     * @brief Derniers octets écrits, du plus ancien au plus récent.
+     * @return Au plus Capacity() octets.
+     */
+    std::string Contents() const;
+
+    /**
+     * @brief Vide l'anneau.
+     */
+    void Clear();
+
+    std::size_t Capacity() const { return buffer.size(); } ///< Taille de l'anneau.
+    std::uint64_t Written() const; ///< Octets écrits depuis la création ou le dernier Clear().
+
+private:
+    std::vector<char> buffer; ///< Anneau.
+    std::uint64_t written = 0; ///< Octets écrits ; written % capacité donne la position d'écriture.
+    mutable std::mutex mutex; ///< Sérialise écritures et lectures.
+};
+
+/**
+ * @brief Puits qui ignore tout ce qu'on lui écrit.
+ */
+class NullSink : public OutputSink {
+public:
+    void Write(const char*, std::size_t) override {}
+};
+
+/**
+ * @brief Remplace le puits des rapports.
+ *
+ * Les lignes en attente dans le tampon du thread appelant sont d'abord envoyées à l'ancien
+ * puits ; les autres threads doivent appeler FlushReports() avant le changement.
+ *
+ * @param sink Nouveau puits, nullptr pour revenir à std::cout. Doit survivre à son utilisation.
+ */
+void SetOutputSink(OutputSink* sink);
+
+/**
+ * @brief Puits courant des rapports.
+ * @return Le puits, std::cout par défaut.
+ */
+OutputSink& GetOutputSink();
+
+/**
+ * @brief Taille à partir de laquelle le tampon d'un thread est envoyé au puits.
+ *
+ * 0 (défaut) envoie chaque ligne dès qu'elle est complète ; une valeur de quelques
+ * kilo-octets regroupe les lignes en un seul Write().
+ *
+ * @param bytes Seuil en octets.
+ */
+void SetReportFlushThreshold(std::size_t bytes);
+
+/**
+ * @brief Envoie le tampon du thread appelant au puits, puis vide le puits.
+ */
+void FlushReports();
+
+#ifndef BASKET_NULL_SINK
+
+/**
+ * @brief Ligne de rapport formatée sans allocation dans le tampon du thread courant.
+ *
+ * Les nombres sont formatés par std::to_chars (les flottants comme `operator<<` d'un flux
+ * par défaut : format général, 6 chiffres significatifs). La ligne est terminée et
+ * validée à la destruction de l'objet.
+ */
+class ReportLine {
+public:
+    ReportLine() = default;
+    ~ReportLine(); ///< Termine la ligne et l'envoie au puits selon le seuil.
+
+    ReportLine(const ReportLine&) = delete; ///< Non copiable.
+    ReportLine& operator=(const ReportLine&) = delete; ///< Non copiable.
+
+    ReportLine& operator<<(std::string_view text); ///< Ajoute du texte.
+    ReportLine& operator<<(const char* text) { return *this << std::string_view(text); } ///< Ajoute du texte.
+    ReportLine& operator<<(char c) { return *this << std::string_view(&c, 1); } ///< Ajoute un caractère.
+    ReportLine& operator<<(int value); ///< Ajoute un entier.
+    ReportLine& operator<<(float value); ///< Ajoute un flottant.
+};
+
+#else
+
+/**
+ * @brief Ligne de rapport neutralisée : BASKET_NULL_SINK supprime toute sortie à la compilation.
+ */
+class ReportLine {
+public:
+    /**
+     * @brief Ignore la valeur.
+     * @return La ligne elle-même.
+     */
+    template <typename T>
+    ReportLine& operator<<(const T&) { return *this; }
+};
+
+#endif // BASKET_NULL_SINK
+
+#endif // OUTPUT_SINK_HPP
@@ -0,0 +1,165 @@
+#include "pass_evaluator.hpp"
+#include <cfloat>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr float kMinLaneLength2 = 1e-6f; ///< Longueur au carré minimale d'une ligne (passe nulle).
+
+} // namespace
+
+/**
+ * @brief Calcule, pour chaque ligne de passe, la distance au carré de l'adversaire le plus proche.
+ * @param px Coordonnée X du passeur.
+ * @param py Coordonnée Y du passeur.
+ * @param rx Coordonnées X des receveurs.
+ * @param ry Coordonnées Y des receveurs.
+ * @param lanes Nombre de lignes de passe.
+ * @param ox Coordonnées X des adversaires.
+ * @param oy Coordonnées Y des adversaires.
+ * @param opponents Nombre d'adversaires.
+ * @param out Tableau recevant les distances au carré.
+ */
+void lane_clearances(float px, float py, const float* rx, const float* ry, std::size_t lanes,
+                     const float* ox, const float* oy, std::size_t opponents, float* out) {
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256 px8 = _mm256_set1_ps(px);
+    const __m256 py8 = _mm256_set1_ps(py);
+    const __m256 zero8 = _mm256_setzero_ps();
+    const __m256 one8 = _mm256_set1_ps(1.f);
+    for (; i + 8 <= lanes; i += 8) {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(rx + i), px8);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ry + i), py8);
+        const __m256 dd = _mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+                                        _mm256_set1_ps(kMinLaneLength2));
+        const __m256 inv = _mm256_div_ps(one8, dd);
+        __m256 best = _mm256_set1_ps(FLT_MAX);
+        for (std::size_t o = 0; o < opponents; ++o) {
+            const __m256 wx = _mm256_sub_ps(_mm256_set1_ps(ox[o]), px8);
+            const __m256 wy = _mm256_sub_ps(_mm256_set1_ps(oy[o]), py8);
+            __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(wx, dx), _mm256_mul_ps(wy, dy)), inv);
+            t = _mm256_min_ps(_mm256_max_ps(t, zero8), one8);
+            const __m256 ex = _mm256_sub_ps(wx, _mm256_mul_ps(t, dx));
+            const __m256 ey = _mm256_sub_ps(wy, _mm256_mul_ps(t, dy));
+            best = _mm256_min_ps(best, _mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey)));
+        }
+        _mm256_storeu_ps(out + i, best);
+    }
+#endif
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+    const __m128 px4 = _mm_set1_ps(px);
+    const __m128 py4 = _mm_set1_ps(py);
+    const __m128 zero4 = _mm_setzero_ps();
+    const __m128 one4 = _mm_set1_ps(1.f);
+    for (; i + 4 <= lanes; i += 4) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(rx + i), px4);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ry + i), py4);
+        const __m128 dd = _mm_max_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                                     _mm_set1_ps(kMinLaneLength2));
+        const __m128 inv = _mm_div_ps(one4, dd);
+        __m128 best = _mm_set1_ps(FLT_MAX);
+        for (std::size_t o = 0; o < opponents; ++o) {
+            const __m128 wx = _mm_sub_ps(_mm_set1_ps(ox[o]), px4);
+            const __m128 wy = _mm_sub_ps(_mm_set1_ps(oy[o]), py4);
+            __m128 t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(wx, dx), _mm_mul_ps(wy, dy)), inv);
+            t = _mm_min_ps(_mm_max_ps(t, zero4), one4);
+            const __m128 ex = _mm_sub_ps(wx, _mm_mul_ps(t, dx));
+            const __m128 ey = _mm_sub_ps(wy, _mm_mul_ps(t, dy));
+            best = _mm_min_ps(best, _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)));
+        }
+        _mm_storeu_ps(out + i, best);
+    }
+#endif
+
+    for (; i < lanes; ++i) {
+        const float dx = rx[i] - px;
+        const float dy = ry[i] - py;
+        const float inv = 1.f / std::fmax(dx * dx + dy * dy, kMinLaneLength2);
+        float best = FLT_MAX;
+        for (std::size_t o = 0; o < opponents; ++o) {
+            const float wx = ox[o] - px;
+            const float wy = oy[o] - py;
+            const float t = std::fmin(std::fmax((wx * dx + wy * dy) * inv, 0.f), 1.f);
+            const float ex = wx - t * dx;
+            const float ey = wy - t * dy;
+            best = std::fmin(best, ex * ex + ey * ey);
+        }
+        out[i] = best;
+    }
+}
+
+/**
+ * @brief Évalue et classe les passes du porteur.
+ *
+ * Les dégagements de toutes les lignes sont calculés en un seul appel à lane_clearances() ;
+ * seules les options retenues passent ensuite par une racine carrée et le classement
+ * par insertion (à score égal, le coéquipier le plus proche reste devant).
+ *
+ * @param passer Porteur du ballon.
+ * @param basket Panier attaqué par l'équipe du porteur.
+ * @return Le nombre de passes candidates.
+ */
+template <class Rules>
+int BasicPassEvaluator<Rules>::Evaluate(const PlayerType& passer, const Position& basket) {
+    int lanes = 0;
+    PlayerType* receivers[kLanes];
+    int slots[kLanes];
+    unrolled<kLanes>([&](auto k) {
+        if (PlayerType* mate = passer.Teammates[k]) {
+            receivers[lanes] = mate;
+            slots[lanes] = static_cast<int>(k);
+            lane_x[lanes] = mate->position.x;
+            lane_y[lanes] = mate->position.y;
+            ++lanes;
+        }
+    });
+
+    int opponents = 0;
+    unrolled<Rules::opponents>([&](auto k) {
+        if (const PlayerType* opponent = passer.Opponents[k]) {
+            opp_x[opponents] = opponent->position.x;
+            opp_y[opponents] = opponent->position.y;
+            ++opponents;
+        }
+    });
+
+    lane_clearances(passer.position.x, passer.position.y, lane_x, lane_y, lanes, opp_x, opp_y, opponents,
+                    clear2);
+
+    const float from_basket = passer.position.distance_to(basket);
+    count = 0;
+    for (int i = 0; i < lanes; ++i) {
+        Option option;
+        option.receiver = receivers[i];
+        option.slot = slots[i];
+        option.clearance = std::sqrt(clear2[i]);
+        option.length = passer.position.distance_to(receivers[i]->position);
+        option.progress = from_basket - receivers[i]->position.distance_to(basket);
+        option.score = weights.clearance_weight * std::fmin(option.clearance, weights.clearance_cap) +
+                       weights.progress_weight * option.progress - weights.length_weight * option.length;
+        option.open = option.clearance >= weights.intercept_radius;
+
+        int pos = count++;
+        // Une seule ligne (RulesDrill2x2) : rien à classer, et ranked[pos - 1] n'existe pas
+        if constexpr (kLanes > 1) {
+            while (pos > 0 && option.score > ranked[pos - 1].score) {
+                ranked[pos] = ranked[pos - 1];
+                --pos;
+            }
+        }
+        ranked[pos] = option;
+    }
+    return count;
+}
+
+template class BasicPassEvaluator<Rules5x5>;
+template class BasicPassEvaluator<Rules3x3>;
+template class BasicPassEvaluator<RulesDrill2x2>;
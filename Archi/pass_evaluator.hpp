@@ -0,0 +1,119 @@
+/**
+ * @file pass_evaluator.hpp
+ * @brief Choix de la passe tenant compte des lignes d'interception adverses.
+ */
+
+#ifndef PASS_EVALUATOR_HPP
+#define PASS_EVALUATOR_HPP
+
+#include "basket.hpp"
+#include <cstddef>
+
+/**
+ * @brief Calcule, pour chaque ligne de passe, la distance au carré de l'adversaire le plus proche.
+ *
+ * Les lignes partent toutes du passeur (@p px, @p py) ; la distance d'un adversaire à une
+ * ligne est la distance point-segment. Le noyau traite les lignes par paquets de 8 (AVX)
+ * ou de 4 (SSE2), avec un repli scalaire, et parcourt les adversaires pour chaque paquet.
+ *
+ * @param px Coordonnée X du passeur.
+ * @param py Coordonnée Y du passeur.
+ * @param rx Coordonnées X des receveurs.
+ * @param ry Coordonnées Y des receveurs.
+ * @param lanes Nombre de lignes de passe.
+ * @param ox Coordonnées X des adversaires.
+ * @param oy Coordonnées Y des adversaires.
+ * @param opponents Nombre d'adversaires.
+ * @param out Tableau recevant les @p lanes distances au carré (FLT_MAX sans adversaire).
+ */
+void lane_clearances(float px, float py, const float* rx, const float* ry, std::size_t lanes,
+                     const float* ox, const float* oy, std::size_t opponents, float* out);
+
+/**
+ * @brief Pondération des critères d'une passe.
+ *
+ * Score = clearance_weight * min(dégagement, clearance_cap) + progress_weight * progression
+ *         - length_weight * longueur.
+ */
+struct PassWeights {
+    float clearance_cap = 4.f; ///< Au-delà de ce dégagement, la ligne est considérée libre.
+    float clearance_weight = 1.f; ///< Poids du dégagement de la ligne.
+    float progress_weight = 0.2f; ///< Poids du rapprochement du panier visé.
+    float length_weight = 0.05f; ///< Pénalité par unité de longueur de passe.
+    float intercept_radius = 1.f; ///< En deçà de ce dégagement, la passe est jugée interceptable.
+};
+
+/**
+ * @brief Évalue toutes les passes possibles d'un porteur vers ses coéquipiers.
+ *
+ * Les candidats sont les entrées de `Teammates`, les défenseurs celles de `Opponents`
+ * (tables remplies par le suivi des voisins, NeighbourTracker ou BasicPlayerPool). Tout tient
+ * dans des tableaux de taille fixe : une décision n'alloue pas. Budget visé : moins de 150 ns
+ * par décision en 5x5 (cas `pass_evaluate` de basket_bench).
+ *
+ * @tparam Rules Règles de la variante de jeu.
+ */
+template <class Rules>
+class BasicPassEvaluator {
+public:
+    using PlayerType = BasicPlayer<Rules>; ///< Type des joueurs.
+
+    static constexpr int kLanes = Rules::teammates; ///< Nombre maximal de lignes de passe.
+
+    /**
+     * @brief Une passe candidate et ses critères.
+     */
+    struct Option {
+        PlayerType* receiver; ///< Receveur.
+        int slot; ///< Indice du receveur dans `Teammates`.
+        float clearance; ///< Distance de l'adversaire le plus proche à la ligne de passe.
+        float length; ///< Longueur de la passe.
+        float progress; ///< Rapprochement du panier visé (positif vers le panier).
+        float score; ///< Score pondéré, le plus élevé est le meilleur.
+        bool open; ///< False si un adversaire est à moins de intercept_radius de la ligne.
+    };
+
+    /**
+     * @brief Constructeur.
+     * @param weights Pondération des critères.
+     */
+    explicit BasicPassEvaluator(const PassWeights& weights = PassWeights()) : weights(weights) {}
+
+    /**
+     * @brief Évalue et classe les passes du porteur.
+     * @param passer Porteur du ballon.
+     * @param basket Panier attaqué par l'équipe du porteur.
+     * @return Le nombre de passes candidates.
+     */
+    int Evaluate(const PlayerType& passer, const Position& basket);
+
+    /**
+     * @brief Meilleure passe de la dernière évaluation.
+     * @return L'option de plus haut score, ou nullptr sans coéquipier.
+     */
+    const Option* Best() const { return count ? &ranked[0] : nullptr; }
+
+    const Option* Ranked() const { return ranked; } ///< Options classées par score décroissant.
+    int Size() const { return count; } ///< Nombre d'options de la dernière évaluation.
+    const PassWeights& Weights() const { return weights; } ///< Pondération des critères.
+
+private:
+    static constexpr int kStride = (kLanes + 7) / 8 * 8; ///< Lignes arrondies au paquet AVX.
+
+    PassWeights weights; ///< Pondération des critères.
+    Option ranked[kLanes]; ///< Options classées.
+    int count = 0; ///< Nombre d'options classées.
+    alignas(32) float lane_x[kStride]; ///< Coordonnées X des receveurs.
+    alignas(32) float lane_y[kStride]; ///< Coordonnées Y des receveurs.
+    alignas(32) float clear2[kStride]; ///< Dégagement au carré de chaque ligne.
+    float opp_x[Rules::opponents]; ///< Coordonnées X des adversaires.
+    float opp_y[Rules::opponents]; ///< Coordonnées Y des adversaires.
+};
+
+extern template class BasicPassEvaluator<Rules5x5>;
+extern template class BasicPassEvaluator<Rules3x3>;
+extern template class BasicPassEvaluator<RulesDrill2x2>;
+
+using PassEvaluator = BasicPassEvaluator<Rules5x5>; ///< Évaluateur de passes d'un match à cinq contre cinq.
+
+#endif // PASS_EVALUATOR_HPP
@@ -0,0 +1,180 @@
+#include "player_pool.hpp"
+#include "metrics.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Calcule les distances au carré entre un point et une série de positions contiguës.
+ * @param xs Coordonnées X des positions.
+ * @param ys Coordonnées Y des positions.
+ * @param count Nombre de positions.
+ * @param px Coordonnée X du point de référence.
+ * @param py Coordonnée Y du point de référence.
+ * @param out Tableau de sortie recevant les distances au carré.
+ */
+void squared_distances(const float* xs, const float* ys, std::size_t count,
+                       float px, float py, float* out) {
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256 vx8 = _mm256_set1_ps(px);
+    const __m256 vy8 = _mm256_set1_ps(py);
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vx8);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vy8);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    }
+#endif
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+    const __m128 vx4 = _mm_set1_ps(px);
+    const __m128 vy4 = _mm_set1_ps(py);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), vx4);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), vy4);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float dx = xs[i] - px;
+        float dy = ys[i] - py;
+        out[i] = dx * dx + dy * dy;
+    }
+}
+
+namespace {
+
+/**
+ * @brief Sélection des K plus petites distances dans un tableau de taille fixe.
+ *
+ * Insertion triée sans allocation ; à distance égale, le premier candidat inséré reste devant.
+ */
+template <int K>
+struct TopK {
+    float dist[K] = {}; ///< Distances au carré retenues, par ordre croissant.
+    int index[K] = {}; ///< Indices des joueurs retenus.
+    int size = 0; ///< Nombre de cases occupées.
+
+    /**
+     * @brief Propose un candidat.
+     * @param d Distance au carré du candidat.
+     * @param idx Indice du candidat.
+     */
+    void Push(float d, int idx) {
+        if (size == K && !(d < dist[K - 1])) {
+            return;
+        }
+        int pos = size < K ? size++ : K - 1;
+        while (pos > 0 && d < dist[pos - 1]) {
+            dist[pos] = dist[pos - 1];
+            index[pos] = index[pos - 1];
+            --pos;
+        }
+        dist[pos] = d;
+        index[pos] = idx;
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Constructeur réservant la mémoire pour un nombre de joueurs donné.
+ * @param capacity Nombre de joueurs attendu.
+ */
+template <class Rules>
+BasicPlayerPool<Rules>::BasicPlayerPool(std::size_t capacity) {
+    xs.reserve(capacity);
+    ys.reserve(capacity);
+    teams.reserve(capacity);
+    numbers.reserve(capacity);
+    scratch.reserve(capacity);
+}
+
+/**
+ * @brief Redimensionne les tableaux internes.
+ * @param n Nouveau nombre de joueurs.
+ */
+template <class Rules>
+void BasicPlayerPool<Rules>::Resize(std::size_t n) {
+    count = n;
+    xs.resize(n);
+    ys.resize(n);
+    teams.resize(n);
+    numbers.resize(n);
+    scratch.resize(n);
+}
+
+/**
+ * @brief Charge les numéros, équipes et positions d'une liste de joueurs.
+ * @param players Liste de tous les joueurs du jeu.
+ */
+template <class Rules>
+void BasicPlayerPool<Rules>::Load(const std::vector<PlayerType>& players) {
+    Resize(players.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        numbers[i] = players[i].number;
+        teams[i] = Rules::team_of(players[i].number);
+    }
+    SyncPositions(players);
+}
+
+/**
+ * @brief Recopie uniquement les positions des joueurs déjà chargés.
+ * @param players Liste des joueurs, dans le même ordre que lors de Load().
+ */
+template <class Rules>
+void BasicPlayerPool<Rules>::SyncPositions(const std::vector<PlayerType>& players) {
+    for (std::size_t i = 0; i < count; ++i) {
+        xs[i] = players[i].position.x;
+        ys[i] = players[i].position.y;
+    }
+}
+
+/**
+ * @brief Remplit les coéquipiers et adversaires les plus proches de tous les joueurs.
+ * @param players Liste des joueurs, dans le même ordre que lors de Load().
+ */
+template <class Rules>
+void BasicPlayerPool<Rules>::RefreshNeighbours(std::vector<PlayerType>& players) {
+    if (players.size() != count) {
+        Load(players);
+    } else {
+        SyncPositions(players);
+    }
+
+    const int n = static_cast<int>(count);
+    for (int i = 0; i < n; ++i) {
+        squared_distances(xs.data(), ys.data(), count, xs[i], ys[i], scratch.data());
+
+        TopK<kTeammates> mates;
+        TopK<kOpponents> opponents;
+        const int team = teams[i];
+        for (int j = 0; j < n; ++j) {
+            if (teams[j] == team) {
+                if (j != i) {
+                    mates.Push(scratch[j], j);
+                }
+            } else {
+                opponents.Push(scratch[j], j);
+            }
+        }
+
+        PlayerType& player = players[i];
+        unrolled<kTeammates>([&](auto k) {
+            player.Teammates[k] = static_cast<int>(k) < mates.size ? &players[mates.index[k]] : nullptr;
+        });
+        unrolled<kOpponents>([&](auto k) {
+            player.Opponents[k] = static_cast<int>(k) < opponents.size ? &players[opponents.index[k]] : nullptr;
+        });
+    }
+    CountMetric(Counter::NeighbourSearches, 2 * count); // Coéquipiers et adversaires de chaque joueur
+}
+
+template class BasicPlayerPool<Rules5x5>;
+template class BasicPlayerPool<Rules3x3>;
+template class BasicPlayerPool<RulesDrill2x2>;
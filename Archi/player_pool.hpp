@@ -0,0 +1,108 @@
+/**
+ * @file player_pool.hpp
+ * @brief Stockage des joueurs en structure de tableaux (SoA) et recherche groupée des voisins.
+ */
+
+#ifndef PLAYER_POOL_HPP
+#define PLAYER_POOL_HPP
+
+#include "basket.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Calcule les distances au carré entre un point et une série de positions contiguës.
+ *
+ * Noyau vectorisé (AVX/SSE2 selon la cible, repli scalaire sinon) : aucune racine carrée
+ * n'est calculée, l'ordre des distances au carré étant identique à celui des distances.
+ *
+ * @param xs Coordonnées X des positions.
+ * @param ys Coordonnées Y des positions.
+ * @param count Nombre de positions.
+ * @param px Coordonnée X du point de référence.
+ * @param py Coordonnée Y du point de référence.
+ * @param out Tableau de sortie recevant les @p count distances au carré.
+ */
+void squared_distances(const float* xs, const float* ys, std::size_t count,
+                       float px, float py, float* out);
+
+/**
+ * @brief Magasin de joueurs en structure de tableaux pour le calcul groupé des voisins.
+ *
+ * Les coordonnées, équipes et numéros sont rangés dans des tableaux contigus. Un seul appel
+ * à RefreshNeighbours() remplit les tables `Teammates` et `Opponents` de tous les joueurs,
+ * par sélection des k plus proches dans des tableaux de taille fixe : ni tri, ni allocation
+ * tant que le nombre de joueurs ne dépasse pas la capacité réservée.
+ *
+ * @tparam Rules Règles de la variante de jeu (taille des tables et répartition en équipes).
+ */
+template <class Rules>
+class BasicPlayerPool {
+public:
+    using PlayerType = BasicPlayer<Rules>; ///< Type des joueurs gérés.
+
+    static constexpr int kPlayersPerTeam = Rules::team_size; ///< Joueurs par équipe.
+    static constexpr int kTeammates = Rules::teammates; ///< Taille de la table `Teammates`.
+    static constexpr int kOpponents = Rules::opponents; ///< Taille de la table `Opponents`.
+
+    /**
+     * @brief Constructeur réservant la mémoire pour un nombre de joueurs donné.
+     * @param capacity Nombre de joueurs attendu.
+     */
+    explicit BasicPlayerPool(std::size_t capacity = Rules::players);
+
+    /**
+     * @brief Charge les numéros, équipes et positions d'une liste de joueurs.
+     * @param players Liste de tous les joueurs du jeu.
+     */
+    void Load(const std::vector<PlayerType>& players);
+
+    /**
+     * @brief Recopie uniquement les positions des joueurs déjà chargés.
+     * @param players Liste des joueurs, dans le même ordre que lors de Load().
+     */
+    void SyncPositions(const std::vector<PlayerType>& players);
+
+    /**
+     * @brief Remplit les coéquipiers et adversaires les plus proches de tous les joueurs.
+     *
+     * Les positions sont resynchronisées avant le calcul. Les cases non pourvues
+     * (moins de coéquipiers ou d'adversaires que de places) sont mises à nullptr.
+     *
+     * @param players Liste des joueurs, dans le même ordre que lors de Load().
+     */
+    void RefreshNeighbours(std::vector<PlayerType>& players);
+
+    /**
+     * @brief Nombre de joueurs chargés.
+     * @return Le nombre de joueurs.
+     */
+    std::size_t Size() const { return count; }
+
+    const float* X() const { return xs.data(); } ///< Coordonnées X contiguës.
+    const float* Y() const { return ys.data(); } ///< Coordonnées Y contiguës.
+    const int* Teams() const { return teams.data(); } ///< Identifiants d'équipe contigus.
+    const int* Numbers() const { return numbers.data(); } ///< Numéros de joueurs contigus.
+
+private:
+    std::size_t count = 0; ///< Nombre de joueurs chargés.
+    std::vector<float> xs; ///< Coordonnées X.
+    std::vector<float> ys; ///< Coordonnées Y.
+    std::vector<int> teams; ///< Identifiant d'équipe de chaque joueur.
+    std::vector<int> numbers; ///< Numéro de chaque joueur.
+    std::vector<float> scratch; ///< Ligne de distances au carré réutilisée d'un joueur à l'autre.
+
+    /**
+     * @brief Redimensionne les tableaux (n'alloue que si la capacité est dépassée).
+     * @param n Nouveau nombre de joueurs.
+     */
+    void Resize(std::size_t n);
+};
+
+extern template class BasicPlayerPool<Rules5x5>;
+extern template class BasicPlayerPool<Rules3x3>;
+extern template class BasicPlayerPool<RulesDrill2x2>;
+
+using PlayerPool = BasicPlayerPool<Rules5x5>; ///< Magasin de joueurs d'un match à cinq contre cinq.
+
+#endif // PLAYER_POOL_HPP
@@ -0,0 +1,166 @@
+#include "player_stats.hpp"
+#include "basket.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Ajoute une observation d'un joueur.
+ * @param player Joueur observé.
+ * @param dt Durée représentée par l'observation.
+ * @return True à la première observation du joueur ou s'il a pris ou perdu le ballon.
+ */
+template <class Rules>
+bool PlayerStatsTable::Observe(const BasicPlayer<Rules>& player, float dt) {
+    const int number = player.number;
+    if (number < 0) {
+        return false;
+    }
+    const std::size_t i = static_cast<std::size_t>(number);
+    if (i >= observations.size()) {
+        Grow(i + 1);
+    }
+
+    ++observations[i];
+    const std::uint8_t holding = player.possede_ball ? 1 : 0;
+    const bool changed = !seen[i] || had_ball[i] != holding;
+    if (seen[i]) {
+        const float dx = player.position.x - last_x[i];
+        const float dy = player.position.y - last_y[i];
+        distance[i] += std::sqrt(dx * dx + dy * dy);
+    }
+    last_x[i] = player.position.x;
+    last_y[i] = player.position.y;
+    had_ball[i] = holding;
+    seen[i] = 1;
+
+    if (const BasicPlayer<Rules>* opponent = player.Opponents[0]) {
+        if (player.position.distance_to(opponent->position) < near_radius) {
+            near_opponent_time[i] += dt;
+        }
+    }
+
+    if (player.possede_ball) {
+        possession_time[i] += dt;
+        if (number != holder) {
+            const int team = Rules::team_of(number);
+            if (holder >= 0 && holder_team == team) {
+                RecordPass(holder, number);
+            }
+            holder = number;
+            holder_team = team;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Compte une passe entre deux joueurs.
+ * @param passer Numéro du passeur.
+ * @param receiver Numéro du receveur.
+ */
+void PlayerStatsTable::RecordPass(int passer, int receiver) {
+    if (passer < 0 || receiver < 0) {
+        return;
+    }
+    Grow(static_cast<std::size_t>(std::max(passer, receiver)) + 1);
+    ++passes_made[passer];
+    ++passes_received[receiver];
+}
+
+/**
+ * @brief Ajoute les statistiques d'une autre table, colonne par colonne.
+ * @param other Table à ajouter.
+ */
+void PlayerStatsTable::Merge(const PlayerStatsTable& other) {
+    const std::size_t n = other.Size();
+    Grow(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        observations[i] += other.observations[i];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        possession_time[i] += other.possession_time[i];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        distance[i] += other.distance[i];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        near_opponent_time[i] += other.near_opponent_time[i];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        passes_made[i] += other.passes_made[i];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        passes_received[i] += other.passes_received[i];
+    }
+}
+
+/**
+ * @brief Efface les statistiques et l'état de suivi.
+ */
+void PlayerStatsTable::Clear() {
+    observations.clear();
+    possession_time.clear();
+    distance.clear();
+    near_opponent_time.clear();
+    passes_made.clear();
+    passes_received.clear();
+    last_x.clear();
+    last_y.clear();
+    seen.clear();
+    had_ball.clear();
+    holder = -1;
+    holder_team = -1;
+}
+
+/**
+ * @brief Oublie les positions et le porteur suivis.
+ */
+void PlayerStatsTable::Restart() {
+    std::fill(seen.begin(), seen.end(), std::uint8_t{0});
+    holder = -1;
+    holder_team = -1;
+}
+
+/**
+ * @brief Statistiques d'un joueur.
+ * @param number Numéro du joueur.
+ * @return Ses statistiques, nulles s'il n'a jamais été observé.
+ */
+PlayerStats PlayerStatsTable::Get(int number) const {
+    PlayerStats stats;
+    if (number < 0 || static_cast<std::size_t>(number) >= Size()) {
+        return stats;
+    }
+    const std::size_t i = static_cast<std::size_t>(number);
+    stats.observations = observations[i];
+    stats.possession_time = possession_time[i];
+    stats.distance = distance[i];
+    stats.near_opponent_time = near_opponent_time[i];
+    stats.passes_made = passes_made[i];
+    stats.passes_received = passes_received[i];
+    return stats;
+}
+
+/**
+ * @brief Agrandit toutes les colonnes.
+ * @param size Nouvelle taille minimale.
+ */
+void PlayerStatsTable::Grow(std::size_t size) {
+    if (size <= observations.size()) {
+        return;
+    }
+    observations.resize(size);
+    possession_time.resize(size);
+    distance.resize(size);
+    near_opponent_time.resize(size);
+    passes_made.resize(size);
+    passes_received.resize(size);
+    last_x.resize(size);
+    last_y.resize(size);
+    seen.resize(size);
+    had_ball.resize(size);
+}
+
+template bool PlayerStatsTable::Observe<Rules5x5>(const BasicPlayer<Rules5x5>&, float);
+template bool PlayerStatsTable::Observe<Rules3x3>(const BasicPlayer<Rules3x3>&, float);
+template bool PlayerStatsTable::Observe<RulesDrill2x2>(const BasicPlayer<RulesDrill2x2>&, float);
@@ -0,0 +1,136 @@
+/**
+ * @file player_stats.hpp
+ * @brief Statistiques cumulées par joueur, mises à jour en O(1) à chaque observation et fusionnables.
+ */
+
+#ifndef PLAYER_STATS_HPP
+#define PLAYER_STATS_HPP
+
+#include "rules.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template <class Rules>
+class BasicPlayer;
+
+/**
+ * @brief Statistiques d'un joueur, lues dans une PlayerStatsTable.
+ */
+struct PlayerStats {
+    std::uint64_t observations = 0; ///< Observations du joueur.
+    double possession_time = 0.0; ///< Temps passé avec le ballon.
+    double distance = 0.0; ///< Distance parcourue entre deux observations.
+    double near_opponent_time = 0.0; ///< Temps passé à moins de near_radius d'un adversaire.
+    std::uint32_t passes_made = 0; ///< Passes données à un coéquipier.
+    std::uint32_t passes_received = 0; ///< Passes reçues d'un coéquipier.
+};
+
+/**
+ * @brief Statistiques de tous les joueurs, rangées en colonnes indexées par Player::number.
+ *
+ * Chaque grandeur occupe un tableau contigu (structure de tableaux) : une observation
+ * touche une case par colonne, et Merge() additionne les colonnes deux à deux. Une
+ * table par match ou par worker, fusionnées à la fin d'un lot, évite tout partage entre
+ * threads.
+ *
+ * Une passe est comptée quand le ballon, d'une observation à l'autre, passe d'un joueur à
+ * un coéquipier (même Rules::team_of) ; un changement d'équipe est une perte de balle.
+ * Le temps est exprimé dans l'unité de dt : ticks par défaut.
+ */
+class PlayerStatsTable {
+public:
+    /**
+     * @brief Constructeur.
+     * @param near_radius Distance à l'adversaire le plus proche en deçà de laquelle un joueur est au contact.
+     */
+    explicit PlayerStatsTable(float near_radius = 2.f) : near_radius(near_radius) {}
+
+    /**
+     * @brief Ajoute une observation d'un joueur.
+     *
+     * L'adversaire le plus proche est `Opponents[0]` (tables remplies par le suivi des voisins).
+     * Les numéros négatifs sont ignorés ; la table s'agrandit jusqu'au plus grand numéro vu.
+     *
+     * @param player Joueur observé.
+     * @param dt Durée représentée par l'observation.
+     * @return True à la première observation du joueur ou s'il a pris ou perdu le ballon depuis la précédente.
+     */
+    template <class Rules>
+    bool Observe(const BasicPlayer<Rules>& player, float dt = 1.f);
+
+    /**
+     * @brief Compte une passe entre deux joueurs, sans passer par Observe().
+     * @param passer Numéro du passeur.
+     * @param receiver Numéro du receveur.
+     */
+    void RecordPass(int passer, int receiver);
+
+    /**
+     * @brief Ajoute les statistiques d'une autre table (résultats partiels d'un autre match ou worker).
+     *
+     * Les positions et le porteur suivis par Observe() ne sont pas fusionnés.
+     *
+     * @param other Table à ajouter.
+     */
+    void Merge(const PlayerStatsTable& other);
+
+    /**
+     * @brief Efface les statistiques et l'état de suivi.
+     */
+    void Clear();
+
+    /**
+     * @brief Oublie les positions et le porteur suivis, sans toucher aux statistiques.
+     *
+     * À appeler entre deux matchs observés par la même table.
+     */
+    void Restart();
+
+    /**
+     * @brief Statistiques d'un joueur.
+     * @param number Numéro du joueur.
+     * @return Ses statistiques, nulles s'il n'a jamais été observé.
+     */
+    PlayerStats Get(int number) const;
+
+    std::size_t Size() const { return observations.size(); } ///< Plus grand numéro observé + 1.
+    int Holder() const { return holder; } ///< Numéro du dernier porteur observé, -1 si aucun.
+    float NearRadius() const { return near_radius; } ///< Rayon de contact.
+
+    const std::vector<std::uint64_t>& Observations() const { return observations; } ///< Colonne des observations.
+    const std::vector<double>& PossessionTime() const { return possession_time; } ///< Colonne du temps de possession.
+    const std::vector<double>& Distance() const { return distance; } ///< Colonne des distances parcourues.
+    const std::vector<double>& NearOpponentTime() const { return near_opponent_time; } ///< Colonne du temps au contact.
+    const std::vector<std::uint32_t>& PassesMade() const { return passes_made; } ///< Colonne des passes données.
+    const std::vector<std::uint32_t>& PassesReceived() const { return passes_received; } ///< Colonne des passes reçues.
+
+private:
+    float near_radius; ///< Rayon de contact.
+    int holder = -1; ///< Dernier porteur observé.
+    int holder_team = -1; ///< Équipe du dernier porteur.
+
+    std::vector<std::uint64_t> observations; ///< Observations par joueur.
+    std::vector<double> possession_time; ///< Temps de possession par joueur.
+    std::vector<double> distance; ///< Distance parcourue par joueur.
+    std::vector<double> near_opponent_time; ///< Temps au contact par joueur.
+    std::vector<std::uint32_t> passes_made; ///< Passes données par joueur.
+    std::vector<std::uint32_t> passes_received; ///< Passes reçues par joueur.
+
+    std::vector<float> last_x; ///< Dernière abscisse observée.
+    std::vector<float> last_y; ///< Dernière ordonnée observée.
+    std::vector<std::uint8_t> seen; ///< 1 si last_x, last_y et had_ball sont valides.
+    std::vector<std::uint8_t> had_ball; ///< 1 si le joueur avait le ballon à sa dernière observation.
+
+    /**
+     * @brief Agrandit toutes les colonnes.
+     * @param size Nouvelle taille minimale.
+     */
+    void Grow(std::size_t size);
+};
+
+extern template bool PlayerStatsTable::Observe<Rules5x5>(const BasicPlayer<Rules5x5>&, float);
+extern template bool PlayerStatsTable::Observe<Rules3x3>(const BasicPlayer<Rules3x3>&, float);
+extern template bool PlayerStatsTable::Observe<RulesDrill2x2>(const BasicPlayer<RulesDrill2x2>&, float);
+
+#endif // PLAYER_STATS_HPP
@@ -0,0 +1,182 @@
+#include "result_export.hpp"
+#include "batch_runner.hpp"
+#include <cerrno>
+#include <sys/stat.h>
+#include <vector>
+
+namespace {
+
+using column_store::ColumnType;
+
+/**
+ * @brief Nom et type d'une colonne exportée.
+ */
+struct ExportColumn {
+    const char* name; ///< Nom complet, "table.colonne".
+    ColumnType type; ///< Type des valeurs.
+};
+
+/**
+ * @brief Colonnes de la table matches, dans l'ordre de ResultExporter::matches.
+ */
+constexpr ExportColumn kMatchTable[ResultExporter::kMatchColumns] = {
+    {"matches.match_id", ColumnType::Int64},
+    {"matches.home_score", ColumnType::Int64},
+    {"matches.away_score", ColumnType::Int64},
+    {"matches.ticks", ColumnType::Int64},
+    {"matches.home_strategy", ColumnType::String},
+    {"matches.away_strategy", ColumnType::String},
+};
+
+/**
+ * @brief Colonnes de la table players, dans l'ordre de ResultExporter::players.
+ */
+constexpr ExportColumn kPlayerTable[ResultExporter::kPlayerColumns] = {
+    {"players.match_id", ColumnType::Int64},
+    {"players.player", ColumnType::Int64},
+    {"players.observations", ColumnType::Int64},
+    {"players.possession_time", ColumnType::Float32},
+    {"players.distance", ColumnType::Float32},
+    {"players.near_opponent_time", ColumnType::Float32},
+    {"players.passes_made", ColumnType::Int64},
+    {"players.passes_received", ColumnType::Int64},
+};
+
+/**
+ * @brief Nom exporté d'une stratégie absente.
+ */
+constexpr const char* kNoStrategy = "none";
+
+} // namespace
+
+/**
+ * @brief Destructeur : ferme l'export s'il est ouvert.
+ */
+ResultExporter::~ResultExporter() {
+    Close();
+}
+
+/**
+ * @brief Crée le répertoire si besoin et ouvre toutes les colonnes.
+ * @param directory Répertoire de l'export.
+ * @return False si le répertoire ou une colonne n'a pas pu être créé.
+ */
+bool ResultExporter::Open(const std::string& directory) {
+    Close();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        return false;
+    }
+    this->directory = directory;
+    bool opened = true;
+    for (int i = 0; i < kMatchColumns; ++i) {
+        opened = opened && matches[i].Open(ColumnPath(directory, kMatchTable[i].name), kMatchTable[i].name,
+                                           kMatchTable[i].type);
+    }
+    for (int i = 0; i < kPlayerColumns; ++i) {
+        opened = opened && players[i].Open(ColumnPath(directory, kPlayerTable[i].name), kPlayerTable[i].name,
+                                           kPlayerTable[i].type);
+    }
+    if (!opened) {
+        for (ColumnWriter& column : matches) {
+            column.Close();
+        }
+        for (ColumnWriter& column : players) {
+            column.Close();
+        }
+        return false;
+    }
+    open = true;
+    ok = true;
+    return true;
+}
+
+/**
+ * @brief Ajoute un match terminé et les statistiques de ses joueurs.
+ * @param result Résultat du match.
+ * @param home_strategy Stratégie de l'équipe à domicile, ou nullptr.
+ * @param away_strategy Stratégie de l'équipe adverse, ou nullptr.
+ * @param stats Statistiques des joueurs de ce seul match.
+ * @return False si l'export n'est pas ouvert ou si une écriture a échoué.
+ */
+bool ResultExporter::Append(const MatchResult& result, const char* home_strategy, const char* away_strategy,
+                            const PlayerStatsTable& stats) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!open) {
+        return false;
+    }
+    const std::int64_t id = static_cast<std::int64_t>(result.match_id);
+    ok = matches[0].AppendInt(id) && ok;
+    ok = matches[1].AppendInt(result.homeScore) && ok;
+    ok = matches[2].AppendInt(result.awayScore) && ok;
+    ok = matches[3].AppendInt(static_cast<std::int64_t>(result.ticks)) && ok;
+    ok = matches[4].AppendString(home_strategy ? home_strategy : kNoStrategy) && ok;
+    ok = matches[5].AppendString(away_strategy ? away_strategy : kNoStrategy) && ok;
+
+    for (std::size_t number = 0; number < stats.Size(); ++number) {
+        const PlayerStats row = stats.Get(static_cast<int>(number));
+        if (row.observations == 0) {
+            continue;
+        }
+        ok = players[0].AppendInt(id) && ok;
+        ok = players[1].AppendInt(static_cast<std::int64_t>(number)) && ok;
+        ok = players[2].AppendInt(static_cast<std::int64_t>(row.observations)) && ok;
+        ok = players[3].AppendFloat(static_cast<float>(row.possession_time)) && ok;
+        ok = players[4].AppendFloat(static_cast<float>(row.distance)) && ok;
+        ok = players[5].AppendFloat(static_cast<float>(row.near_opponent_time)) && ok;
+        ok = players[6].AppendInt(row.passes_made) && ok;
+        ok = players[7].AppendInt(row.passes_received) && ok;
+    }
+    return ok;
+}
+
+/**
+ * @brief Ferme toutes les colonnes et écrit le schéma.
+ * @return True si toutes les écritures ont réussi.
+ */
+bool ResultExporter::Close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!open) {
+        return false;
+    }
+    std::vector<ColumnSchema> schema;
+    for (int i = 0; i < kMatchColumns; ++i) {
+        ok = matches[i].Close() && ok;
+        schema.push_back(ColumnSchema{kMatchTable[i].name, kMatchTable[i].type, matches[i].Stats().rows});
+    }
+    for (int i = 0; i < kPlayerColumns; ++i) {
+        ok = players[i].Close() && ok;
+        schema.push_back(ColumnSchema{kPlayerTable[i].name, kPlayerTable[i].type, players[i].Stats().rows});
+    }
+    ok = WriteColumnSchema(directory + "/schema.bin", schema) && ok;
+    open = false;
+    return ok;
+}
+
+/**
+ * @brief Chemin du fichier d'une colonne.
+ * @param directory Répertoire de l'export.
+ * @param column Nom complet de la colonne.
+ * @return Le chemin.
+ */
+std::string ResultExporter::ColumnPath(const std::string& directory, const std::string& column) {
+    return directory + "/" + column + ".col";
+}
+
+/**
+ * @brief Matchs ajoutés.
+ * @return Le nombre de lignes de la table matches.
+ */
+std::uint64_t ResultExporter::Matches() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return matches[0].Stats().rows;
+}
+
+/**
+ * @brief Lignes de joueurs ajoutées.
+ * @return Le nombre de lignes de la table players.
+ */
+std::uint64_t ResultExporter::PlayerRows() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return players[0].Stats().rows;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file result_export.hpp
+ * @brief Export colonnaire des résultats d'un lot de matchs : scores, stratégies et statistiques des joueurs.
+ */
+
+#ifndef RESULT_EXPORT_HPP
+#define RESULT_EXPORT_HPP
+
+#include "column_store.hpp"
+#include "player_stats.hpp"
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+struct MatchResult;
+
+/**
+ * @brief Écrit les résultats d'un lot en colonnes, au fil des matchs terminés.
+ *
+ * Deux tables dans un répertoire, un fichier par colonne :
+ * - matches : match_id, home_score, away_score, ticks, home_strategy, away_strategy ;
+ * - players : match_id, player, observations, possession_time, distance,
+ *   near_opponent_time, passes_made, passes_received (une ligne par joueur observé).
+ * Le fichier de la colonne "table.colonne" est "table.colonne.col" ; Close() écrit
+ * "schema.bin" (WriteColumnSchema()). Les durées et distances sont arrondies en float.
+ *
+ * Append() est thread-safe : les workers d'un lot y versent chaque match terminé, dans
+ * l'ordre d'achèvement. Seul le bloc en cours de chaque colonne reste en mémoire.
+ */
+class ResultExporter {
+public:
+    ResultExporter() = default; ///< Constructeur par défaut.
+
+    /**
+     * @brief Destructeur : ferme l'export s'il est ouvert.
+     */
+    ~ResultExporter();
+
+    ResultExporter(const ResultExporter&) = delete; ///< Non copiable.
+    ResultExporter& operator=(const ResultExporter&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Crée le répertoire si besoin et ouvre toutes les colonnes.
+     * @param directory Répertoire de l'export.
+     * @return False si le répertoire ou une colonne n'a pas pu être créé.
+     */
+    bool Open(const std::string& directory);
+
+    /**
+     * @brief Ajoute un match terminé et les statistiques de ses joueurs.
+     * @param result Résultat du match.
+     * @param home_strategy Stratégie de l'équipe à domicile (Strategy::Name()), ou nullptr.
+     * @param away_strategy Stratégie de l'équipe adverse, ou nullptr.
+     * @param stats Statistiques des joueurs de ce seul match ; les numéros jamais observés sont omis.
+     * @return False si l'export n'est pas ouvert ou si une écriture a échoué.
+     */
+    bool Append(const MatchResult& result, const char* home_strategy, const char* away_strategy,
+                const PlayerStatsTable& stats);
+
+    /**
+     * @brief Ferme toutes les colonnes et écrit le schéma.
+     * @return True si toutes les écritures ont réussi.
+     */
+    bool Close();
+
+    /**
+     * @brief Chemin du fichier d'une colonne.
+     * @param directory Répertoire de l'export.
+     * @param column Nom complet de la colonne, par exemple "matches.home_score".
+     * @return Le chemin.
+     */
+    static std::string ColumnPath(const std::string& directory, const std::string& column);
+
+    bool IsOpen() const { return open; } ///< Indique si l'export est ouvert.
+    std::uint64_t Matches() const; ///< Matchs ajoutés.
+    std::uint64_t PlayerRows() const; ///< Lignes de joueurs ajoutées.
+
+    static constexpr int kMatchColumns = 6; ///< Colonnes de la table matches.
+    static constexpr int kPlayerColumns = 8; ///< Colonnes de la table players.
+
+private:
+    mutable std::mutex mutex; ///< Sérialise les ajouts.
+    std::string directory; ///< Répertoire de l'export.
+    bool open = false; ///< Export ouvert.
+    bool ok = true; ///< Faux après un échec d'écriture.
+    ColumnWriter matches[kMatchColumns]; ///< Colonnes de la table matches.
+    ColumnWriter players[kPlayerColumns]; ///< Colonnes de la table players.
+};
+
+#endif // RESULT_EXPORT_HPP
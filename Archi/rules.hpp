@@ -0,0 +1,65 @@
+/**
+ * @file rules.hpp
+ * @brief Règles de jeu fixées à la compilation : taille des équipes et dimensions du terrain.
+ */
+
+#ifndef RULES_HPP
+#define RULES_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Règles d'une variante de jeu, entièrement connues à la compilation.
+ *
+ * Les joueurs sont numérotés de 0 à players - 1 ; l'équipe d'un joueur est
+ * `number / team_size`. Les tables de voisins en découlent : team_size - 1 coéquipiers
+ * et team_size adversaires, si bien que la numérotation et la taille des tables ne
+ * peuvent plus diverger.
+ *
+ * @tparam TeamSize Nombre de joueurs par équipe (au moins 2).
+ * @tparam CourtX Largeur du terrain (axe des paniers).
+ * @tparam CourtY Hauteur du terrain.
+ */
+template <int TeamSize, int CourtX, int CourtY>
+struct GameRules {
+    static_assert(TeamSize >= 2, "Une équipe compte au moins deux joueurs");
+    static_assert(CourtX > 0 && CourtY > 0, "Dimensions de terrain invalides");
+
+    static constexpr int team_size = TeamSize; ///< Joueurs par équipe.
+    static constexpr int teams = 2; ///< Nombre d'équipes.
+    static constexpr int players = teams * TeamSize; ///< Joueurs sur le terrain.
+    static constexpr int teammates = TeamSize - 1; ///< Taille de la table des coéquipiers.
+    static constexpr int opponents = TeamSize; ///< Taille de la table des adversaires.
+    static constexpr float court_x = static_cast<float>(CourtX); ///< Largeur du terrain.
+    static constexpr float court_y = static_cast<float>(CourtY); ///< Hauteur du terrain.
+
+    /**
+     * @brief Équipe d'un joueur d'après son numéro.
+     * @param number Numéro du joueur.
+     * @return L'identifiant de l'équipe.
+     */
+    static constexpr int team_of(int number) { return number / TeamSize; }
+};
+
+using Rules5x5 = GameRules<5, 100, 50>; ///< Match classique (dimensions historiques du simulateur).
+using Rules3x3 = GameRules<3, 15, 11>; ///< Basket 3x3 sur demi-terrain FIBA.
+using RulesDrill2x2 = GameRules<2, 15, 11>; ///< Exercice d'entraînement à deux contre deux.
+
+/**
+ * @brief Appelle @p f avec chaque indice de 0 à N - 1, boucle déroulée à la compilation.
+ *
+ * L'indice est passé sous forme de std::integral_constant, utilisable comme une constante.
+ *
+ * @tparam N Nombre d'itérations.
+ * @param f Corps de la boucle.
+ */
+template <std::size_t N, typename F>
+constexpr void unrolled(F&& f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+#endif // RULES_HPP
@@ -0,0 +1,294 @@
+#include "score_notifier.hpp"
+
+namespace {
+
+/**
+ * @brief Arrondit à la puissance de deux supérieure (au moins 2).
+ */
+std::size_t round_up_pow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+constexpr std::uint64_t kPendingOccupied = std::uint64_t{1} << 63; ///< Bit levé dans tout score fusionné en attente.
+constexpr std::uint32_t kSequenceMask = 0x7fffffffu; ///< Séquence d'un score fusionné : 31 bits.
+constexpr int kMaxPackedScore = 0xffff; ///< Plus grand score d'un score fusionné : 16 bits.
+
+/**
+ * @brief Indique si un événement tient dans un mot sans perte (scores dans [0, kMaxPackedScore]).
+ */
+bool packable(const ScoreEvent& e) {
+    return e.homeScore >= 0 && e.homeScore <= kMaxPackedScore && e.awayScore >= 0 && e.awayScore <= kMaxPackedScore;
+}
+
+/**
+ * @brief Regroupe un événement en un mot : bit d'occupation, scores sur 16 bits chacun,
+ * séquence sur 31 bits. Le mot n'est jamais nul, même pour 0-0 : 0 reste la valeur « aucun ».
+ * @pre packable(e).
+ */
+std::uint64_t pack_event(const ScoreEvent& e) {
+    return kPendingOccupied | (static_cast<std::uint64_t>(e.homeScore) << 47) |
+           (static_cast<std::uint64_t>(e.awayScore) << 31) | (e.sequence & kSequenceMask);
+}
+
+/**
+ * @brief Décode un événement regroupé par pack_event().
+ */
+ScoreEvent unpack_event(std::uint64_t packed) {
+    return ScoreEvent{static_cast<int>((packed >> 47) & 0xffff), static_cast<int>((packed >> 31) & 0xffff),
+                      packed & kSequenceMask};
+}
+
+/**
+ * @brief Compare deux numéros de séquence tronqués à 31 bits, en tenant compte du rebouclage.
+ */
+bool newer(std::uint64_t a, std::uint64_t b) {
+    const std::uint32_t distance = static_cast<std::uint32_t>(a - b) & kSequenceMask;
+    return distance != 0 && distance <= kSequenceMask / 2;
+}
+
+} // namespace
+
+/**
+ * @brief Constructeur.
+ * @param capacity Capacité demandée, arrondie à la puissance de deux supérieure.
+ */
+ScoreEventQueue::ScoreEventQueue(std::size_t capacity)
+    : mask(round_up_pow2(capacity) - 1), cells(new Cell[mask + 1]) {
+    for (std::size_t i = 0; i <= mask; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Dépose un événement (producteurs multiples).
+ * @param event Événement à déposer.
+ * @return False si la file est pleine.
+ */
+bool ScoreEventQueue::TryPush(const ScoreEvent& event) {
+    std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Retire un événement (consommateur unique).
+ * @param event Événement retiré.
+ * @return False si la file est vide.
+ */
+bool ScoreEventQueue::TryPop(ScoreEvent& event) {
+    const std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    Cell& cell = cells[pos & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;
+    }
+    event = cell.event;
+    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+    dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Nombre approximatif d'événements en attente.
+ * @return La profondeur de la file.
+ */
+std::size_t ScoreEventQueue::Depth() const {
+    const std::size_t head = dequeue_pos.load(std::memory_order_relaxed);
+    const std::size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+}
+
+/**
+ * @brief Constructeur démarrant le thread consommateur.
+ * @param capacity Capacité de la file.
+ * @param policy Politique en cas de file pleine.
+ * @param batch_size Nombre maximal d'événements par lot.
+ */
+AsyncNotifier::AsyncNotifier(std::size_t capacity, BackPressure policy, std::size_t batch_size)
+    : queue(capacity), policy(policy), batch(batch_size ? batch_size : 1) {
+    consumer = std::thread(&AsyncNotifier::Consume, this);
+}
+
+/**
+ * @brief Destructeur : livre les événements restants puis arrête le consommateur.
+ */
+AsyncNotifier::~AsyncNotifier() {
+    stopping.store(true, std::memory_order_release);
+    Wake();
+    consumer.join();
+}
+
+/**
+ * @brief Remplace la liste des arbitres notifiés.
+ * @param list Nouvelle liste d'arbitres.
+ */
+void AsyncNotifier::SetObservers(const std::vector<std::shared_ptr<Arbitre>>& list) {
+    std::lock_guard<std::mutex> lock(observers_mutex);
+    observers = list;
+}
+
+/**
+ * @brief Publie un score (appelable depuis plusieurs threads).
+ * @param homeScore Score de l'équipe à domicile.
+ * @param awayScore Score de l'équipe adverse.
+ */
+void AsyncNotifier::Publish(int homeScore, int awayScore) {
+    const ScoreEvent event{homeScore, awayScore, sequence.fetch_add(1, std::memory_order_relaxed) + 1};
+    published.fetch_add(1, std::memory_order_relaxed);
+
+    // Un score qui ne tient pas dans pending ne peut pas être fusionné : il attend une place
+    const bool block = policy == BackPressure::Block || (policy == BackPressure::Coalesce && !packable(event));
+    bool pushed = queue.TryPush(event);
+    if (!pushed && block) {
+        do {
+            Wake();
+            std::this_thread::yield();
+        } while (!queue.TryPush(event));
+        pushed = true;
+    }
+
+    if (pushed) {
+        accepted.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t depth = queue.Depth();
+        std::size_t seen = max_depth.load(std::memory_order_relaxed);
+        while (depth > seen && !max_depth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+        }
+    } else if (policy == BackPressure::Drop) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    } else {
+        const std::uint64_t packed = pack_event(event);
+        std::uint64_t current = pending.load(std::memory_order_relaxed);
+        do {
+            if (current != 0 && !newer(packed, current)) {
+                coalesced.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        } while (!pending.compare_exchange_weak(current, packed, std::memory_order_acq_rel));
+        if (current == 0) {
+            accepted.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            coalesced.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    Wake();
+}
+
+/**
+ * @brief Attend que tous les événements acceptés aient été livrés.
+ */
+void AsyncNotifier::Flush() {
+    for (;;) {
+        const std::uint64_t target = accepted.load(std::memory_order_acquire);
+        if (consumed.load(std::memory_order_acquire) >= target && pending.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+        Wake();
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Réveille le consommateur.
+ */
+void AsyncNotifier::Wake() {
+    signal.fetch_add(1, std::memory_order_release);
+    signal.notify_one();
+}
+
+/**
+ * @brief Boucle du thread consommateur : vide la file, puis s'endort jusqu'au prochain dépôt.
+ */
+void AsyncNotifier::Consume() {
+    for (;;) {
+        const std::uint64_t observed = signal.load(std::memory_order_acquire);
+        if (DrainOnce()) {
+            continue;
+        }
+        if (stopping.load(std::memory_order_acquire)) {
+            while (DrainOnce()) {
+            }
+            return;
+        }
+        signal.wait(observed, std::memory_order_acquire);
+    }
+}
+
+/**
+ * @brief Vide la file et le score fusionné en attente, par lots.
+ *
+ * Le score fusionné n'est livré que s'il est plus récent que le dernier événement livré.
+ *
+ * @return True si au moins un événement a été traité.
+ */
+bool AsyncNotifier::DrainOnce() {
+    bool progressed = false;
+    std::size_t count = 0;
+    while (count < batch.size() && queue.TryPop(batch[count])) {
+        ++count;
+    }
+
+    if (count < batch.size()) {
+        const std::uint64_t packed = pending.exchange(0, std::memory_order_acq_rel);
+        if (packed != 0) {
+            const ScoreEvent latest = unpack_event(packed);
+            std::uint64_t newest = last_sequence;
+            for (std::size_t i = 0; i < count; ++i) {
+                newest = newer(batch[i].sequence, newest) ? batch[i].sequence : newest;
+            }
+            if (newer(latest.sequence, newest)) {
+                batch[count++] = latest;
+            } else {
+                consumed.fetch_add(1, std::memory_order_release);
+                coalesced.fetch_add(1, std::memory_order_relaxed);
+                progressed = true;
+            }
+        }
+    }
+
+    if (count > 0) {
+        Deliver(count);
+        progressed = true;
+    }
+    return progressed;
+}
+
+/**
+ * @brief Livre un lot aux arbitres.
+ * @param count Nombre d'événements du tampon à livrer.
+ */
+void AsyncNotifier::Deliver(std::size_t count) {
+    {
+        std::lock_guard<std::mutex> lock(observers_mutex);
+        for (auto& observer : observers) {
+            observer->UpdateBatch(batch.data(), count);
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (newer(batch[i].sequence, last_sequence)) {
+            last_sequence = batch[i].sequence;
+        }
+    }
+    batches.fetch_add(1, std::memory_order_relaxed);
+    delivered.fetch_add(count, std::memory_order_relaxed);
+    consumed.fetch_add(count, std::memory_order_release);
+}
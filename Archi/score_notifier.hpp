@@ -0,0 +1,174 @@
+/**
+ * @file score_notifier.hpp
+ * @brief Notification asynchrone et groupée des arbitres via une file sans verrou.
+ */
+
+#ifndef SCORE_NOTIFIER_HPP
+#define SCORE_NOTIFIER_HPP
+
+#include "basket.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief File circulaire bornée multi-producteurs / mono-consommateur, sans verrou.
+ *
+ * Chaque case porte un numéro de séquence indiquant si elle est libre ou pleine
+ * (schéma de D. Vyukov) : les producteurs réservent une case par compare-and-swap,
+ * le consommateur la libère par une simple écriture atomique.
+ */
+class ScoreEventQueue {
+public:
+    /**
+     * @brief Constructeur.
+     * @param capacity Capacité demandée, arrondie à la puissance de deux supérieure.
+     */
+    explicit ScoreEventQueue(std::size_t capacity);
+
+    /**
+     * @brief Dépose un événement (producteurs multiples).
+     * @param event Événement à déposer.
+     * @return False si la file est pleine.
+     */
+    bool TryPush(const ScoreEvent& event);
+
+    /**
+     * @brief Retire un événement (consommateur unique).
+     * @param event Événement retiré.
+     * @return False si la file est vide.
+     */
+    bool TryPop(ScoreEvent& event);
+
+    /**
+     * @brief Nombre approximatif d'événements en attente.
+     * @return La profondeur de la file.
+     */
+    std::size_t Depth() const;
+
+    /**
+     * @brief Capacité effective de la file.
+     * @return Le nombre de cases.
+     */
+    std::size_t Capacity() const { return mask + 1; }
+
+private:
+    /**
+     * @brief Case de la file.
+     */
+    struct Cell {
+        std::atomic<std::size_t> sequence; ///< État de la case.
+        ScoreEvent event; ///< Événement stocké.
+    };
+
+    std::size_t mask; ///< Capacité - 1.
+    std::unique_ptr<Cell[]> cells; ///< Cases de la file.
+    alignas(64) std::atomic<std::size_t> enqueue_pos{0}; ///< Prochaine case à réserver.
+    alignas(64) std::atomic<std::size_t> dequeue_pos{0}; ///< Prochaine case à lire.
+};
+
+/**
+ * @brief Livre les événements de score aux arbitres par lots, sur un thread consommateur.
+ *
+ * Publish() ne fait qu'un dépôt dans la file : le thread de simulation n'attend jamais
+ * les entrées-sorties des arbitres. En cas de file pleine, la politique BackPressure
+ * choisit entre abandon, attente ou fusion vers le score le plus récent. Le score fusionné
+ * tient dans un mot atomique (scores sur 16 bits, séquence sur 31 bits) : avec Coalesce,
+ * un score hors de [0, 65535] attend une place dans la file comme avec Block.
+ */
+class AsyncNotifier {
+public:
+    /**
+     * @brief Constructeur démarrant le thread consommateur.
+     * @param capacity Capacité de la file.
+     * @param policy Politique en cas de file pleine.
+     * @param batch Nombre maximal d'événements par lot.
+     */
+    AsyncNotifier(std::size_t capacity, BackPressure policy, std::size_t batch);
+
+    /**
+     * @brief Destructeur : livre les événements restants puis arrête le consommateur.
+     */
+    ~AsyncNotifier();
+
+    AsyncNotifier(const AsyncNotifier&) = delete; ///< Non copiable.
+    AsyncNotifier& operator=(const AsyncNotifier&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Remplace la liste des arbitres notifiés.
+     * @param observers Nouvelle liste d'arbitres.
+     */
+    void SetObservers(const std::vector<std::shared_ptr<Arbitre>>& observers);
+
+    /**
+     * @brief Publie un score (appelable depuis plusieurs threads).
+     * @param homeScore Score de l'équipe à domicile.
+     * @param awayScore Score de l'équipe adverse.
+     */
+    void Publish(int homeScore, int awayScore);
+
+    /**
+     * @brief Attend que tous les événements acceptés aient été livrés.
+     */
+    void Flush();
+
+    std::size_t QueueDepth() const { return queue.Depth(); } ///< Événements en attente dans la file.
+    std::uint64_t Published() const { return published.load(std::memory_order_relaxed); } ///< Événements publiés.
+    std::uint64_t Delivered() const { return delivered.load(std::memory_order_relaxed); } ///< Événements livrés.
+    std::uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); } ///< Événements abandonnés.
+    std::uint64_t Coalesced() const { return coalesced.load(std::memory_order_relaxed); } ///< Événements fusionnés.
+    std::uint64_t Batches() const { return batches.load(std::memory_order_relaxed); } ///< Lots livrés.
+    std::size_t MaxDepth() const { return max_depth.load(std::memory_order_relaxed); } ///< Profondeur maximale observée.
+    BackPressure Policy() const { return policy; } ///< Politique en cas de file pleine.
+
+private:
+    ScoreEventQueue queue; ///< File des événements.
+    BackPressure policy; ///< Politique en cas de file pleine.
+    std::vector<ScoreEvent> batch; ///< Tampon du consommateur, alloué une fois.
+
+    std::mutex observers_mutex; ///< Protège la liste des arbitres (côté consommateur seulement).
+    std::vector<std::shared_ptr<Arbitre>> observers; ///< Arbitres notifiés.
+
+    std::atomic<std::uint64_t> sequence{0}; ///< Numéro du prochain événement.
+    std::atomic<std::uint64_t> pending{0}; ///< Score fusionné en attente (Coalesce, bit 63 levé), 0 si aucun.
+    std::atomic<std::uint64_t> signal{0}; ///< Compteur sur lequel le consommateur s'endort.
+    std::atomic<std::uint64_t> accepted{0}; ///< Événements entrés dans la file ou fusionnés.
+    std::atomic<std::uint64_t> consumed{0}; ///< Événements sortis de la file ou remplacés.
+    std::atomic<std::uint64_t> published{0}; ///< Compteur d'événements publiés.
+    std::atomic<std::uint64_t> delivered{0}; ///< Compteur d'événements livrés.
+    std::atomic<std::uint64_t> dropped{0}; ///< Compteur d'événements abandonnés.
+    std::atomic<std::uint64_t> coalesced{0}; ///< Compteur d'événements fusionnés.
+    std::atomic<std::uint64_t> batches{0}; ///< Compteur de lots livrés.
+    std::atomic<std::size_t> max_depth{0}; ///< Profondeur maximale observée.
+    std::atomic<bool> stopping{false}; ///< Demande d'arrêt du consommateur.
+    std::uint64_t last_sequence = 0; ///< Dernier numéro livré (consommateur).
+    std::thread consumer; ///< Thread consommateur.
+
+    /**
+     * @brief Boucle du thread consommateur.
+     */
+    void Consume();
+
+    /**
+     * @brief Vide la file et le score fusionné en attente, par lots.
+     * @return True si au moins un événement a été traité.
+     */
+    bool DrainOnce();
+
+    /**
+     * @brief Livre un lot aux arbitres.
+     * @param count Nombre d'événements du tampon à livrer.
+     */
+    void Deliver(std::size_t count);
+
+    /**
+     * @brief Réveille le consommateur.
+     */
+    void Wake();
+};
+
+#endif // SCORE_NOTIFIER_HPP
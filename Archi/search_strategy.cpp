@@ -0,0 +1,299 @@
+#include "search_strategy.hpp"
+#include "output_sink.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Observateur relançant la décision quand l'équipe conseillée récupère le ballon.
+ */
+template <class Rules>
+class BasicSearchStrategy<Rules>::PossessionObserver : public GameObserver {
+public:
+    PossessionObserver(BasicSearchStrategy& owner, MatchType& match, int team)
+        : owner(owner), match(match), team(team) {}
+
+    void OnEvent(const GameEvent& event) override {
+        if (event.type == EventType::Possession && event.team == team) {
+            owner.Decide(match, team);
+        }
+    }
+
+private:
+    BasicSearchStrategy& owner; ///< Stratégie à relancer.
+    MatchType& match; ///< Match suivi.
+    int team; ///< Équipe conseillée.
+};
+
+/**
+ * @brief Constructeur : alloue les arbres et un match de travail par worker.
+ * @param pool Pool de threads des simulations.
+ * @param actions Stratégies concrètes parmi lesquelles choisir.
+ * @param config Paramètres de la recherche.
+ * @param match_config Paramètres de simulation.
+ */
+template <class Rules>
+BasicSearchStrategy<Rules>::BasicSearchStrategy(WorkStealingPool& pool, std::vector<Strategy*> actions,
+                                                const SearchConfig& config, const MatchConfig& match_config)
+    : pool(pool), actions(std::move(actions)), config(config), trees(std::max(config.trees, 1)) {
+    this->config.trees = static_cast<int>(trees.size());
+    this->config.max_depth = std::clamp(this->config.max_depth, 1, kMaxSearchDepth);
+    this->config.rollout_segments = std::clamp(this->config.rollout_segments, 1, kMaxSearchDepth);
+    this->config.max_nodes = std::max(this->config.max_nodes, 1 + static_cast<int>(this->actions.size()));
+    scratch.reserve(pool.Size());
+    for (unsigned i = 0; i < pool.Size(); ++i) {
+        scratch.push_back(std::make_unique<MatchType>(match_config));
+    }
+    for (Tree& tree : trees) {
+        tree.nodes.resize(this->config.max_nodes);
+    }
+}
+
+/**
+ * @brief Destructeur : se désabonne du match suivi.
+ */
+template <class Rules>
+BasicSearchStrategy<Rules>::~BasicSearchStrategy() {
+    Detach();
+}
+
+/**
+ * @brief Cherche la meilleure action pour une équipe depuis l'état courant d'un match.
+ * @param match Match joué.
+ * @param team Équipe à conseiller.
+ * @return L'action retenue, ou nullptr sans action.
+ */
+template <class Rules>
+Strategy* BasicSearchStrategy<Rules>::Decide(const MatchType& match, int team) {
+    if (actions.empty()) {
+        return nullptr;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    root = match.snapshot();
+    this->team = team;
+    theirs = match.coach(1 - team).GetStrategy();
+    if (theirs == this) {
+        theirs = chosen;
+    }
+    timed = config.time_budget_ms > 0.0;
+    deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double, std::milli>(config.time_budget_ms));
+
+    for (std::size_t i = 0; i < trees.size(); ++i) {
+        Tree& tree = trees[i];
+        tree.nodes[0] = Node{-1, -1, 0, 0.0};
+        tree.used = 1;
+        tree.depth = 0;
+        tree.rollouts = 0;
+        tree.stream = CounterStream(KeyFor(root.seed, root.match_id), static_cast<std::uint32_t>(i),
+                                    static_cast<std::uint32_t>(root.ticks), RandomStream::Search);
+    }
+
+    const auto grow = [this](std::size_t index, unsigned worker) {
+        const std::uint64_t total = config.rollouts > 0 ? config.rollouts : (timed ? 0 : trees.size());
+        const std::uint64_t share = total / trees.size() + (index < total % trees.size() ? 1 : 0);
+        if (total == 0 || share > 0) {
+            Grow(index, worker, share);
+        }
+    };
+    // Pool occupé (match joué sur un de ses workers, ou autre décision en cours) : recherche
+    // sur le thread appelant, avec le match de travail du worker 0
+    if (!pool.TryParallelFor(trees.size(), grow)) {
+        for (std::size_t i = 0; i < trees.size(); ++i) {
+            grow(i, 0);
+        }
+    }
+
+    // Fusion des arbres à la racine : l'action la plus visitée l'emporte
+    int best = 0;
+    std::uint32_t best_visits = 0;
+    double best_value = 0.0;
+    stats = SearchStats();
+    for (int a = 0; a < static_cast<int>(actions.size()); ++a) {
+        std::uint32_t visits = 0;
+        double value = 0.0;
+        for (const Tree& tree : trees) {
+            if (tree.nodes[0].first_child >= 0) {
+                const Node& child = tree.nodes[tree.nodes[0].first_child + a];
+                visits += child.visits;
+                value += child.value;
+            }
+        }
+        const double mean = visits ? value / visits : 0.0;
+        if (a == 0 || visits > best_visits || (visits == best_visits && mean > best_value)) {
+            best = a;
+            best_visits = visits;
+            best_value = mean;
+        }
+    }
+    for (const Tree& tree : trees) {
+        stats.rollouts += tree.rollouts;
+        stats.depth = std::max(stats.depth, tree.depth);
+    }
+
+    chosen = actions[best];
+    ++decisions;
+    stats.chosen = best;
+    stats.value = best_value;
+    stats.visits = best_visits;
+    stats.elapsed_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.rollouts_per_second = stats.elapsed_ms > 0.0 ? stats.rollouts * 1000.0 / stats.elapsed_ms : 0.0;
+    return chosen;
+}
+
+/**
+ * @brief Développe un arbre jusqu'à épuisement de son budget.
+ * @param index Indice de l'arbre.
+ * @param worker Worker exécutant la recherche.
+ * @param budget Nombre de simulations (0 : limite de temps seule).
+ */
+template <class Rules>
+void BasicSearchStrategy<Rules>::Grow(std::size_t index, unsigned worker, std::uint64_t budget) {
+    Tree& tree = trees[index];
+    MatchType& match = *scratch[worker];
+    do {
+        Iterate(tree, match);
+    } while ((budget == 0 || tree.rollouts < budget) && (!timed || std::chrono::steady_clock::now() < deadline));
+}
+
+/**
+ * @brief Une itération MCTS.
+ *
+ * Sélection UCT tant que le nœud est développé, développement du premier nœud qui ne
+ * l'est pas (tous ses enfants à la fois), puis actions au hasard jusqu'à
+ * rollout_segments segments. Le gain d'écart au score est ajouté à tout le chemin.
+ *
+ * @param tree Arbre développé.
+ * @param match Match de travail.
+ */
+template <class Rules>
+void BasicSearchStrategy<Rules>::Iterate(Tree& tree, MatchType& match) {
+    const int count = static_cast<int>(actions.size());
+    State start = root;
+    start.seed = tree.stream.Next();
+    match.restore(start);
+    match.coach(1 - team).SetStrategy(theirs);
+
+    int path[kMaxSearchDepth + 1];
+    int length = 0;
+    int node = 0;
+    path[length++] = node;
+    int depth = 0;
+    while (depth < config.max_depth) {
+        Node& current = tree.nodes[node];
+        if (current.first_child < 0) {
+            if (tree.used + count > config.max_nodes) {
+                break;
+            }
+            current.first_child = tree.used;
+            for (int a = 0; a < count; ++a) {
+                tree.nodes[tree.used++] = Node{-1, a, 0, 0.0};
+            }
+            node = current.first_child + static_cast<int>(tree.stream.Below(count));
+            PlaySegment(match, tree.nodes[node].action);
+            path[length++] = node;
+            ++depth;
+            break;
+        }
+
+        const double log_visits = std::log(static_cast<double>(current.visits ? current.visits : 1));
+        int best = -1;
+        double best_score = 0.0;
+        for (int a = 0; a < count; ++a) {
+            const Node& child = tree.nodes[current.first_child + a];
+            if (child.visits == 0) {
+                best = current.first_child + a;
+                break;
+            }
+            const double score = child.value / child.visits / config.reward_scale +
+                                 config.exploration * std::sqrt(log_visits / child.visits);
+            if (best < 0 || score > best_score) {
+                best = current.first_child + a;
+                best_score = score;
+            }
+        }
+        node = best;
+        PlaySegment(match, tree.nodes[node].action);
+        path[length++] = node;
+        ++depth;
+    }
+    tree.depth = std::max(tree.depth, depth);
+
+    for (; depth < config.rollout_segments; ++depth) {
+        PlaySegment(match, static_cast<int>(tree.stream.Below(count)));
+    }
+
+    const ScoreSnapshot end = match.live_score().Snapshot();
+    const int margin = (end.home - end.away) - (root.home - root.away);
+    const double reward = team == 0 ? margin : -margin;
+    for (int i = 0; i < length; ++i) {
+        Node& visited = tree.nodes[path[i]];
+        ++visited.visits;
+        visited.value += reward;
+    }
+    ++tree.rollouts;
+}
+
+/**
+ * @brief Joue un segment avec une action.
+ * @param match Match de travail.
+ * @param action Indice de l'action.
+ */
+template <class Rules>
+void BasicSearchStrategy<Rules>::PlaySegment(MatchType& match, int action) {
+    match.coach(team).SetStrategy(actions[action]);
+    for (int i = 0; i < config.segment_ticks; ++i) {
+        match.tick();
+    }
+}
+
+/**
+ * @brief Relance Decide() chaque fois que l'équipe récupère le ballon.
+ * @param match Match joué.
+ * @param team Équipe conseillée.
+ */
+template <class Rules>
+void BasicSearchStrategy<Rules>::Attach(MatchType& match, int team) {
+    Detach();
+    attached = &match.events();
+    subscription =
+        attached->Subscribe(std::make_shared<PossessionObserver>(*this, match, team), MaskOf(EventType::Possession));
+}
+
+/**
+ * @brief Cesse de suivre les possessions du match.
+ */
+template <class Rules>
+void BasicSearchStrategy<Rules>::Detach() {
+    if (attached) {
+        attached->Unsubscribe(subscription);
+        attached = nullptr;
+    }
+}
+
+/**
+ * @brief Annonce la stratégie retenue et l'exécute.
+ */
+template <class Rules>
+void BasicSearchStrategy<Rules>::ExecuteStrategy() {
+    if (!chosen) {
+        ReportLine() << "Recherche : aucune stratégie retenue.";
+        return;
+    }
+    ReportLine() << "Recherche : stratégie " << stats.chosen << " retenue après " << static_cast<int>(stats.rollouts)
+                 << " simulations (gain estimé " << static_cast<float>(stats.value) << ").";
+    chosen->ExecuteStrategy();
+}
+
+/**
+ * @brief Consignes de l'action retenue.
+ * @return Les consignes, par défaut avant toute décision.
+ */
+template <class Rules>
+Tactics BasicSearchStrategy<Rules>::GetTactics() const {
+    return chosen ? chosen->GetTactics() : Tactics();
+}
+
+template class BasicSearchStrategy<Rules5x5>;
+template class BasicSearchStrategy<Rules3x3>;
+template class BasicSearchStrategy<RulesDrill2x2>;
@@ -0,0 +1,205 @@
+/**
+ * @file search_strategy.hpp
+ * @brief Stratégie choisissant, à chaque possession, une stratégie concrète par recherche arborescente Monte-Carlo.
+ */
+
+#ifndef SEARCH_STRATEGY_HPP
+#define SEARCH_STRATEGY_HPP
+
+#include "counter_rng.hpp"
+#include "match.hpp"
+#include "work_stealing_pool.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Paramètres de la recherche.
+ *
+ * La recherche s'arrête au premier budget épuisé : nombre de simulations ou temps. Un
+ * budget de temps rend la décision dépendante de la machine ; par défaut, seul le nombre
+ * de simulations compte.
+ */
+struct SearchConfig {
+    int segment_ticks = 10; ///< Ticks simulés entre deux choix de stratégie (un niveau de l'arbre).
+    int max_depth = 3; ///< Profondeur maximale de l'arbre (au plus kMaxSearchDepth).
+    int rollout_segments = 4; ///< Segments joués par simulation, dans l'arbre puis au hasard.
+    int rollouts = 256; ///< Budget de simulations par décision (0 : pas de limite).
+    double time_budget_ms = 0.0; ///< Budget de temps par décision en millisecondes (0 : pas de limite).
+    int trees = 8; ///< Arbres développés par décision, quel que soit le nombre de workers (au moins 1).
+    float exploration = 1.2f; ///< Constante d'exploration UCT.
+    float reward_scale = 4.f; ///< Écart de points ramené à 1 dans le critère UCT.
+    int max_nodes = 2048; ///< Capacité de chaque arbre.
+};
+
+constexpr int kMaxSearchDepth = 16; ///< Borne de SearchConfig::max_depth et rollout_segments.
+
+/**
+ * @brief Bilan de la dernière décision.
+ */
+struct SearchStats {
+    std::uint64_t rollouts = 0; ///< Simulations effectuées.
+    double elapsed_ms = 0.0; ///< Durée de la décision.
+    double rollouts_per_second = 0.0; ///< Débit de simulation.
+    int depth = 0; ///< Profondeur maximale atteinte par les arbres.
+    int chosen = -1; ///< Indice de l'action retenue.
+    double value = 0.0; ///< Gain moyen d'écart au score estimé pour l'action retenue.
+    std::uint32_t visits = 0; ///< Visites de l'action retenue, tous arbres confondus.
+};
+
+/**
+ * @brief Stratégie qui choisit parmi des stratégies concrètes par MCTS.
+ *
+ * SearchConfig::trees arbres indépendants (parallélisme à la racine) sont développés
+ * depuis l'état sauvegardé du match, répartis entre les workers du pool : un niveau de
+ * l'arbre est un choix de stratégie suivi de segment_ticks ticks, joués dans le match de
+ * travail du worker. Au-delà de l'arbre, la simulation choisit les stratégies au hasard.
+ * Les arbres sont fusionnés à la racine et l'action la plus visitée l'emporte. Arbres et
+ * matchs de travail sont alloués à la construction : la boucle de recherche n'alloue pas.
+ * Le nombre d'arbres et la part de simulations de chacun ne dépendent que de la
+ * configuration, et les tirages d'un arbre que de la clé du match, de l'indice de
+ * l'arbre et du tick : sans budget de temps, la décision ne dépend ni du nombre de
+ * workers ni de leur ordonnancement.
+ *
+ * Donnée à un coach, elle transmet au match les consignes de l'action retenue ;
+ * Attach() relance la décision à chaque fois que l'équipe récupère le ballon.
+ *
+ * @tparam Rules Règles de la variante de jeu.
+ */
+template <class Rules>
+class BasicSearchStrategy : public Strategy {
+public:
+    using MatchType = BasicMatch<Rules>; ///< Type du match.
+    using State = BasicGameState<Rules>; ///< État d'un match.
+
+    /**
+     * @brief Constructeur.
+     * @param pool Pool de threads des simulations.
+     * @param actions Stratégies concrètes parmi lesquelles choisir (non possédées).
+     * @param config Paramètres de la recherche.
+     * @param match_config Paramètres de simulation (ceux du match joué).
+     */
+    BasicSearchStrategy(WorkStealingPool& pool, std::vector<Strategy*> actions,
+                        const SearchConfig& config = SearchConfig(), const MatchConfig& match_config = MatchConfig());
+
+    ~BasicSearchStrategy() override;
+
+    BasicSearchStrategy(const BasicSearchStrategy&) = delete; ///< Non copiable.
+    BasicSearchStrategy& operator=(const BasicSearchStrategy&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Cherche la meilleure action pour une équipe depuis l'état courant d'un match.
+     *
+     * L'adversaire garde la stratégie de son coach pendant les simulations.
+     *
+     * @param match Match joué.
+     * @param team Équipe à conseiller.
+     * @return L'action retenue, ou nullptr sans action.
+     */
+    Strategy* Decide(const MatchType& match, int team);
+
+    /**
+     * @brief Relance Decide() chaque fois que l'équipe récupère le ballon.
+     *
+     * La décision est prise pendant Match::tick(), sur le thread du match. Si le pool est
+     * déjà occupé (match joué par un worker de ce pool, comme dans un lot de BatchRunner,
+     * ou décision d'un autre match en cours), elle se déroule en série sur ce thread.
+     * Une stratégie ne suit qu'un match : deux matchs simultanés demandent deux stratégies.
+     * Le match doit survivre à la stratégie, ou Detach() être appelé avant sa destruction.
+     *
+     * @param match Match joué.
+     * @param team Équipe conseillée.
+     */
+    void Attach(MatchType& match, int team);
+
+    /**
+     * @brief Cesse de suivre les possessions du match.
+     */
+    void Detach();
+
+    /**
+     * @brief Annonce la stratégie retenue et l'exécute.
+     */
+    void ExecuteStrategy() override;
+
+    /**
+     * @brief Consignes de l'action retenue.
+     * @return Les consignes, par défaut avant toute décision.
+     */
+    Tactics GetTactics() const override;
+
+    const char* Name() const override { return "search"; } ///< Nom court.
+
+    Strategy* Chosen() const { return chosen; } ///< Action retenue par la dernière décision.
+    const SearchStats& LastSearch() const { return stats; } ///< Bilan de la dernière décision.
+    std::uint64_t Decisions() const { return decisions; } ///< Nombre de décisions prises.
+
+private:
+    /**
+     * @brief Nœud d'un arbre : enfants contigus, un par action.
+     */
+    struct Node {
+        std::int32_t first_child; ///< Premier enfant, -1 si non développé.
+        std::int32_t action; ///< Action menant à ce nœud, -1 pour la racine.
+        std::uint32_t visits; ///< Simulations passées par ce nœud.
+        double value; ///< Somme des gains d'écart au score.
+    };
+
+    /**
+     * @brief Arbre et générateur d'une recherche indépendante.
+     */
+    struct alignas(64) Tree {
+        std::vector<Node> nodes; ///< Nœuds, capacité max_nodes.
+        int used = 0; ///< Nœuds occupés.
+        int depth = 0; ///< Profondeur maximale atteinte.
+        std::uint64_t rollouts = 0; ///< Simulations de la décision en cours.
+        CounterStream stream{PhiloxKey{}, 0, 0, RandomStream::Search}; ///< Tirages de l'arbre, clés par (match, arbre, tick).
+    };
+
+    class PossessionObserver;
+
+    WorkStealingPool& pool; ///< Pool des simulations.
+    std::vector<Strategy*> actions; ///< Actions possibles.
+    SearchConfig config; ///< Paramètres de la recherche.
+    std::vector<std::unique_ptr<MatchType>> scratch; ///< Un match de travail par worker.
+    std::vector<Tree> trees; ///< SearchConfig::trees arbres.
+    Strategy* chosen = nullptr; ///< Action retenue.
+    SearchStats stats; ///< Bilan de la dernière décision.
+    std::uint64_t decisions = 0; ///< Décisions prises.
+
+    State root; ///< État de départ de la décision en cours.
+    int team = 0; ///< Équipe conseillée dans la décision en cours.
+    Strategy* theirs = nullptr; ///< Stratégie adverse de la décision en cours.
+    std::chrono::steady_clock::time_point deadline; ///< Fin du budget de temps.
+    bool timed = false; ///< True si le budget de temps s'applique.
+
+    ObserverRegistry* attached = nullptr; ///< Registre du match suivi, ou nullptr.
+    Subscription subscription; ///< Abonnement aux possessions.
+
+    /**
+     * @brief Développe un arbre jusqu'à épuisement de son budget.
+     * @param tree Indice de l'arbre.
+     * @param worker Worker exécutant la recherche (choisit le match de travail).
+     * @param budget Nombre de simulations (0 : limite de temps seule).
+     */
+    void Grow(std::size_t tree, unsigned worker, std::uint64_t budget);
+
+    /**
+     * @brief Une itération MCTS : sélection, expansion, simulation, rétropropagation.
+     */
+    void Iterate(Tree& tree, MatchType& match);
+
+    /**
+     * @brief Joue un segment avec une action.
+     */
+    void PlaySegment(MatchType& match, int action);
+};
+
+extern template class BasicSearchStrategy<Rules5x5>;
+extern template class BasicSearchStrategy<Rules3x3>;
+extern template class BasicSearchStrategy<RulesDrill2x2>;
+
+using SearchStrategy = BasicSearchStrategy<Rules5x5>; ///< Recherche de stratégie d'un match à cinq contre cinq.
+
+#endif // SEARCH_STRATEGY_HPP
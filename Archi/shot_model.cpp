@@ -0,0 +1,155 @@
+#include "shot_model.hpp"
+
+namespace {
+
+/**
+ * @brief Exponentielle évaluable à la compilation.
+ *
+ * L'argument est divisé par deux jusqu'à |x| < 0.5, développé en série de Taylor,
+ * puis le résultat est élevé au carré autant de fois.
+ *
+ * @param x Exposant.
+ * @return e^x.
+ */
+constexpr double const_exp(double x) {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x /= 2;
+        ++halvings;
+    }
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 16; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    while (halvings--) {
+        sum *= sum;
+    }
+    return sum;
+}
+
+/**
+ * @brief Courbe échantillonnée régulièrement sur [lo, hi], lue par interpolation linéaire.
+ * @tparam N Nombre d'échantillons.
+ */
+template <int N>
+struct Curve {
+    float lo; ///< Abscisse du premier échantillon.
+    float step; ///< Écart entre deux échantillons.
+    float values[N]; ///< Échantillons.
+
+    /**
+     * @brief Valeur interpolée ; bornée aux extrémités hors de [lo, hi].
+     * @param x Abscisse.
+     * @return La valeur.
+     */
+    constexpr float At(float x) const {
+        float t = (x - lo) / step;
+        if (!(t > 0.f)) {
+            return values[0];
+        }
+        if (t >= N - 1) {
+            return values[N - 1];
+        }
+        const int i = static_cast<int>(t);
+        const float frac = t - i;
+        return values[i] + frac * (values[i + 1] - values[i]);
+    }
+};
+
+/**
+ * @brief Échantillonne une fonction à la compilation.
+ * @param lo Borne basse.
+ * @param hi Borne haute.
+ * @param f Fonction échantillonnée.
+ */
+template <int N, class F>
+constexpr Curve<N> sample(float lo, float hi, F f) {
+    Curve<N> curve{lo, (hi - lo) / (N - 1), {}};
+    for (int i = 0; i < N; ++i) {
+        curve.values[i] = static_cast<float>(f(lo + i * static_cast<double>(curve.step)));
+    }
+    return curve;
+}
+
+/**
+ * @brief Logistique décroissante : floor + (peak - floor) / (1 + e^(slope (d - mid))).
+ */
+constexpr double falloff(double d, double peak, double floor, double mid, double slope) {
+    return floor + (peak - floor) / (1.0 + const_exp(slope * (d - mid)));
+}
+
+/// Tirs à deux points : ~69 % au cercle, ~38 % à 6 unités.
+constexpr Curve<64> kTwoPointCurve = sample<64>(0.f, ShotModel::kMaxRange, [](double d) {
+    return falloff(d, 0.72, 0.04, 6.0, 0.5);
+});
+
+/// Tirs à trois points : ~33 % sur la ligne, sous les tirs à deux points voisins.
+constexpr Curve<64> kThreePointCurve = sample<64>(0.f, ShotModel::kMaxRange, [](double d) {
+    return falloff(d, 0.5, 0.02, 8.0, 0.5);
+});
+
+/// Gêne du défenseur : jusqu'à -60 % au contact, négligeable à kContestRange.
+constexpr Curve<32> kContestCurve = sample<32>(0.f, ShotModel::kContestRange, [](double c) {
+    return 1.0 - 0.6 * const_exp(-c * c / 2.0);
+});
+
+static_assert(kTwoPointCurve.At(0.f) > 0.65f && kTwoPointCurve.At(ShotModel::kMaxRange) < 0.06f,
+              "Courbe des tirs à deux points");
+static_assert(kThreePointCurve.At(ShotModel::kThreePointRange) > 0.3f &&
+                  kThreePointCurve.At(ShotModel::kThreePointRange) <
+                      kTwoPointCurve.At(ShotModel::kThreePointRange - 0.5f),
+              "Courbe des tirs à trois points");
+static_assert(kContestCurve.At(0.f) > 0.39f && kContestCurve.At(0.f) < 0.41f &&
+                  kContestCurve.At(ShotModel::kContestRange) > 0.99f,
+              "Courbe de gêne du défenseur");
+
+} // namespace
+
+/**
+ * @brief Probabilité de réussite, par interpolation dans les tables.
+ * @param distance Distance au panier.
+ * @param defender Distance du défenseur le plus proche.
+ * @param type Valeur du tir.
+ * @return Une probabilité dans [0, 1].
+ */
+float ShotModel::MakeProbability(float distance, float defender, ShotType type) {
+    const float base = type == ShotType::ThreePoint ? kThreePointCurve.At(distance) : kTwoPointCurve.At(distance);
+    return base * kContestCurve.At(defender);
+}
+
+/**
+ * @brief Résout le tir d'un joueur.
+ * @param shooter Tireur.
+ * @param basket Panier visé.
+ * @param draw Tirage uniforme dans [0, 1).
+ * @return Le résultat du tir.
+ */
+template <class Rules>
+ShotResult ShotModel::Resolve(const BasicPlayer<Rules>& shooter, const Position& basket, float draw) {
+    const float distance = shooter.position.distance_to(basket);
+    const float defender =
+        shooter.Opponents[0] ? shooter.position.distance_to(shooter.Opponents[0]->position) : kContestRange;
+    const ShotType type = TypeAt(distance);
+    const float probability = MakeProbability(distance, defender, type);
+    return ShotResult{type, probability, draw < probability};
+}
+
+/**
+ * @brief Reporte un tir réussi sur le score et notifie les arbitres.
+ * @param score Score du match.
+ * @param team 0 pour l'équipe à domicile, 1 pour l'équipe adverse.
+ * @param shot Résultat du tir.
+ */
+void ShotModel::Record(Gamescore& score, int team, const ShotResult& shot) {
+    if (!shot.made) {
+        return;
+    }
+    const int points = shot.Points();
+    score.UpdateScore(score.homeScore + (team == 0 ? points : 0), score.awayScore + (team == 1 ? points : 0));
+}
+
+template ShotResult ShotModel::Resolve<Rules5x5>(const BasicPlayer<Rules5x5>&, const Position&, float);
+template ShotResult ShotModel::Resolve<Rules3x3>(const BasicPlayer<Rules3x3>&, const Position&, float);
+template ShotResult ShotModel::Resolve<RulesDrill2x2>(const BasicPlayer<RulesDrill2x2>&, const Position&, float);
@@ -0,0 +1,100 @@
+/**
+ * @file shot_model.hpp
+ * @brief Résolution des tirs : probabilité de réussite tabulée à la compilation.
+ */
+
+#ifndef SHOT_MODEL_HPP
+#define SHOT_MODEL_HPP
+
+#include "basket.hpp"
+
+/**
+ * @brief Valeur d'un tir.
+ */
+enum class ShotType {
+    TwoPoint = 2, ///< Tir à deux points, en deçà de la ligne.
+    ThreePoint = 3 ///< Tir à trois points, au-delà de la ligne.
+};
+
+/**
+ * @brief Résultat d'un tir.
+ */
+struct ShotResult {
+    ShotType type; ///< Valeur du tir.
+    float probability; ///< Probabilité de réussite.
+    bool made; ///< True si le tir est réussi.
+
+    int Points() const { return made ? static_cast<int>(type) : 0; } ///< Points marqués.
+};
+
+/**
+ * @brief Modèle de tir : la réussite dépend de la distance au panier, du défenseur le plus
+ * proche et de la valeur du tir.
+ *
+ * P = courbe_type(distance) × gêne(distance du défenseur). Les deux courbes de distance
+ * (logistiques) et la courbe de gêne (gaussienne) sont échantillonnées dans des tables
+ * construites à la compilation ; une évaluation est une interpolation linéaire par table,
+ * sans exp ni pow.
+ */
+class ShotModel {
+public:
+    static constexpr float kThreePointRange = 6.75f; ///< Distance de la ligne à trois points.
+    static constexpr float kMaxRange = 16.f; ///< Au-delà, la probabilité reste celle de cette distance.
+    static constexpr float kContestRange = 4.f; ///< Au-delà, le défenseur ne gêne plus le tir.
+
+    /**
+     * @brief Valeur d'un tir pris à une distance donnée.
+     * @param distance Distance au panier.
+     * @return TwoPoint ou ThreePoint.
+     */
+    static ShotType TypeAt(float distance) {
+        return distance >= kThreePointRange ? ShotType::ThreePoint : ShotType::TwoPoint;
+    }
+
+    /**
+     * @brief Probabilité de réussite.
+     * @param distance Distance au panier.
+     * @param defender Distance du défenseur le plus proche.
+     * @param type Valeur du tir.
+     * @return Une probabilité dans [0, 1].
+     */
+    static float MakeProbability(float distance, float defender, ShotType type);
+
+    /**
+     * @brief Probabilité de réussite, la valeur du tir étant déduite de la distance.
+     * @param distance Distance au panier.
+     * @param defender Distance du défenseur le plus proche.
+     * @return Une probabilité dans [0, 1].
+     */
+    static float MakeProbability(float distance, float defender) {
+        return MakeProbability(distance, defender, TypeAt(distance));
+    }
+
+    /**
+     * @brief Résout le tir d'un joueur.
+     *
+     * Le défenseur le plus proche est `Opponents[0]` (tables remplies par le suivi des voisins).
+     *
+     * @param shooter Tireur.
+     * @param basket Panier visé.
+     * @param draw Tirage uniforme dans [0, 1) ; le tir est réussi si draw < probabilité.
+     * @return Le résultat du tir.
+     */
+    template <class Rules>
+    static ShotResult Resolve(const BasicPlayer<Rules>& shooter, const Position& basket, float draw);
+
+    /**
+     * @brief Reporte un tir réussi sur le score et notifie les arbitres.
+     * @param score Score du match.
+     * @param team 0 pour l'équipe à domicile, 1 pour l'équipe adverse.
+     * @param shot Résultat du tir.
+     */
+    static void Record(Gamescore& score, int team, const ShotResult& shot);
+};
+
+extern template ShotResult ShotModel::Resolve<Rules5x5>(const BasicPlayer<Rules5x5>&, const Position&, float);
+extern template ShotResult ShotModel::Resolve<Rules3x3>(const BasicPlayer<Rules3x3>&, const Position&, float);
+extern template ShotResult ShotModel::Resolve<RulesDrill2x2>(const BasicPlayer<RulesDrill2x2>&, const Position&,
+                                                             float);
+
+#endif // SHOT_MODEL_HPP
@@ -0,0 +1,288 @@
+#include "team_tree.hpp"
+#include "output_sink.hpp"
+
+/**
+ * @brief Ajoute un joueur.
+ * @param player Joueur à ajouter.
+ */
+void TeamAggregate::Add(Player& player) {
+    const float x = player.position.x;
+    const float y = player.position.y;
+    ++count;
+    sum_x += x;
+    sum_y += y;
+    sum_sq += static_cast<double>(x) * x + static_cast<double>(y) * y;
+    min_x = std::fmin(min_x, x);
+    min_y = std::fmin(min_y, y);
+    max_x = std::fmax(max_x, x);
+    max_y = std::fmax(max_y, y);
+    if (!holder && player.possede_ball) {
+        holder = &player;
+    }
+}
+
+/**
+ * @brief Fusionne les agrégats d'un sous-arbre.
+ * @param other Agrégats à fusionner.
+ */
+void TeamAggregate::Merge(const TeamAggregate& other) {
+    count += other.count;
+    sum_x += other.sum_x;
+    sum_y += other.sum_y;
+    sum_sq += other.sum_sq;
+    min_x = std::fmin(min_x, other.min_x);
+    min_y = std::fmin(min_y, other.min_y);
+    max_x = std::fmax(max_x, other.max_x);
+    max_y = std::fmax(max_y, other.max_y);
+    if (!holder) {
+        holder = other.holder;
+    }
+}
+
+/**
+ * @brief Barycentre des joueurs.
+ * @return Le barycentre, ou (0, 0) sans joueur.
+ */
+Position TeamAggregate::Centroid() const {
+    if (!count) {
+        return Position{0.f, 0.f};
+    }
+    return Position{static_cast<float>(sum_x / count), static_cast<float>(sum_y / count)};
+}
+
+/**
+ * @brief Dispersion : écart quadratique moyen des joueurs au barycentre.
+ * @return La dispersion, 0 sans joueur.
+ */
+float TeamAggregate::Spread() const {
+    if (!count) {
+        return 0.f;
+    }
+    const double cx = sum_x / count;
+    const double cy = sum_y / count;
+    return static_cast<float>(std::sqrt(std::fmax(sum_sq / count - cx * cx - cy * cy, 0.0)));
+}
+
+/**
+ * @brief Constructeur créant la racine (un groupe vide).
+ * @param capacity Nombre de nœuds à réserver.
+ */
+TeamTree::TeamTree(std::size_t capacity) {
+    nodes.reserve(capacity ? capacity : 1);
+    aggregates.reserve(capacity ? capacity : 1);
+    dirty.reserve(capacity ? capacity : 1);
+    nodes.push_back(Node{nullptr, 1, kNone, Kind::Group});
+    aggregates.emplace_back();
+    dirty.push_back(0);
+}
+
+/**
+ * @brief Insère un nœud en fin de sous-arbre d'un groupe.
+ *
+ * En fin de tableau, seuls les ancêtres sont mis à jour ; sinon les nœuds suivants sont
+ * décalés d'une case et leurs indices corrigés.
+ *
+ * @param parent Groupe parent.
+ * @param kind Nature du nœud.
+ * @param player Joueur d'une feuille.
+ * @return L'identifiant du nœud, ou kNone si @p parent n'est pas un groupe.
+ */
+TeamTree::NodeId TeamTree::Insert(NodeId parent, Kind kind, Player* player) {
+    if (parent >= nodes.size() || nodes[parent].kind != Kind::Group) {
+        return kNone;
+    }
+    const NodeId pos = nodes[parent].end;
+    for (NodeId i = pos; i < nodes.size(); ++i) {
+        ++nodes[i].end;
+        if (nodes[i].parent != kNone && nodes[i].parent >= pos) {
+            ++nodes[i].parent;
+        }
+    }
+    for (NodeId a = parent; a != kNone; a = nodes[a].parent) {
+        ++nodes[a].end;
+    }
+    nodes.insert(nodes.begin() + pos, Node{player, pos + 1, parent, kind});
+    aggregates.insert(aggregates.begin() + pos, TeamAggregate());
+    dirty.insert(dirty.begin() + pos, 0);
+    MarkDirty(pos);
+    return pos;
+}
+
+/**
+ * @brief Ajoute un groupe en dernier enfant d'un groupe.
+ * @param parent Groupe parent.
+ * @return L'identifiant du nouveau groupe, ou kNone.
+ */
+TeamTree::NodeId TeamTree::AddGroup(NodeId parent) {
+    return Insert(parent, Kind::Group, nullptr);
+}
+
+/**
+ * @brief Ajoute un joueur en dernier enfant d'un groupe.
+ * @param parent Groupe parent.
+ * @param player Joueur représenté.
+ * @return L'identifiant de la feuille, ou kNone.
+ */
+TeamTree::NodeId TeamTree::AddLeaf(NodeId parent, Player* player) {
+    return Insert(parent, Kind::Leaf, player);
+}
+
+/**
+ * @brief Ajoute une copie d'une hiérarchie composite sous un groupe.
+ * @param parent Groupe parent.
+ * @param component Racine de la hiérarchie à aplatir.
+ * @return L'identifiant du nœud créé pour @p component, ou kNone.
+ */
+TeamTree::NodeId TeamTree::Append(NodeId parent, const TeamComponent& component) {
+    return component.FlattenInto(*this, parent);
+}
+
+/**
+ * @brief Supprime un nœud et tout son sous-arbre.
+ * @param node Nœud à supprimer.
+ * @return True si le nœud a été supprimé.
+ */
+bool TeamTree::Remove(NodeId node) {
+    if (node == kRoot || node >= nodes.size()) {
+        return false;
+    }
+    const NodeId end = nodes[node].end;
+    const NodeId count = end - node;
+    MarkDirty(nodes[node].parent);
+    for (NodeId a = nodes[node].parent; a != kNone; a = nodes[a].parent) {
+        nodes[a].end -= count;
+    }
+    for (NodeId i = end; i < nodes.size(); ++i) {
+        nodes[i].end -= count;
+        if (nodes[i].parent != kNone && nodes[i].parent >= end) {
+            nodes[i].parent -= count;
+        }
+    }
+    nodes.erase(nodes.begin() + node, nodes.begin() + end);
+    aggregates.erase(aggregates.begin() + node, aggregates.begin() + end);
+    dirty.erase(dirty.begin() + node, dirty.begin() + end);
+    return true;
+}
+
+/**
+ * @brief Vide l'arbre, à l'exception de la racine.
+ */
+void TeamTree::Clear() {
+    nodes.resize(1);
+    aggregates.resize(1);
+    dirty.resize(1);
+    nodes[kRoot].end = 1;
+    dirty[kRoot] = 1;
+}
+
+/**
+ * @brief Nombre de feuilles d'un sous-arbre.
+ * @param node Racine du sous-arbre.
+ * @return Le nombre de joueurs.
+ */
+std::size_t TeamTree::LeafCount(NodeId node) const {
+    std::size_t count = 0;
+    for (NodeId i = node, last = nodes[node].end; i < last; ++i) {
+        count += nodes[i].kind == Kind::Leaf;
+    }
+    return count;
+}
+
+/**
+ * @brief Affiche un sous-arbre.
+ *
+ * Le pré-ordre donne directement l'ordre d'affichage : une seule boucle.
+ *
+ * @param node Racine du sous-arbre.
+ */
+void TeamTree::Display(NodeId node) const {
+    for (NodeId i = node, last = nodes[node].end; i < last; ++i) {
+        if (nodes[i].kind == Kind::Group) {
+            ReportLine() << "Équipe :";
+        } else {
+            const Player& player = *nodes[i].player;
+            ReportLine() << "Joueur " << player.number << " à la position ("
+                         << player.position.x << ", " << player.position.y << ")";
+        }
+    }
+}
+
+/**
+ * @brief Marque un nœud et ses ancêtres comme périmés, jusqu'au premier déjà marqué.
+ * @param node Premier nœud à marquer.
+ */
+void TeamTree::MarkDirty(NodeId node) {
+    for (NodeId a = node; a != kNone && !dirty[a]; a = nodes[a].parent) {
+        dirty[a] = 1;
+    }
+}
+
+/**
+ * @brief Signale qu'un joueur a bougé ou changé de possession.
+ * @param leaf Feuille du joueur.
+ */
+void TeamTree::Invalidate(NodeId leaf) {
+    MarkDirty(leaf);
+}
+
+/**
+ * @brief Invalide tous les agrégats.
+ */
+void TeamTree::InvalidateAll() {
+    std::fill(dirty.begin(), dirty.end(), 1);
+}
+
+/**
+ * @brief Agrégats des joueurs d'un sous-arbre, recalculés si nécessaire.
+ *
+ * Un groupe périmé fusionne les agrégats de ses enfants directs (sautés de sous-arbre en
+ * sous-arbre grâce à SubtreeEnd), en ne descendant que dans les enfants eux-mêmes périmés.
+ *
+ * @param node Racine du sous-arbre.
+ * @return Les agrégats.
+ */
+const TeamAggregate& TeamTree::Aggregate(NodeId node) const {
+    TeamAggregate& cached = aggregates[node];
+    if (!dirty[node]) {
+        return cached;
+    }
+    cached = TeamAggregate();
+    if (nodes[node].kind == Kind::Leaf) {
+        cached.Add(*nodes[node].player);
+    } else {
+        for (NodeId child = node + 1, last = nodes[node].end; child < last; child = nodes[child].end) {
+            cached.Merge(Aggregate(child));
+        }
+        ++recomputations;
+    }
+    dirty[node] = 0;
+    return cached;
+}
+
+/**
+ * @brief Affiche le sous-arbre du nœud.
+ */
+void TeamNodeView::Display() const {
+    tree->Display(node);
+}
+
+/**
+ * @brief Recopie le sous-arbre du nœud sous un groupe d'un autre arbre.
+ * @param target Arbre de destination.
+ * @param parent Groupe parent dans @p target.
+ * @return L'identifiant du nœud créé.
+ */
+TeamTree::NodeId TeamNodeView::FlattenInto(TeamTree& target, TeamTree::NodeId parent) const {
+    const TeamTree::NodeId last = tree->SubtreeEnd(node);
+    std::vector<TeamTree::NodeId> copies(last - node);
+    for (TeamTree::NodeId i = node; i < last; ++i) {
+        const TeamTree::Node& source = tree->At(i);
+        const TeamTree::NodeId into = i == node ? parent : copies[source.parent - node];
+        copies[i - node] = source.kind == TeamTree::Kind::Leaf ? target.AddLeaf(into, source.player)
+                                                               : target.AddGroup(into);
+        if (copies[i - node] == TeamTree::kNone) {
+            return TeamTree::kNone;
+        }
+    }
+    return copies[0];
+}
@@ -0,0 +1,249 @@
+/**
+ * @file team_tree.hpp
+ * @brief Hiérarchie d'équipes aplatie : arbre composite rangé en pré-ordre dans un tableau contigu.
+ */
+
+#ifndef TEAM_TREE_HPP
+#define TEAM_TREE_HPP
+
+#include "basket.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Agrégats de position des joueurs d'un sous-arbre.
+ */
+struct TeamAggregate {
+    std::uint32_t count = 0; ///< Nombre de joueurs.
+    double sum_x = 0.0; ///< Somme des X.
+    double sum_y = 0.0; ///< Somme des Y.
+    double sum_sq = 0.0; ///< Somme des x² + y².
+    float min_x = std::numeric_limits<float>::max(); ///< Boîte englobante : X minimal.
+    float min_y = std::numeric_limits<float>::max(); ///< Boîte englobante : Y minimal.
+    float max_x = std::numeric_limits<float>::lowest(); ///< Boîte englobante : X maximal.
+    float max_y = std::numeric_limits<float>::lowest(); ///< Boîte englobante : Y maximal.
+    Player* holder = nullptr; ///< Premier joueur (pré-ordre) ayant le ballon, sinon nullptr.
+
+    /**
+     * @brief Ajoute un joueur.
+     * @param player Joueur à ajouter.
+     */
+    void Add(Player& player);
+
+    /**
+     * @brief Fusionne les agrégats d'un sous-arbre.
+     * @param other Agrégats à fusionner.
+     */
+    void Merge(const TeamAggregate& other);
+
+    /**
+     * @brief Barycentre des joueurs.
+     * @return Le barycentre, ou (0, 0) sans joueur.
+     */
+    Position Centroid() const;
+
+    /**
+     * @brief Dispersion : écart quadratique moyen des joueurs au barycentre.
+     * @return La dispersion, 0 sans joueur.
+     */
+    float Spread() const;
+};
+
+/**
+ * @brief Arbre d'équipes (ligue, conférence, équipe, cinq, joueurs) stocké en pré-ordre.
+ *
+ * Chaque nœud connaît la fin de son sous-arbre : le sous-arbre du nœud n occupe l'intervalle
+ * [n, SubtreeEnd(n)) du tableau. Les parcours sont donc de simples boucles, sans récursion
+ * ni appel virtuel, et les opérations groupées sur les feuilles d'un sous-arbre parcourent
+ * une zone mémoire contiguë.
+ *
+ * Les identifiants de nœuds sont des indices dans le tableau : une insertion ailleurs
+ * qu'en fin de tableau, ou une suppression, décale les nœuds qui suivent. L'ajout dans
+ * l'ordre de construction naturel (chaque nœud sous le dernier groupe ouvert ou l'un de
+ * ses ancêtres) ne décale rien.
+ *
+ * Chaque groupe garde en cache les agrégats de ses joueurs (TeamAggregate). Quand un joueur
+ * bouge ou prend le ballon, Invalidate() marque ses ancêtres jusqu'au premier déjà marqué ;
+ * Aggregate() ne recalcule que les groupes marqués, à partir des agrégats de leurs enfants.
+ * Interroger la forme d'une équipe coûte ainsi O(profondeur) amorti au lieu de O(joueurs).
+ * Le cache est modifié par les lectures : un arbre ne doit pas être interrogé depuis
+ * plusieurs threads à la fois.
+ */
+class TeamTree {
+public:
+    using NodeId = std::uint32_t; ///< Indice d'un nœud dans le tableau pré-ordre.
+
+    static constexpr NodeId kRoot = 0; ///< Racine, créée par le constructeur.
+    static constexpr NodeId kNone = UINT32_MAX; ///< Absence de nœud (parent de la racine).
+
+    /**
+     * @brief Nature d'un nœud.
+     */
+    enum class Kind : std::uint8_t {
+        Group, ///< Équipe ou regroupement d'équipes.
+        Leaf ///< Joueur.
+    };
+
+    /**
+     * @brief Nœud de l'arbre.
+     */
+    struct Node {
+        Player* player; ///< Joueur d'une feuille, nullptr pour un groupe.
+        NodeId end; ///< Fin (exclue) du sous-arbre.
+        NodeId parent; ///< Parent, kNone pour la racine.
+        Kind kind; ///< Nature du nœud.
+    };
+
+    /**
+     * @brief Constructeur créant la racine (un groupe vide).
+     * @param capacity Nombre de nœuds à réserver.
+     */
+    explicit TeamTree(std::size_t capacity = 0);
+
+    /**
+     * @brief Ajoute un groupe en dernier enfant d'un groupe.
+     * @param parent Groupe parent.
+     * @return L'identifiant du nouveau groupe, ou kNone si @p parent n'est pas un groupe.
+     */
+    NodeId AddGroup(NodeId parent = kRoot);
+
+    /**
+     * @brief Ajoute un joueur en dernier enfant d'un groupe.
+     * @param parent Groupe parent.
+     * @param player Joueur représenté.
+     * @return L'identifiant de la feuille, ou kNone si @p parent n'est pas un groupe.
+     */
+    NodeId AddLeaf(NodeId parent, Player* player);
+
+    /**
+     * @brief Ajoute une copie d'une hiérarchie composite sous un groupe.
+     * @param parent Groupe parent.
+     * @param component Racine de la hiérarchie à aplatir.
+     * @return L'identifiant du nœud créé pour @p component, ou kNone.
+     */
+    NodeId Append(NodeId parent, const TeamComponent& component);
+
+    /**
+     * @brief Supprime un nœud et tout son sous-arbre (la racine ne peut être supprimée).
+     * @param node Nœud à supprimer.
+     * @return True si le nœud a été supprimé.
+     */
+    bool Remove(NodeId node);
+
+    /**
+     * @brief Vide l'arbre, à l'exception de la racine.
+     */
+    void Clear();
+
+    std::size_t Size() const { return nodes.size(); } ///< Nombre de nœuds, racine comprise.
+    const Node& At(NodeId node) const { return nodes[node]; } ///< Accès à un nœud.
+    NodeId SubtreeEnd(NodeId node) const { return nodes[node].end; } ///< Fin (exclue) du sous-arbre.
+    bool IsLeaf(NodeId node) const { return nodes[node].kind == Kind::Leaf; } ///< Vrai pour un joueur.
+
+    /**
+     * @brief Nombre de feuilles d'un sous-arbre.
+     * @param node Racine du sous-arbre.
+     * @return Le nombre de joueurs.
+     */
+    std::size_t LeafCount(NodeId node = kRoot) const;
+
+    /**
+     * @brief Appelle @p f pour chaque joueur d'un sous-arbre, dans l'ordre pré-ordre.
+     * @param node Racine du sous-arbre.
+     * @param f Fonction appelée avec une référence sur chaque joueur.
+     */
+    template <typename F>
+    void ForEachLeaf(NodeId node, F&& f) const {
+        for (NodeId i = node, last = nodes[node].end; i < last; ++i) {
+            if (nodes[i].kind == Kind::Leaf) {
+                f(*nodes[i].player);
+            }
+        }
+    }
+
+    /**
+     * @brief Affiche un sous-arbre, dans le même format que TeamComposite::Display().
+     * @param node Racine du sous-arbre.
+     */
+    void Display(NodeId node = kRoot) const;
+
+    /**
+     * @brief Signale qu'un joueur a bougé ou changé de possession.
+     * @param leaf Feuille du joueur.
+     */
+    void Invalidate(NodeId leaf);
+
+    /**
+     * @brief Invalide tous les agrégats (après un déplacement de nombreux joueurs).
+     */
+    void InvalidateAll();
+
+    /**
+     * @brief Agrégats des joueurs d'un sous-arbre, recalculés si nécessaire.
+     * @param node Racine du sous-arbre.
+     * @return Les agrégats (référence valide jusqu'à la prochaine modification de l'arbre).
+     */
+    const TeamAggregate& Aggregate(NodeId node = kRoot) const;
+
+    /**
+     * @brief Nombre de groupes recalculés depuis la construction.
+     * @return Le nombre de recalculs.
+     */
+    std::uint64_t Recomputations() const { return recomputations; }
+
+private:
+    std::vector<Node> nodes; ///< Nœuds en pré-ordre.
+    mutable std::vector<TeamAggregate> aggregates; ///< Agrégats en cache, parallèles à nodes.
+    mutable std::vector<std::uint8_t> dirty; ///< 1 si l'agrégat du nœud est périmé.
+    mutable std::uint64_t recomputations = 0; ///< Groupes recalculés.
+
+    /**
+     * @brief Marque un nœud et ses ancêtres comme périmés, jusqu'au premier déjà marqué.
+     *
+     * Invariant : un nœud périmé a tous ses ancêtres périmés.
+     */
+    void MarkDirty(NodeId node);
+
+    /**
+     * @brief Insère un nœud en fin de sous-arbre d'un groupe.
+     * @return L'identifiant du nœud, ou kNone si @p parent n'est pas un groupe.
+     */
+    NodeId Insert(NodeId parent, Kind kind, Player* player);
+};
+
+/**
+ * @brief Vue d'un nœud de TeamTree exposant l'interface TeamComponent.
+ *
+ * Ne possède rien : la vue reste valide tant que l'arbre ne décale pas le nœud.
+ */
+class TeamNodeView : public TeamComponent {
+public:
+    /**
+     * @brief Constructeur.
+     * @param tree Arbre visé.
+     * @param node Nœud représenté.
+     */
+    TeamNodeView(const TeamTree& tree, TeamTree::NodeId node) : tree(&tree), node(node) {}
+
+    /**
+     * @brief Affiche le sous-arbre du nœud.
+     */
+    void Display() const override;
+
+    /**
+     * @brief Recopie le sous-arbre du nœud sous un groupe d'un autre arbre.
+     * @param target Arbre de destination.
+     * @param parent Groupe parent dans @p target.
+     * @return L'identifiant du nœud créé.
+     */
+    TeamTree::NodeId FlattenInto(TeamTree& target, TeamTree::NodeId parent) const override;
+
+    TeamTree::NodeId Node() const { return node; } ///< Nœud représenté.
+
+private:
+    const TeamTree* tree; ///< Arbre visé.
+    TeamTree::NodeId node; ///< Nœud représenté.
+};
+
+#endif // TEAM_TREE_HPP
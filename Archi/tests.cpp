@@ -3,9 +3,44 @@
  * @brief Fichier contenant les tests unitaires pour les différentes fonctionnalités du projet.
  */
 
-#include "basket.cpp"
+#include "agent_scheduler.hpp"
+#include "basket.hpp"
+#include "batch_runner.hpp"
+#include "column_store.hpp"
+#include "counter_rng.hpp"
+#include "heatmap.hpp"
+#include "match.hpp"
+#include "match_log.hpp"
+#include "match_score.hpp"
+#include "metrics.hpp"
+#include "motion_batch.hpp"
+#include "neighbour_tracker.hpp"
+#include "observer_registry.hpp"
+#include "output_sink.hpp"
+#include "pass_evaluator.hpp"
+#include "player_pool.hpp"
+#include "player_stats.hpp"
+#include "result_export.hpp"
+#include "score_notifier.hpp"
+#include "search_strategy.hpp"
+#include "shot_model.hpp"
+#include "team_tree.hpp"
+#include "tracking_feed.hpp"
+#include "what_if.hpp"
+#include "work_stealing_pool.hpp"
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <string>
+#include <thread>
 
 /**
  * @brief Teste la méthode de calcul de distance entre deux positions.
@@ -22,8 +57,8 @@ void testPositionDistance() {
  * @brief Teste le changement de possesseur du ballon vers un coéquipier.
  */
 void testBallonChangerPossesseur() {
-    Player player1{Position{10, 20}, true, 1};
-    Player player2{Position{30, 40}, false, 2};
+    Player player1{Position{10, 20}, true, 1, {}, {}};
+    Player player2{Position{30, 40}, false, 2, {}, {}};
     player1.Teammates[0] = &player2;
 
     Ballon ballon{Position{15, 25}, &player1};
@@ -68,12 +103,123 @@ void testObserverPattern() {
     std::cout << "testObserverPattern passed.\n";
 }
 
+/**
+ * @brief Observateur de test : compte les événements reçus et peut se désabonner en cours de diffusion.
+ */
+class CountingObserver : public GameObserver {
+public:
+    int received[kEventTypes] = {}; ///< Événements reçus, par type.
+    GameEvent last{EventType::Score}; ///< Dernier événement reçu.
+    ObserverRegistry* registry = nullptr; ///< Registre dont se désabonner, ou nullptr.
+    Subscription self; ///< Poignée à désabonner à la première notification.
+    std::shared_ptr<GameObserver> added; ///< Observateur à abonner à la première notification.
+
+    void OnEvent(const GameEvent& event) override {
+        ++received[std::countr_zero(MaskOf(event.type))];
+        last = event;
+        if (registry) {
+            ObserverRegistry* target = registry;
+            registry = nullptr;
+            target->Unsubscribe(self);
+            if (added) {
+                target->Subscribe(added);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Observateur de test propriétaire d'un autre abonnement, qu'il désabonne à sa destruction.
+ */
+class OwningObserver : public GameObserver {
+public:
+    ObserverRegistry* registry = nullptr; ///< Registre de l'abonnement possédé.
+    Subscription owned; ///< Abonnement désabonné par le destructeur.
+
+    ~OwningObserver() override {
+        registry->Unsubscribe(owned);
+    }
+
+    void OnEvent(const GameEvent&) override {}
+};
+
+/**
+ * @brief Teste le registre d'observateurs : poignées, filtres et modifications pendant une diffusion.
+ */
+void testObserverRegistry() {
+    ObserverRegistry registry;
+    auto all = std::make_shared<CountingObserver>();
+    auto scores = std::make_shared<CountingObserver>();
+    const Subscription all_handle = registry.Subscribe(all);
+    const Subscription score_handle = registry.Subscribe(scores, MaskOf(EventType::Score));
+    assert(registry.Size() == 2);
+    assert(registry.Count(EventType::Score) == 2 && registry.Count(EventType::Possession) == 1);
+
+    // Les observateurs non intéressés ne sont pas appelés
+    registry.Notify(GameEvent{EventType::Possession, 0, 0, 7, 1});
+    assert(all->received[1] == 1 && all->last.player == 7);
+    assert(scores->received[1] == 0);
+    registry.Notify(GameEvent{EventType::Score, 4, 2});
+    assert(all->received[0] == 1 && scores->received[0] == 1 && scores->last.homeScore == 4);
+
+    // Une poignée périmée est ignorée, même quand son emplacement est réutilisé
+    assert(registry.Unsubscribe(score_handle));
+    assert(!registry.Unsubscribe(score_handle));
+    auto reused = std::make_shared<CountingObserver>();
+    const Subscription reused_handle = registry.Subscribe(reused, MaskOf(EventType::Strategy));
+    assert(reused_handle.slot == score_handle.slot && reused_handle.generation != score_handle.generation);
+    assert(!registry.SetMask(score_handle, kAllEvents));
+    assert(registry.SetMask(reused_handle, MaskOf(EventType::Score)));
+    registry.Notify(GameEvent{EventType::Score, 6, 2});
+    assert(reused->received[0] == 1 && scores->received[0] == 1);
+
+    // Se désabonner et abonner un autre observateur depuis OnEvent : la diffusion en
+    // cours termine sur l'ancienne liste, la suivante voit la nouvelle
+    auto leaving = std::make_shared<CountingObserver>();
+    auto late = std::make_shared<CountingObserver>();
+    leaving->registry = &registry;
+    leaving->self = registry.Subscribe(leaving, MaskOf(EventType::Score));
+    leaving->added = late;
+    const int before = all->received[0];
+    registry.Notify(GameEvent{EventType::Score, 8, 2});
+    assert(leaving->received[0] == 1 && late->received[0] == 0 && all->received[0] == before + 1);
+    // L'instantané remplacé pendant la diffusion est libéré à sa fin, et avec lui l'observateur désabonné
+    assert(leaving.use_count() == 1);
+    registry.Notify(GameEvent{EventType::Score, 10, 2});
+    assert(leaving->received[0] == 1 && late->received[0] == 1);
+    assert(registry.Unsubscribe(all_handle));
+
+    // Le dernier instantané détruit un observateur qui se sert du registre : writer est déjà relâché
+    auto owning = std::make_shared<OwningObserver>();
+    owning->registry = &registry;
+    owning->owned = registry.Subscribe(std::make_shared<CountingObserver>());
+    const Subscription owning_handle = registry.Subscribe(owning);
+    const std::size_t subscribed = registry.Size();
+    owning.reset();
+    assert(registry.Unsubscribe(owning_handle));
+    assert(registry.Size() == subscribed - 2);
+
+    // Le moteur de match émet score, possession et stratégie
+    Match match;
+    auto watcher = std::make_shared<CountingObserver>();
+    match.events().Subscribe(watcher);
+    OffensiveStrategy offense;
+    match.coach(1).SetStrategy(&offense);
+    assert(watcher->received[2] == 1 && watcher->last.team == 1 && watcher->last.strategy == &offense);
+    match.run(2000);
+    assert(watcher->received[1] > 0);
+    const ScoreSnapshot live = match.live_score().Snapshot();
+    assert(watcher->received[0] == (live.home + live.away) / 2);
+
+    std::cout << "testObserverRegistry passed.\n";
+}
+
 /**
  * @brief Teste le fonctionnement du pattern Composite pour gérer les équipes.
  */
 void testCompositePattern() {
-    Player player1{Position{10, 20}, false, 1};
-    Player player2{Position{30, 40}, false, 2};
+    Player player1{Position{10, 20}, false, 1, {}, {}};
+    Player player2{Position{30, 40}, false, 2, {}, {}};
 
     PlayerLeaf leaf1(&player1); // Feuille représentant le joueur 1
     PlayerLeaf leaf2(&player2); // Feuille représentant le joueur 2
@@ -87,6 +233,1572 @@ void testCompositePattern() {
     std::cout << "testCompositePattern passed.\n";
 }
 
+/**
+ * @brief Teste le puits de sortie des rapports : formatage, seuil d'envoi, anneau et descripteur.
+ */
+void testOutputSink() {
+#ifndef BASKET_NULL_SINK
+    RingSink ring(256);
+    SetOutputSink(&ring);
+
+    RefereeDisplay referee;
+    referee.Update(3, 5);
+    Player player{Position{10.5f, 1.f / 3.f}, true, 7, {}, {}};
+    PlayerLeaf leaf(&player);
+    leaf.Display();
+    Coach coach;
+    coach.ObservePlayer(player);
+    assert(ring.Contents() == "[Arbitre] Score mis à jour : Home 3 - Away 5\n"
+                              "Joueur 7 à la position (10.5, 0.333333)\n"
+                              "Coach observe : Le joueur 7 a le ballon.\n");
+
+    // Seuil : les lignes restent dans le tampon du thread jusqu'à FlushReports().
+    ring.Clear();
+    SetReportFlushThreshold(4096);
+    for (int i = 0; i < 10; ++i) {
+        referee.Update(i, i);
+    }
+    assert(ring.Written() == 0);
+    FlushReports();
+    assert(ring.Written() > 0);
+    assert(ring.Contents().size() == ring.Capacity()); // L'anneau ne garde que la fin.
+    const std::string tail = ring.Contents();
+    const std::string last = "Home 9 - Away 9\n";
+    assert(tail.compare(tail.size() - last.size(), last.size(), last) == 0);
+
+    // Descripteur : un seul appel système pour tout le lot.
+    int fds[2];
+    assert(::pipe(fds) == 0);
+    FdSink fd(fds[1]);
+    SetOutputSink(&fd);
+    ReportLine() << "a " << 1;
+    ReportLine() << "b " << 2.5f;
+    FlushReports();
+    assert(fd.Syscalls() == 1);
+    char read_back[16] = {};
+    assert(::read(fds[0], read_back, sizeof(read_back)) == 10);
+    assert(std::strcmp(read_back, "a 1\nb 2.5\n") == 0);
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    SetReportFlushThreshold(0);
+    SetOutputSink(nullptr);
+#endif
+    std::cout << "testOutputSink passed.\n";
+}
+
+/**
+ * @brief Teste la hiérarchie d'équipes aplatie : sous-arbres, insertion, suppression et vue.
+ */
+void testTeamTree() {
+    std::vector<Player> players;
+    for (int i = 0; i < 8; ++i) {
+        players.push_back(Player{Position{1.f * i, 2.f * i}, false, i, {}, {}});
+    }
+
+    // Ligue -> deux équipes -> joueurs, construite dans le désordre pour forcer les décalages.
+    TeamTree tree;
+    const TeamTree::NodeId east = tree.AddGroup();
+    const TeamTree::NodeId west = tree.AddGroup();
+    for (int i = 4; i < 8; ++i) {
+        tree.AddLeaf(west, &players[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        tree.AddLeaf(east, &players[i]);
+    }
+    assert(tree.Size() == 11);
+    assert(tree.LeafCount() == 8);
+    assert(tree.AddLeaf(2, &players[0]) == TeamTree::kNone); // Le nœud 2 est un joueur.
+
+    const TeamTree::NodeId westNow = tree.SubtreeEnd(east);
+    assert(tree.At(westNow).kind == TeamTree::Kind::Group && tree.LeafCount(westNow) == 4);
+    int expected = 4;
+    tree.ForEachLeaf(westNow, [&](Player& player) { assert(player.number == expected++); });
+    for (TeamTree::NodeId i = 1; i < tree.Size(); ++i) {
+        assert(tree.At(i).parent < i && tree.SubtreeEnd(i) <= tree.SubtreeEnd(tree.At(i).parent));
+    }
+
+    assert(tree.Remove(east));
+    assert(tree.Size() == 6 && tree.At(1).kind == TeamTree::Kind::Group);
+    assert(tree.At(2).parent == 1 && tree.At(2).player->number == 4);
+    assert(!tree.Remove(TeamTree::kRoot));
+
+    // Aplatissement d'une hiérarchie composite existante et vue TeamComponent.
+    PlayerLeaf leaf1(&players[0]);
+    PlayerLeaf leaf2(&players[1]);
+    TeamComposite team;
+    team.Add(&leaf1);
+    team.Add(&leaf2);
+    const TeamTree::NodeId copied = tree.Append(TeamTree::kRoot, team);
+    assert(tree.LeafCount(copied) == 2 && tree.LeafCount() == 6);
+
+    TeamTree other;
+    TeamNodeView view(tree, copied);
+    const TeamComponent& component = view;
+    assert(other.Append(TeamTree::kRoot, component) == 1);
+    assert(other.Size() == 4 && other.At(3).player == &players[1]);
+    component.Display();
+
+    std::cout << "testTeamTree passed.\n";
+}
+
+/**
+ * @brief Teste les agrégats en cache de la hiérarchie aplatie et leur invalidation.
+ */
+void testTeamAggregates() {
+    std::vector<Player> players;
+    for (int i = 0; i < 20; ++i) {
+        players.push_back(Player{Position{1.f * i, 10.f}, false, i, {}, {}});
+    }
+
+    // Ligue -> 2 conférences -> 2 équipes chacune -> 5 joueurs.
+    TeamTree tree;
+    std::vector<TeamTree::NodeId> leaves;
+    for (int c = 0; c < 2; ++c) {
+        const TeamTree::NodeId conference = tree.AddGroup();
+        for (int t = 0; t < 2; ++t) {
+            const TeamTree::NodeId team = tree.AddGroup(conference);
+            for (int p = 0; p < 5; ++p) {
+                leaves.push_back(tree.AddLeaf(team, &players[10 * c + 5 * t + p]));
+            }
+        }
+    }
+
+    const TeamAggregate& league = tree.Aggregate();
+    assert(league.count == 20 && league.holder == nullptr);
+    assert(std::fabs(league.Centroid().x - 9.5f) < 1e-4f && league.Centroid().y == 10.f);
+    assert(league.min_x == 0.f && league.max_x == 19.f && league.min_y == 10.f && league.max_y == 10.f);
+    assert(std::fabs(league.Spread() - std::sqrt(33.25f)) < 1e-3f);
+    const std::uint64_t full = tree.Recomputations();
+    assert(full == 7);
+
+    // Un seul joueur bouge : seuls son équipe, sa conférence et la racine sont recalculées.
+    players[12].position = Position{40.f, 30.f};
+    players[12].possede_ball = true;
+    tree.Invalidate(leaves[12]);
+    const TeamAggregate& again = tree.Aggregate();
+    assert(tree.Recomputations() == full + 3);
+    assert(again.max_x == 40.f && again.max_y == 30.f && again.holder == &players[12]);
+
+    const TeamTree::NodeId firstConference = 1;
+    assert(tree.Aggregate(firstConference).holder == nullptr);
+    assert(tree.Aggregate(firstConference).max_x == 9.f);
+    assert(tree.Recomputations() == full + 3);
+
+    // Suppression d'une équipe : les ancêtres sont recalculés.
+    const TeamTree::NodeId secondConference = tree.SubtreeEnd(firstConference);
+    assert(tree.Remove(tree.SubtreeEnd(secondConference + 1)));
+    assert(tree.Aggregate().count == 15 && tree.Aggregate().holder == &players[12]);
+
+    std::cout << "testTeamAggregates passed.\n";
+}
+
+/**
+ * @brief Teste le calcul groupé des voisins par le PlayerPool face aux méthodes de Player.
+ */
+void testPlayerPoolNeighbours() {
+    std::vector<Player> players;
+    for (int i = 0; i < 10; ++i) {
+        players.push_back(Player{Position{static_cast<float>((i * 37) % 100), static_cast<float>((i * 13) % 50)},
+                                 false, i, {}, {}});
+    }
+
+    std::vector<Player> reference = players;
+    for (Player& player : reference) {
+        player.find_teammates(reference, player.number / 5);
+        player.find_opponents(reference, player.number / 5);
+    }
+
+    PlayerPool pool;
+    pool.Load(players);
+    pool.RefreshNeighbours(players);
+
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        for (int k = 0; k < PlayerPool::kTeammates; ++k) {
+            assert(players[i].Teammates[k]->number == reference[i].Teammates[k]->number);
+        }
+        for (int k = 0; k < PlayerPool::kOpponents; ++k) {
+            assert(players[i].Opponents[k]->number == reference[i].Opponents[k]->number);
+        }
+    }
+
+    std::cout << "testPlayerPoolNeighbours passed.\n";
+}
+
+/**
+ * @brief Teste le suivi incrémental des voisins contre un recalcul complet.
+ */
+void testNeighbourTracker() {
+    std::vector<Player> players;
+    for (int i = 0; i < 10; ++i) {
+        players.push_back(Player{Position{10.f + 8.f * i, 5.f + 4.f * (i % 7)}, false, i, {}, {}});
+    }
+    std::vector<Player> reference = players;
+    PlayerPool pool;
+    NeighbourTracker tracker;
+    tracker.Reset(players);
+
+    std::uint32_t state = 7;
+    for (int tick = 0; tick < 2000; ++tick) {
+        for (std::size_t i = 0; i < players.size(); ++i) {
+            state = state * 1664525u + 1013904223u;
+            const float step = tick % 500 < 250 ? 0.02f : 0.3f;
+            players[i].position.x += ((state >> 8) * (2.f / 16777216.f) - 1.f) * step;
+            state = state * 1664525u + 1013904223u;
+            players[i].position.y += ((state >> 8) * (2.f / 16777216.f) - 1.f) * step;
+            reference[i].position = players[i].position;
+        }
+        tracker.Update(players);
+        pool.RefreshNeighbours(reference);
+        for (std::size_t i = 0; i < players.size(); ++i) {
+            for (int k = 0; k < PlayerPool::kTeammates; ++k) {
+                assert(players[i].Teammates[k]->number == reference[i].Teammates[k]->number);
+            }
+            for (int k = 0; k < PlayerPool::kOpponents; ++k) {
+                assert(players[i].Opponents[k]->number == reference[i].Opponents[k]->number);
+            }
+        }
+    }
+    assert(tracker.TotalRepairs() > 0);
+    assert(tracker.TotalChecks() < 2000u * 20u);
+
+    std::cout << "testNeighbourTracker passed.\n";
+}
+
+/**
+ * @brief Teste le modèle de tir : tables de probabilité, valeur des tirs et report au score.
+ */
+void testShotModel() {
+    const float open = ShotModel::kContestRange;
+    assert(ShotModel::TypeAt(6.f) == ShotType::TwoPoint);
+    assert(ShotModel::TypeAt(ShotModel::kThreePointRange) == ShotType::ThreePoint);
+
+    // La réussite baisse avec la distance et avec la proximité du défenseur
+    float previous = 1.f;
+    for (float d = 0.f; d <= ShotModel::kMaxRange + 2.f; d += 0.37f) {
+        const float p = ShotModel::MakeProbability(d, open, ShotType::TwoPoint);
+        assert(p > 0.f && p <= previous);
+        previous = p;
+    }
+    assert(ShotModel::MakeProbability(1.f, open) > 0.6f);
+    assert(ShotModel::MakeProbability(1.f, 0.5f) < ShotModel::MakeProbability(1.f, 2.f));
+    assert(ShotModel::MakeProbability(1.f, 0.f) < 0.5f * ShotModel::MakeProbability(1.f, open) + 0.05f);
+    assert(ShotModel::MakeProbability(7.f, open) < ShotModel::MakeProbability(6.f, open));
+
+    // Résolution d'un tir : sans défenseur connu, le tir n'est pas gêné
+    Player shooter{Position{10.f, 10.f}, true, 0, {}, {}};
+    const Position basket{12.f, 10.f};
+    ShotResult shot = ShotModel::Resolve(shooter, basket, 0.f);
+    assert(shot.made && shot.type == ShotType::TwoPoint && shot.Points() == 2);
+    assert(shot.probability == ShotModel::MakeProbability(2.f, open));
+    assert(!ShotModel::Resolve(shooter, basket, 0.999f).made);
+
+    Player defender{Position{10.5f, 10.f}, false, 5, {}, {}};
+    shooter.Opponents[0] = &defender;
+    assert(ShotModel::Resolve(shooter, basket, 0.f).probability < shot.probability);
+
+    // Report au score
+    Gamescore score;
+    shooter.position = Position{4.f, 10.f};
+    shot = ShotModel::Resolve(shooter, basket, 0.f);
+    assert(shot.type == ShotType::ThreePoint);
+    ShotModel::Record(score, 1, shot);
+    ShotModel::Record(score, 0, ShotModel::Resolve(shooter, basket, 0.999f));
+    assert(score.homeScore == 0 && score.awayScore == 3);
+
+    // Le moteur de match marque aussi des paniers à trois points
+    Match match;
+    int total = 0;
+    int threes = 0;
+    for (int i = 0; i < 20000; ++i) {
+        match.tick();
+        const ScoreSnapshot live = match.live_score().Snapshot();
+        const int delta = live.home + live.away - total;
+        assert(delta == 0 || delta == 2 || delta == 3);
+        threes += delta == 3;
+        total += delta;
+    }
+    assert(threes > 0 && total > 3 * threes);
+
+    std::cout << "testShotModel passed.\n";
+}
+
+/**
+ * @brief Teste la boucle à pas fixe du moteur de match.
+ */
+void testMatchTick() {
+    Match match;
+    match.run(3000);
+    assert(match.tick_count() == 3000);
+    assert(match.ticks_per_second() > 0.0);
+
+    int holders = 0;
+    for (const Player& player : match.players()) {
+        assert(player.position.x >= 0.f && player.position.x <= basket_x);
+        assert(player.position.y >= 0.f && player.position.y <= basket_y);
+        holders += player.possede_ball ? 1 : 0;
+    }
+    assert(holders == 1);
+    assert(match.ballon().possesseur->possede_ball);
+    assert(match.score().homeScore + match.score().awayScore > 0);
+    const ScoreSnapshot live = match.live_score().Snapshot();
+    assert(match.score().homeScore == live.home && match.score().awayScore == live.away);
+
+    // Sans modèle de tir, chaque panier vaut deux points
+    MatchConfig config;
+    config.shot_model = false;
+    Match fixed(config);
+    fixed.run(3000);
+    assert(fixed.score().homeScore + fixed.score().awayScore > 0);
+    assert(fixed.score().homeScore % 2 == 0 && fixed.score().awayScore % 2 == 0);
+
+    std::cout << "testMatchTick passed.\n";
+}
+
+/**
+ * @brief Teste la sauvegarde et la reprise d'un match, et l'évaluation de stratégies par variantes.
+ */
+void testGameStateFork() {
+    Match original;
+    original.run(700);
+    const GameState saved = original.snapshot();
+    assert(saved.ticks == 700 && saved.holder == original.ballon().possesseur->number);
+
+    // Un état copié octet par octet reprend le match à l'identique
+    GameState copy;
+    std::memcpy(&copy, &saved, sizeof(GameState));
+    Match resumed;
+    resumed.restore(copy);
+    assert(resumed.ballon().possesseur == &resumed.players()[saved.holder]);
+    assert(resumed.players()[0].Teammates[0] != nullptr);
+    original.run(600);
+    resumed.run(600);
+    for (int i = 0; i < Match::kPlayers; ++i) {
+        assert(original.players()[i].position.x == resumed.players()[i].position.x);
+        assert(original.players()[i].position.y == resumed.players()[i].position.y);
+    }
+    assert(original.score().homeScore == resumed.score().homeScore);
+    assert(original.score().awayScore == resumed.score().awayScore);
+
+    // Sans porteur, le ballon revient au joueur 0 et le match continue
+    GameState loose = saved;
+    loose.holder = -1;
+    resumed.restore(loose);
+    assert(resumed.ballon().possesseur == &resumed.players()[0] && resumed.players()[0].possede_ball);
+    resumed.run(10);
+
+    // Les stratégies changent le jeu
+    OffensiveStrategy offense;
+    DefensiveStrategy defense;
+    WhatIf what_if;
+    const int attack = what_if.Fork(saved, 0, &offense, nullptr, 500, 77);
+    assert(what_if.Fork(saved, 0, &offense, nullptr, 500, 77) == attack);
+
+    // Évaluation des deux stratégies sans toucher au match évalué
+    const GameState before = original.snapshot();
+    Strategy* candidates[] = {&offense, &defense};
+    Strategy* best = what_if.Decide(original, 1, candidates, 2, 16, 250);
+    assert(best == &offense || best == &defense);
+    assert(original.coach(1).GetStrategy() == best);
+    assert(what_if.Outcomes().size() == 2 && what_if.Outcomes()[0].forks == 16);
+    assert(what_if.TotalForks() == 2 + 32);
+    const double best_margin = what_if.Outcomes()[best == &offense ? 0 : 1].mean_margin;
+    assert(best_margin >= what_if.Outcomes()[0].mean_margin && best_margin >= what_if.Outcomes()[1].mean_margin);
+    const GameState after = original.snapshot();
+    assert(std::memcmp(&before, &after, sizeof(GameState)) == 0);
+
+    std::cout << "testGameStateFork passed.\n";
+}
+
+/**
+ * @brief Teste la stratégie par recherche Monte-Carlo : budgets, statistiques et suivi des possessions.
+ */
+void testSearchStrategy() {
+    WorkStealingPool pool(2);
+    OffensiveStrategy offense;
+    DefensiveStrategy defense;
+    SearchConfig config;
+    config.rollouts = 64;
+    config.time_budget_ms = 0.0;
+    SearchStrategy search(pool, {&offense, &defense}, config);
+    assert(search.Chosen() == nullptr);
+    assert(search.GetTactics().marking == Tactics().marking);
+
+    Match match;
+    match.run(300);
+    const GameState before = match.snapshot();
+    Strategy* chosen = search.Decide(match, 0);
+    assert(chosen == &offense || chosen == &defense);
+    assert(search.Chosen() == chosen && search.Decisions() == 1);
+    const SearchStats& stats = search.LastSearch();
+    assert(stats.rollouts == 64);
+    assert(stats.depth >= 1 && stats.depth <= config.max_depth);
+    assert(stats.visits > 0 && stats.visits <= 64);
+    assert(stats.rollouts_per_second > 0.0);
+    assert(search.GetTactics().marking == chosen->GetTactics().marking);
+    const GameState after = match.snapshot();
+    assert(std::memcmp(&before, &after, sizeof(GameState)) == 0);
+
+    // Décision prise depuis un worker du pool : recherche en série, même résultat
+    SearchStrategy nested(pool, {&offense, &defense}, config);
+    pool.ParallelFor(1, [&](std::size_t, unsigned) { nested.Decide(match, 0); });
+    assert(nested.Chosen() == chosen && nested.LastSearch().rollouts == 64);
+    assert(nested.LastSearch().visits == stats.visits);
+
+    // Sans budget de temps, la décision ne dépend pas du nombre de workers
+    WorkStealingPool single(1);
+    SearchStrategy alone(single, {&offense, &defense}, config);
+    alone.Decide(match, 0);
+    assert(alone.Chosen() == chosen && alone.LastSearch().visits == stats.visits);
+    assert(alone.LastSearch().value == stats.value);
+
+    // Budget de temps seul
+    SearchConfig timed = config;
+    timed.rollouts = 0;
+    timed.time_budget_ms = 1.0;
+    SearchStrategy quick(pool, {&offense, &defense}, timed);
+    quick.Decide(match, 1);
+    assert(quick.LastSearch().rollouts > 0 && quick.LastSearch().elapsed_ms < 100.0);
+
+    // Décision à chaque possession gagnée par l'équipe 0
+    SearchConfig light = config;
+    light.rollouts = 8;
+    SearchStrategy coach(pool, {&offense, &defense}, light);
+    match.coach(0).SetStrategy(&coach);
+    coach.Attach(match, 0);
+    match.run(600);
+    const std::uint64_t decisions = coach.Decisions();
+    assert(decisions > 0);
+    coach.Detach();
+    match.run(600);
+    assert(coach.Decisions() == decisions);
+
+    std::cout << "testSearchStrategy passed.\n";
+}
+
+/**
+ * @brief Teste l'intégration groupée des déplacements : limites, bords et disposition AoSoA.
+ */
+void testMotionBatch() {
+    MotionLimits limits;
+    MotionBatch batch(3, limits);
+    assert(batch.Bodies() == 33 && batch.BlockCount() == 3);
+
+    // Accélération bornée : depuis l'arrêt, un pas donne au plus max_accel * dt
+    const float dt = 0.04f;
+    batch.SetBody(1, 4, Position{10.f, 10.f});
+    batch.SetAcceleration(1, 4, 300.f, 400.f);
+    batch.Step(dt);
+    Position v = batch.GetVelocity(1, 4);
+    assert(std::fabs(std::sqrt(v.x * v.x + v.y * v.y) - limits.player_accel * dt) < 1e-4f);
+    assert(std::fabs(v.x / v.y - 0.75f) < 1e-4f);
+
+    // Vitesse bornée, différente pour le ballon
+    for (int i = 0; i < 200; ++i) {
+        batch.SetAcceleration(1, MotionBatch::kBall, 1000.f, 0.f);
+        batch.Step(dt);
+    }
+    v = batch.GetVelocity(1, 4);
+    assert(std::sqrt(v.x * v.x + v.y * v.y) <= limits.player_speed * 1.0001f);
+    assert(batch.GetPosition(1, MotionBatch::kBall).x == basket_x);
+    assert(batch.GetVelocity(1, MotionBatch::kBall).x == 0.f);
+
+    // Un joueur poussé contre le bord s'y arrête, sans déborder
+    batch.SetBody(2, 9, Position{1.f, basket_y - 0.1f}, -5.f, 5.f);
+    batch.SetAcceleration(2, 9, 0.f, 0.f);
+    batch.Step(0.5f);
+    const Position p = batch.GetPosition(2, 9);
+    assert(p.x == 0.f && p.y == basket_y);
+    v = batch.GetVelocity(2, 9);
+    assert(v.x == 0.f && v.y == 0.f);
+
+    // Les cases de remplissage ne bougent pas
+    const MotionBlock& last = batch.Blocks()[batch.BlockCount() - 1];
+    for (int lane = 33 % MotionBlock::kLanes; lane < MotionBlock::kLanes; ++lane) {
+        assert(last.x[lane] == 0.f && last.vx[lane] == 0.f);
+    }
+
+    // Aller-retour avec les joueurs d'un match, y compris après redimensionnement
+    Match match;
+    batch.Resize(5);
+    batch.Load(4, match.players(), match.ballon());
+    batch.Store(4, match.players(), match.ballon());
+    assert(batch.GetPosition(4, 3).x == match.players()[3].position.x);
+    batch.SetAcceleration(4, 3, 10.f, 0.f);
+    batch.Step(dt);
+    batch.Store(4, match.players(), match.ballon());
+    assert(match.players()[3].position.x > batch.GetPosition(0, 3).x);
+
+    BasicMotionBatch<Rules3x3> small(2);
+    assert(small.Bodies() == 14 && small.BlockCount() == 1);
+    small.SetBody(1, 6, Position{Rules3x3::court_x, 1.f}, 3.f, 0.f);
+    small.Step(dt);
+    assert(small.GetPosition(1, 6).x == Rules3x3::court_x);
+
+    std::cout << "testMotionBatch passed.\n";
+}
+
+/**
+ * @brief Teste les variantes de jeu fixées à la compilation (3x3 et exercice 2x2).
+ */
+void testCompileTimeRosters() {
+    using Player3x3 = BasicPlayer<Rules3x3>;
+    static_assert(sizeof(Player3x3::Teammates) / sizeof(Player3x3*) == 2, "3x3 : deux coéquipiers");
+    static_assert(sizeof(Player3x3::Opponents) / sizeof(Player3x3*) == 3, "3x3 : trois adversaires");
+    static_assert(BasicMatch<RulesDrill2x2>::kPlayers == 4, "2x2 : quatre joueurs");
+    static_assert(Rules3x3::team_of(2) == 0 && Rules3x3::team_of(3) == 1, "3x3 : numérotation des équipes");
+
+    BasicMatch<Rules3x3> match;
+    match.run(3000);
+    assert(match.players().size() == 6);
+    int holders = 0;
+    for (const Player3x3& player : match.players()) {
+        assert(player.position.x >= 0.f && player.position.x <= Rules3x3::court_x);
+        assert(player.position.y >= 0.f && player.position.y <= Rules3x3::court_y);
+        for (const Player3x3* mate : player.Teammates) {
+            assert(mate && Rules3x3::team_of(mate->number) == Rules3x3::team_of(player.number));
+        }
+        for (const Player3x3* opponent : player.Opponents) {
+            assert(opponent && Rules3x3::team_of(opponent->number) != Rules3x3::team_of(player.number));
+        }
+        holders += player.possede_ball ? 1 : 0;
+    }
+    assert(holders == 1);
+    assert(match.score().homeScore + match.score().awayScore > 0);
+
+    BasicMatch<RulesDrill2x2> drill;
+    drill.run(1000);
+    assert(drill.tick_count() == 1000);
+
+    std::cout << "testCompileTimeRosters passed.\n";
+}
+
+/**
+ * @brief Teste l'évaluation des passes et le noyau de dégagement des lignes.
+ */
+void testPassEvaluator() {
+    // Noyau vectorisé contre référence scalaire (13 lignes : paquets de 8, de 4 et reste).
+    float rx[13], ry[13], ox[5], oy[5], out[13];
+    for (int i = 0; i < 13; ++i) {
+        rx[i] = 3.f * i - 10.f;
+        ry[i] = 7.f - 1.5f * i;
+    }
+    for (int o = 0; o < 5; ++o) {
+        ox[o] = 4.f * o - 6.f;
+        oy[o] = o % 2 ? 3.f : -2.f;
+    }
+    lane_clearances(1.f, 2.f, rx, ry, 13, ox, oy, 5, out);
+    for (int i = 0; i < 13; ++i) {
+        const float dx = rx[i] - 1.f, dy = ry[i] - 2.f;
+        float best = 1e30f;
+        for (int o = 0; o < 5; ++o) {
+            const float wx = ox[o] - 1.f, wy = oy[o] - 2.f;
+            const float t = std::fmin(std::fmax((wx * dx + wy * dy) / (dx * dx + dy * dy), 0.f), 1.f);
+            best = std::fmin(best, (wx - t * dx) * (wx - t * dx) + (wy - t * dy) * (wy - t * dy));
+        }
+        assert(std::fabs(out[i] - best) < 1e-3f);
+    }
+
+    // Le coéquipier le plus proche est masqué par un défenseur posé sur la ligne de passe.
+    std::vector<Player> players;
+    for (int i = 0; i < 10; ++i) {
+        players.push_back(Player{Position{50.f, 45.f}, false, i, {}, {}});
+    }
+    players[0].position = Position{50.f, 25.f};
+    players[1].position = Position{56.f, 25.f};
+    players[2].position = Position{50.f, 33.f};
+    players[3].position = Position{45.f, 15.f};
+    players[4].position = Position{40.f, 40.f};
+    players[5].position = Position{53.f, 25.f};
+    PlayerPool pool;
+    pool.RefreshNeighbours(players);
+    assert(players[0].Teammates[0] == &players[1]);
+
+    PassEvaluator evaluator;
+    assert(evaluator.Evaluate(players[0], Match::target_basket(0)) == PassEvaluator::kLanes);
+    const PassEvaluator::Option* best = evaluator.Best();
+    assert(best && best->receiver != &players[1]);
+    for (int i = 0; i < evaluator.Size(); ++i) {
+        const PassEvaluator::Option& option = evaluator.Ranked()[i];
+        assert(i == 0 || option.score <= evaluator.Ranked()[i - 1].score);
+        assert(option.receiver == players[0].Teammates[option.slot]);
+        if (option.receiver == &players[1]) {
+            assert(option.clearance < 1e-3f && !option.open);
+        }
+    }
+
+    std::cout << "testPassEvaluator passed.\n";
+}
+
+/**
+ * @brief Teste le score atomique (producteurs concurrents, lectures cohérentes) et le registre.
+ */
+void testMatchScore() {
+    MatchScore score;
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 10000;
+
+    // Chaque ajout vaut 1 point : tant que rien ne reboucle, home + away == séquence.
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        std::uint32_t last = 0;
+        while (!done.load()) {
+            const ScoreSnapshot s = score.Snapshot();
+            assert(static_cast<std::uint32_t>(s.home + s.away) == s.sequence);
+            assert(s.sequence >= last);
+            last = s.sequence;
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                score.Add((p + i) % 2, 1);
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    done = true;
+    reader.join();
+
+    const ScoreSnapshot final_score = score.Snapshot();
+    assert(final_score.home == kProducers * kPerProducer / 2);
+    assert(final_score.away == kProducers * kPerProducer / 2);
+    assert(final_score.sequence == kProducers * kPerProducer);
+
+    const ScoreSnapshot set = score.Set(98, 97);
+    assert(set.home == 98 && set.away == 97 && set.sequence == final_score.sequence + 1);
+    const ScoreSnapshot added = score.Add(1, 3);
+    assert(added.home == 98 && added.away == 100);
+
+    ScoreRegistry& registry = ScoreRegistry::Global();
+    assert(registry.Register(42, &score));
+    assert(!registry.Register(42, &score));
+    assert(registry.Find(42) == &score && registry.Find(43) == nullptr);
+    assert(registry.Unregister(42) && !registry.Unregister(42));
+
+    // Le moteur de match tient son score atomique et ses arbitres à jour ensemble.
+    Match match;
+    match.run(3000);
+    assert(match.live_score().Snapshot().home == match.score().homeScore);
+    assert(match.live_score().Snapshot().away == match.score().awayScore);
+
+    std::cout << "testMatchScore passed.\n";
+}
+
+/**
+ * @brief Teste l'exécution parallèle d'un lot de matchs et son déterminisme.
+ */
+void testBatchRunner() {
+    WorkStealingPool pool(4);
+    std::vector<int> visits(1000, 0);
+    pool.ParallelFor(visits.size(), [&](std::size_t i, unsigned) { ++visits[i]; });
+    for (int count : visits) {
+        assert(count == 1);
+    }
+    // Une boucle dans une boucle n'est pas servie par le pool
+    std::atomic<int> refused{0};
+    assert(pool.TryParallelFor(4, [&](std::size_t, unsigned) {
+        if (!pool.TryParallelFor(1, [](std::size_t, unsigned) {})) {
+            ++refused;
+        }
+    }));
+    assert(refused == 4);
+
+    BatchConfig config;
+    config.matches = 12;
+    config.ticks_per_match = 2000;
+
+    std::vector<MatchResult> parallel;
+    std::vector<MatchResult> sequential;
+    BatchRunner(4).Run(config, parallel);
+    BatchRunner(1).Run(config, sequential);
+
+    assert(parallel.size() == config.matches);
+    for (std::size_t i = 0; i < config.matches; ++i) {
+        assert(parallel[i].match_id == i);
+        assert(parallel[i].ticks == config.ticks_per_match);
+        assert(parallel[i].homeScore == sequential[i].homeScore);
+        assert(parallel[i].awayScore == sequential[i].awayScore);
+    }
+
+    std::cout << "testBatchRunner passed.\n";
+}
+
+/**
+ * @brief Comportement de test : compte ses reprises, une par tick, puis se termine.
+ */
+AgentTask CountTicks(int& counter, int ticks) {
+    for (int i = 0; i < ticks; ++i) {
+        ++counter;
+        co_await NextTick();
+    }
+}
+
+/**
+ * @brief Comportement de test : note le tick de sa reprise après une longue attente.
+ */
+AgentTask WakeAfter(const AgentScheduler& scheduler, std::uint64_t ticks, std::uint64_t& woke) {
+    co_await WaitTicks{0}; // Ne suspend pas
+    co_await WaitTicks{ticks};
+    woke = scheduler.TickCount();
+}
+
+/**
+ * @brief Teste l'ordonnanceur coopératif, les attentes, les comportements fournis et le recyclage des cadres.
+ */
+void testAgentScheduler() {
+    AgentScheduler scheduler(0.04f);
+    assert(scheduler.TicksFor(2.0) == 50 && scheduler.TicksFor(0.0) == 1);
+    assert(!scheduler.Spawn(AgentTask()));
+
+    // Couper (10 ticks), attendre 2 s (50 ticks), puis recevoir le ballon d'un coéquipier
+    Player cutter{Position{0.f, 0.f}, false, 0, {}, {}};
+    Player holder{Position{5.f, 5.f}, true, 1, {}, {}};
+    Ballon ball{holder.position, &holder};
+    assert(scheduler.Spawn(CutAndCall(cutter, ball, Position{10.f, 0.f}, 1.f, 2.0)));
+
+    Coach coach;
+    OffensiveStrategy offensive;
+    DefensiveStrategy defensive;
+    assert(scheduler.Spawn(AlternateStrategies(coach, &offensive, &defensive, 0.2)));
+    assert(scheduler.Size() == 2 && coach.GetStrategy() == nullptr);
+
+    scheduler.Tick();
+    assert(coach.GetStrategy() == &offensive && cutter.position.x == 1.f);
+    for (int t = 2; t <= 59; ++t) {
+        scheduler.Tick();
+    }
+    assert(cutter.position.x == 9.f && !cutter.possede_ball && ball.possesseur == &holder);
+    assert(coach.GetStrategy() == &defensive); // Ticks 1, 6, ..., 56 : 12 changements
+    scheduler.Tick();
+    assert(cutter.possede_ball && !holder.possede_ball && ball.possesseur == &cutter);
+    assert(scheduler.Size() == 1);
+
+    // Attente plus longue qu'un tour de roue
+    std::uint64_t woke = 0;
+    scheduler.Spawn(WakeAfter(scheduler, 600, woke));
+    const std::uint64_t spawned = scheduler.TickCount();
+    for (int t = 0; t < 700; ++t) {
+        scheduler.Tick();
+    }
+    assert(woke == spawned + 1 + 600);
+
+    // Les cadres des agents terminés sont recyclés sans nouveau bloc
+    AgentScheduler agents;
+    int counter = 0;
+    for (int i = 0; i < 1000; ++i) {
+        agents.Spawn(CountTicks(counter, 3));
+    }
+    while (agents.Size()) {
+        agents.Tick();
+    }
+    assert(counter == 3000 && agents.Resumes() == 4000);
+    const FramePoolStats before = LocalFramePoolStats();
+    for (int i = 0; i < 1000; ++i) {
+        agents.Spawn(CountTicks(counter, 1));
+    }
+    const FramePoolStats after = LocalFramePoolStats();
+    assert(after.allocations - before.allocations == 1000);
+    assert(after.reused - before.reused == 1000 && after.chunks == before.chunks);
+
+    std::cout << "testAgentScheduler passed.\n";
+}
+
+/**
+ * @brief Teste le générateur Philox : valeurs de référence, chemin vectorisé, flux et reproductibilité des matchs.
+ */
+void testCounterRng() {
+    const PhiloxBlock zero = Philox4x32(PhiloxBlock{{0, 0, 0, 0}}, PhiloxKey{{0, 0}});
+    assert(zero.c[0] == 0x6627e8d5u && zero.c[3] == 0x9b00dbd8u);
+
+    // Le chemin vectorisé et le reste scalaire donnent les blocs du calcul bloc par bloc
+    const PhiloxKey key = KeyFor(42, 48211);
+    const PhiloxBlock first{{1000, 7, 0, 1}};
+    std::vector<std::uint32_t> bulk(4 * 37);
+    PhiloxFill(key, first, 37, bulk.data());
+    for (std::uint32_t i = 0; i < 37; ++i) {
+        const PhiloxBlock block = Philox4x32(PhiloxBlock{{1000 + i, 7, 0, 1}}, key);
+        assert(std::memcmp(block.c, &bulk[4 * i], sizeof(block.c)) == 0);
+    }
+    std::vector<float> uniform(4 * 37 - 3);
+    PhiloxUniform(key, first, uniform.size(), uniform.data());
+    double sum = 0.0;
+    for (std::size_t i = 0; i < uniform.size(); ++i) {
+        assert(uniform[i] == ToUnitFloat(bulk[i]) && uniform[i] >= 0.f && uniform[i] < 1.f);
+        sum += uniform[i];
+    }
+    assert(std::fabs(sum / uniform.size() - 0.5) < 0.1);
+
+    CounterStream stream(key, 7, 0, static_cast<RandomStream>(1));
+    for (int i = 0; i < 8; ++i) {
+        stream.Next(); // Blocs 0 et 1
+    }
+    const PhiloxBlock third = Philox4x32(PhiloxBlock{{2, 7, 0, 1}}, key);
+    assert(stream.Next() == third.c[0] && stream.Below(10) < 10);
+
+    // Un match du lot se rejoue seul, et une reprise rejoue les mêmes tirages
+    BatchConfig config;
+    config.matches = 6;
+    config.ticks_per_match = 1500;
+    config.match.seed = 9;
+    std::vector<MatchResult> results;
+    BatchRunner(3).Run(config, results);
+    MatchConfig replay = config.match;
+    replay.match_id = 4;
+    Match alone(replay);
+    alone.run(750);
+    const GameState middle = alone.snapshot();
+    alone.run(750);
+    assert(alone.score().homeScore == results[4].homeScore && alone.score().awayScore == results[4].awayScore);
+
+    Match resumed(config.match);
+    resumed.restore(middle);
+    resumed.run(750);
+    const GameState a = alone.snapshot();
+    const GameState b = resumed.snapshot();
+    assert(std::memcmp(&a, &b, sizeof(GameState)) == 0);
+
+    // Un autre identifiant donne d'autres tirages
+    Match fourth(replay);
+    replay.match_id = 5;
+    Match fifth(replay);
+    fourth.run(10);
+    fifth.run(10);
+    const GameState s4 = fourth.snapshot();
+    const GameState s5 = fifth.snapshot();
+    assert(std::memcmp(s4.x, s5.x, sizeof(s4.x)) != 0);
+
+    std::cout << "testCounterRng passed.\n";
+}
+
+/**
+ * @brief Teste les statistiques par joueur : observations, passes, fusion et relevé sur un lot.
+ */
+void testPlayerStats() {
+    Player passer{Position{0.f, 0.f}, true, 0, {}, {}};
+    Player receiver{Position{10.f, 0.f}, false, 1, {}, {}};
+    Player opponent{Position{1.f, 0.f}, false, 5, {}, {}};
+    passer.Opponents[0] = &opponent;
+
+    PlayerStatsTable table(2.f);
+    assert(table.Observe(passer));
+    assert(table.Observe(receiver));
+    passer.position = Position{3.f, 4.f};
+    assert(!table.Observe(passer)); // Même possession : pas de changement
+    assert(table.Get(0).distance == 5.0);
+    assert(table.Get(0).possession_time == 2.0);
+    assert(table.Get(0).near_opponent_time == 1.0); // L'adversaire est à 1, puis à ~4.5
+
+    // Passe à un coéquipier, puis perte de balle vers l'autre équipe
+    passer.possede_ball = false;
+    receiver.possede_ball = true;
+    assert(table.Observe(passer));
+    assert(table.Observe(receiver));
+    receiver.possede_ball = false;
+    opponent.possede_ball = true;
+    table.Observe(opponent);
+    assert(table.Get(0).passes_made == 1 && table.Get(1).passes_received == 1);
+    assert(table.Get(5).passes_received == 0 && table.Holder() == 5);
+    assert(table.Size() == 6 && table.Get(9).observations == 0);
+
+    PlayerStatsTable other;
+    other.RecordPass(1, 7);
+    table.Merge(other);
+    assert(table.Size() == 8);
+    assert(table.Get(1).passes_made == 1 && table.Get(7).passes_received == 1);
+    assert(table.Get(0).observations == 3 && table.Get(0).passes_made == 1);
+
+#ifndef BASKET_NULL_SINK
+    // Le coach ne rapporte qu'un changement de possession
+    RingSink ring(256);
+    SetOutputSink(&ring);
+    Coach coach;
+    coach.ObservePlayer(receiver);
+    coach.ObservePlayer(receiver);
+    receiver.possede_ball = true;
+    coach.ObservePlayer(receiver);
+    FlushReports();
+    assert(ring.Contents() == "Coach observe : Le joueur 1 n'a pas le ballon.\n"
+                              "Coach observe : Le joueur 1 a le ballon.\n");
+    assert(coach.Stats().Get(1).observations == 3);
+    SetOutputSink(nullptr);
+#endif
+
+    // Lot : une table par worker, fusionnées ; les comptes ne dépendent pas du nombre de threads
+    BatchConfig config;
+    config.matches = 8;
+    config.ticks_per_match = 1000;
+    std::vector<MatchResult> results;
+    PlayerStatsTable parallel;
+    PlayerStatsTable sequential;
+    BatchRunner(4).Run(config, results, parallel);
+    BatchRunner(1).Run(config, results, sequential);
+    assert(parallel.Size() == static_cast<std::size_t>(Rules5x5::players));
+    double possession = 0.0;
+    std::uint32_t passes = 0;
+    for (int i = 0; i < Rules5x5::players; ++i) {
+        const PlayerStats a = parallel.Get(i);
+        const PlayerStats b = sequential.Get(i);
+        assert(a.observations == config.matches * config.ticks_per_match);
+        assert(a.passes_made == b.passes_made && a.passes_received == b.passes_received);
+        assert(a.possession_time == b.possession_time);
+        assert(std::fabs(a.distance - b.distance) <= 1e-9 * b.distance);
+        assert(a.distance > 0.0);
+        possession += a.possession_time;
+        passes += a.passes_made;
+    }
+    assert(possession == static_cast<double>(config.matches * config.ticks_per_match));
+    assert(passes > 0);
+
+    std::cout << "testPlayerStats passed.\n";
+}
+
+/**
+ * @brief Teste le binning des cartes d'occupation, leur réduction en arbre et leurs exports.
+ */
+void testHeatmap() {
+    // Grille 4 × 2 sur 8 × 4 : cases de 2 × 2 ; les positions hors grille vont au bord
+    Heatmap map(HeatmapGrid{4, 2, 8.f, 4.f}, 2);
+    const float xs[] = {0.f, 1.9f, 2.f, 7.9f, 8.f, -3.f, 100.f, 5.f, std::nanf(""), 3.f, 3.f};
+    const float ys[] = {0.f, 0.f, 0.f, 3.9f, 4.f, -1.f, 1.f, 2.f, 1.f, 1.f, 3.f};
+    assert(map.Add(xs, ys, 11, 0));
+    assert(!map.Add(xs, ys, 11, 2));
+    assert(map.Count(0, 0, 0) == 4); // 0, 1.9, -3 et NaN
+    assert(map.Count(0, 1, 0) == 2);
+    assert(map.Count(0, 3, 1) == 2);
+    assert(map.Count(0, 3, 0) == 1);
+    assert(map.Count(0, 2, 1) == 1 && map.Count(0, 1, 1) == 1);
+    assert(map.Total(0) == 11 && map.Total(1) == 0);
+
+    // Plus de positions qu'un paquet du noyau : chemin vectorisé et reste scalaire
+    std::vector<float> many_x(1000);
+    std::vector<float> many_y(1000);
+    for (std::size_t i = 0; i < many_x.size(); ++i) {
+        many_x[i] = static_cast<float>(i % 8);
+        many_y[i] = static_cast<float>(i % 4);
+    }
+    assert(map.Add(many_x.data(), many_y.data(), many_x.size(), 1));
+    assert(map.Total(1) == 1000);
+    assert(map.Count(1, 0, 0) == 250 && map.Count(1, 3, 1) == 250 && map.Count(1, 1, 0) == 0);
+
+    // Joueurs : couche du joueur et couche de son équipe
+    std::vector<Player> players;
+    for (int i = 0; i < Rules5x5::players; ++i) {
+        players.push_back(Player{Position{2.f * i + 2.5f, 3.f}, false, i, {}, {}});
+    }
+    Heatmap court(HeatmapGrid::ForCourt<Rules5x5>(50, 25), Heatmap::LayersFor<Rules5x5>());
+    court.AddPlayers(players);
+    court.AddPlayers(players);
+    for (int i = 0; i < Rules5x5::players; ++i) {
+        assert(court.Total(i) == 2 && court.Count(i, 1 + i, 1) == 2); // Cases de 2 × 2
+    }
+    assert(court.Total(Rules5x5::players) == 10 && court.Total(Rules5x5::players + 1) == 10);
+    Heatmap small(court.Grid(), Rules5x5::players);
+    small.AddPlayers(players); // Pas de couche d'équipe : ignorée
+    assert(small.Total(0) == 1);
+    assert(!small.Merge(court));
+
+    // Accumulateur : cinq cartes réduites en trois étapes
+    WorkStealingPool pool(3);
+    HeatmapAccumulator accumulator(map.Grid(), 2, 5);
+    for (unsigned w = 0; w < accumulator.Workers(); ++w) {
+        for (unsigned k = 0; k <= w; ++k) {
+            accumulator.Local(w).Add(xs, ys, 1, 0);
+        }
+    }
+    const Heatmap& total = accumulator.Reduce(pool);
+    assert(total.Count(0, 0, 0) == 15 && total.Total(0) == 15);
+    assert(accumulator.Local(4).Total(0) == 0);
+    accumulator.Local(2).Add(xs, ys, 1, 1);
+    accumulator.Resize(2);
+    assert(accumulator.Workers() == 2 && accumulator.Local(0).Total(1) == 1);
+
+    // Exports : binaire relu à l'identique, PGM avec la case la plus occupée en blanc
+    const std::string binPath = "test_heatmap.bin";
+    const std::string pgmPath = "test_heatmap.pgm";
+    assert(map.WriteBinary(binPath));
+    Heatmap loaded;
+    assert(Heatmap::ReadBinary(binPath, loaded));
+    assert(loaded.Layers() == 2 && loaded.Grid().cols == 4 && loaded.Grid().height == 4.f);
+    assert(std::memcmp(loaded.Layer(0), map.Layer(0), 2 * map.Cells() * sizeof(std::uint32_t)) == 0);
+
+    assert(map.WritePgm(pgmPath, 0));
+    assert(!map.WritePgm(pgmPath, 5));
+    assert(!Heatmap::ReadBinary(pgmPath, loaded));
+    std::FILE* pgm = std::fopen(pgmPath.c_str(), "rb");
+    char header[16] = {};
+    unsigned char pixels[8] = {};
+    assert(std::fread(header, 1, 11, pgm) == 11 && std::string(header) == "P5\n4 2\n255\n");
+    assert(std::fread(pixels, 1, 8, pgm) == 8);
+    std::fclose(pgm);
+    assert(pixels[4] == 255 && pixels[7] == 64); // Ligne du bas de l'image : y = 0
+    assert(pixels[3] == 128);
+
+    // Lot : une carte par worker, réduites ; le total ne dépend pas du nombre de threads
+    BatchConfig config;
+    config.matches = 6;
+    config.ticks_per_match = 500;
+    std::vector<MatchResult> results;
+    HeatmapAccumulator parallel(HeatmapGrid{}, Heatmap::LayersFor<Rules5x5>());
+    HeatmapAccumulator sequential(HeatmapGrid{}, Heatmap::LayersFor<Rules5x5>());
+    BatchRunner(4).Run(config, results, parallel);
+    BatchRunner(1).Run(config, results, sequential);
+    const Heatmap& a = parallel.Local(0);
+    const Heatmap& b = sequential.Local(0);
+    assert(a.Total(0) == config.matches * config.ticks_per_match);
+    assert(a.Total(Rules5x5::players) == 5 * config.matches * config.ticks_per_match);
+    assert(std::memcmp(a.Layer(0), b.Layer(0), a.Layers() * a.Cells() * sizeof(std::uint32_t)) == 0);
+
+    std::remove(binPath.c_str());
+    std::remove(pgmPath.c_str());
+    std::cout << "testHeatmap passed.\n";
+}
+
+/**
+ * @brief Teste l'encodage des colonnes, leur relecture projetée et l'export colonnaire d'un lot.
+ */
+void testColumnStore() {
+    using column_store::ColumnType;
+    using column_store::Encoding;
+    const std::string intPath = "test_column_int.col";
+    const std::string floatPath = "test_column_float.col";
+    const std::string stringPath = "test_column_string.col";
+
+    // Entiers : trois blocs, écarts négatifs et valeurs extrêmes
+    std::vector<std::int64_t> ints;
+    for (std::int64_t i = 0; i < 10000; ++i) {
+        ints.push_back(i % 7 == 0 ? -i : 3 * i);
+    }
+    ints[5000] = INT64_MIN;
+    ints[5001] = INT64_MAX;
+    ColumnWriter writer;
+    assert(writer.Open(intPath, "ints", ColumnType::Int64));
+    for (std::int64_t value : ints) {
+        assert(writer.AppendInt(value));
+    }
+    assert(!writer.AppendFloat(1.f));
+    assert(writer.Close());
+
+    ColumnReader reader;
+    assert(reader.Open(intPath));
+    assert(reader.Name() == "ints" && reader.Type() == ColumnType::Int64 && reader.Rows() == ints.size());
+    assert(reader.Blocks() == 3 && reader.Block(2).rows == 10000 - 2 * column_store::kBlockRows);
+    assert(reader.Stats().min_int == INT64_MIN && reader.Stats().max_int == INT64_MAX);
+    std::vector<std::int64_t> decoded;
+    assert(reader.ReadAll(decoded) && decoded == ints);
+    std::vector<float> wrong;
+    assert(!reader.ReadBlock(0, wrong));
+
+    // Suite croissante : un octet par valeur au lieu de huit
+    assert(writer.Open(intPath, "ids", ColumnType::Int64));
+    for (std::int64_t i = 0; i < 10000; ++i) {
+        writer.AppendInt(1000000 + i);
+    }
+    assert(writer.Close() && writer.Bytes() < 10000 + 16);
+    assert(reader.Open(intPath) && reader.ReadAll(decoded) && decoded.size() == 10000 && decoded[9999] == 1009999);
+
+    // Flottants : un bloc à peu de valeurs (dictionnaire), un bloc continu (bit-packé)
+    std::vector<float> floats;
+    for (std::size_t i = 0; i < column_store::kBlockRows; ++i) {
+        floats.push_back(static_cast<float>(i % 5) * 0.5f);
+    }
+    for (std::size_t i = 0; i < 1000; ++i) {
+        floats.push_back(100.f + static_cast<float>(i) * 0.001f);
+    }
+    floats.push_back(-2.5f);
+    floats.push_back(-0.f);
+    floats.push_back(std::nanf(""));
+    assert(writer.Open(floatPath, "floats", ColumnType::Float32));
+    for (float value : floats) {
+        assert(writer.AppendFloat(value));
+    }
+    assert(writer.Close());
+    assert(reader.Open(floatPath) && reader.Blocks() == 2);
+    assert(static_cast<Encoding>(reader.Block(0).encoding) == Encoding::Dictionary);
+    assert(static_cast<Encoding>(reader.Block(1).encoding) == Encoding::BitPacked);
+    assert(reader.Block(0).size < column_store::kBlockRows / 2);
+    assert(reader.Stats().min_float == -2.5 && reader.Stats().max_float == static_cast<double>(floats[5095]));
+    std::vector<float> values;
+    assert(reader.ReadAll(values) && values.size() == floats.size());
+    assert(std::memcmp(values.data(), floats.data(), floats.size() * sizeof(float)) == 0);
+
+    // Chaînes : dictionnaire du pied
+    assert(writer.Open(stringPath, "names", ColumnType::String));
+    const char* names[] = {"offensive", "defensive", "offensive", "none", ""};
+    for (const char* name : names) {
+        assert(writer.AppendString(name));
+    }
+    assert(writer.Close());
+    assert(reader.Open(stringPath));
+    assert(reader.ReadAll(decoded) && decoded.size() == 5);
+    for (std::size_t i = 0; i < decoded.size(); ++i) {
+        assert(reader.String(decoded[i]) == names[i]);
+    }
+    assert(decoded[0] == decoded[2] && reader.String(7).empty());
+
+    // Fichier tronqué : refusé
+    assert(truncate(stringPath.c_str(), 20) == 0);
+    assert(!reader.Open(stringPath));
+    assert(!reader.Open("test_column_missing.col"));
+
+    // Positions forgées dont la somme déborde et retombe dans le fichier : refusées
+    const auto forge = [&](std::uint64_t at, std::uint64_t value, std::size_t width) {
+        std::FILE* file = std::fopen(intPath.c_str(), "r+b");
+        assert(file && std::fseek(file, static_cast<long>(at), SEEK_SET) == 0);
+        assert(std::fwrite(&value, width, 1, file) == 1);
+        std::fclose(file);
+    };
+    std::uint32_t block_size = 0;
+    std::uint64_t bytes = 0;
+    const auto rewrite = [&] {
+        assert(writer.Open(intPath, "ids", ColumnType::Int64) && writer.AppendInt(1) && writer.Close());
+        assert(reader.Open(intPath));
+        block_size = reader.Block(0).size;
+        reader.Close();
+        column_store::Trailer trailer;
+        std::FILE* file = std::fopen(intPath.c_str(), "rb");
+        assert(file && std::fseek(file, -static_cast<long>(sizeof(trailer)), SEEK_END) == 0);
+        assert(std::fread(&trailer, sizeof(trailer), 1, file) == 1);
+        bytes = static_cast<std::uint64_t>(std::ftell(file));
+        std::fclose(file);
+        return trailer;
+    };
+    const column_store::Trailer trailer = rewrite();
+    forge(trailer.footer_offset + sizeof(column_store::Footer), UINT64_MAX - block_size + 1, sizeof(std::uint64_t));
+    assert(!reader.Open(intPath));
+    rewrite();
+    forge(bytes - sizeof(trailer), UINT64_MAX - 7, sizeof(std::uint64_t));
+    forge(bytes - sizeof(trailer) + 8, bytes - 8, sizeof(std::uint32_t));
+    assert(!reader.Open(intPath));
+
+    // Export d'un lot : deux stratégies, toutes les paires, une ligne par joueur et par match
+    const std::string directory = "test_columns";
+    OffensiveStrategy offense;
+    DefensiveStrategy defense;
+    BatchConfig config;
+    config.matches = 8;
+    config.ticks_per_match = 300;
+    config.strategies = {&offense, &defense};
+    std::vector<MatchResult> results;
+    ResultExporter exporter;
+    assert(exporter.Open(directory));
+    assert(BatchRunner(2).Run(config, results, exporter));
+    assert(exporter.Matches() == config.matches && exporter.PlayerRows() == config.matches * Rules5x5::players);
+    assert(exporter.Close());
+
+    std::vector<ColumnSchema> schema;
+    assert(ReadColumnSchema(directory + "/schema.bin", schema));
+    assert(schema.size() == ResultExporter::kMatchColumns + ResultExporter::kPlayerColumns);
+    assert(schema[0].name == "matches.match_id" && schema[0].rows == config.matches);
+    assert(schema.back().name == "players.passes_received" && schema.back().type == ColumnType::Int64);
+
+    std::vector<std::int64_t> ids;
+    std::vector<std::int64_t> home;
+    ColumnReader strategies;
+    assert(reader.Open(ResultExporter::ColumnPath(directory, "matches.match_id")) && reader.ReadAll(ids));
+    assert(reader.Open(ResultExporter::ColumnPath(directory, "matches.home_score")) && reader.ReadAll(home));
+    assert(strategies.Open(ResultExporter::ColumnPath(directory, "matches.away_strategy")));
+    assert(strategies.ReadAll(decoded));
+    for (std::size_t row = 0; row < ids.size(); ++row) {
+        const MatchResult& result = results[ids[row]];
+        assert(home[row] == result.homeScore);
+        assert(strategies.String(decoded[row]) == ((ids[row] / 2) % 2 ? "defensive" : "offensive"));
+    }
+    std::vector<std::int64_t> sorted(ids);
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        assert(sorted[i] == static_cast<std::int64_t>(i));
+    }
+
+    assert(reader.Open(ResultExporter::ColumnPath(directory, "players.observations")));
+    assert(reader.Stats().min_int == 300 && reader.Stats().max_int == 300);
+    assert(reader.Open(ResultExporter::ColumnPath(directory, "players.distance")));
+    assert(reader.ReadAll(values) && values.size() == config.matches * Rules5x5::players);
+    assert(reader.Stats().min_float > 0.0);
+    reader.Close();
+    strategies.Close();
+
+    for (const ColumnSchema& column : schema) {
+        std::remove(ResultExporter::ColumnPath(directory, column.name).c_str());
+    }
+    std::remove((directory + "/schema.bin").c_str());
+    rmdir(directory.c_str());
+    std::remove(intPath.c_str());
+    std::remove(floatPath.c_str());
+    std::remove(stringPath.c_str());
+    std::cout << "testColumnStore passed.\n";
+}
+
+/**
+ * @brief Arbitre de test comptant les événements reçus et les lots.
+ */
+class CountingArbitre : public Arbitre {
+public:
+    std::atomic<int> updates{0}; ///< Nombre d'événements reçus.
+    std::atomic<int> batches{0}; ///< Nombre de lots reçus.
+    std::atomic<int> lastHome{0}; ///< Dernier score à domicile reçu.
+
+    void Update(int homeScore, int) override {
+        ++updates;
+        lastHome = homeScore;
+    }
+
+    void UpdateBatch(const ScoreEvent* events, std::size_t count) override {
+        ++batches;
+        Arbitre::UpdateBatch(events, count);
+    }
+};
+
+/**
+ * @brief Arbitre de test qui retient le consommateur tant que la barrière est fermée.
+ */
+class GatedArbitre : public CountingArbitre {
+public:
+    std::atomic<bool> open{true}; ///< Barrière : le lot n'est traité qu'une fois ouverte.
+    std::atomic<bool> waiting{false}; ///< Le consommateur attend à la barrière.
+
+    void UpdateBatch(const ScoreEvent* events, std::size_t count) override {
+        waiting = true;
+        while (!open) {
+            std::this_thread::yield();
+        }
+        waiting = false;
+        CountingArbitre::UpdateBatch(events, count);
+    }
+};
+
+/**
+ * @brief Teste la notification asynchrone et groupée des arbitres.
+ */
+void testAsyncNotification() {
+    Gamescore score;
+    auto counter = std::make_shared<CountingArbitre>();
+    score.AddArbitre(counter);
+
+    score.EnableAsyncNotification(16, BackPressure::Block, 8);
+    for (int i = 1; i <= 100; ++i) {
+        score.UpdateScore(i, 0);
+    }
+    score.Notifier()->Flush();
+    assert(counter->updates == 100);
+    assert(counter->lastHome == 100);
+    assert(score.Notifier()->Dropped() == 0);
+    assert(score.Notifier()->Delivered() == 100);
+
+    score.EnableAsyncNotification(4, BackPressure::Coalesce, 4);
+    counter->updates = 0;
+    for (int i = 1; i <= 1000; ++i) {
+        score.UpdateScore(i, 0);
+    }
+    score.Notifier()->Flush();
+    assert(counter->lastHome == 1000);
+    assert(score.Notifier()->Delivered() + score.Notifier()->Coalesced() == 1000);
+    score.DisableAsyncNotification();
+
+    assert(score.Notifier() == nullptr);
+    score.UpdateScore(0, 0);
+    assert(counter->lastHome == 0);
+
+    // Drop : consommateur retenu, file de deux places pleine, les suivants sont abandonnés
+    auto gate = std::make_shared<GatedArbitre>();
+    {
+        AsyncNotifier notifier(2, BackPressure::Drop, 1);
+        notifier.SetObservers({gate});
+        gate->open = false;
+        notifier.Publish(1, 0);
+        while (!gate->waiting) {
+            std::this_thread::yield();
+        }
+        for (int i = 2; i <= 8; ++i) {
+            notifier.Publish(i, 0);
+        }
+        assert(notifier.Dropped() == 5);
+        gate->open = true;
+        notifier.Flush();
+        assert(notifier.Delivered() == 3 && gate->lastHome == 3);
+        assert(notifier.Delivered() + notifier.Dropped() == notifier.Published());
+    }
+
+    // Coalesce : un 0-0 fusionné n'est pas pris pour « aucun », et un score au-delà de
+    // 16 bits n'est pas tronqué
+    gate->updates = 0;
+    {
+        AsyncNotifier notifier(2, BackPressure::Coalesce, 1);
+        notifier.SetObservers({gate});
+        gate->open = false;
+        notifier.Publish(5, 0);
+        while (!gate->waiting) {
+            std::this_thread::yield();
+        }
+        notifier.Publish(6, 0);
+        notifier.Publish(7, 0);
+        notifier.Publish(0, 0);
+        gate->open = true;
+        notifier.Flush();
+        assert(notifier.Coalesced() == 0 && gate->updates == 4 && gate->lastHome == 0);
+        for (int i = 0; i < 100; ++i) {
+            notifier.Publish(70000 + i, 0);
+        }
+        notifier.Flush();
+        assert(gate->lastHome == 70099);
+    }
+
+    std::cout << "testAsyncNotification passed.\n";
+}
+
+/**
+ * @brief Teste l'écriture du journal binaire, la relecture et l'accès direct à un tick.
+ */
+void testMatchLogReplay() {
+    const std::string path = "test_match_log.bin";
+    Match match;
+    std::vector<LogFrame> expected;
+
+    MatchLogWriter writer(50);
+    assert(writer.Open(path));
+    for (int t = 0; t < 500; ++t) {
+        match.tick();
+        const Gamescore& score = match.score();
+        assert(writer.Append(match.players(), match.ballon(), score.homeScore, score.awayScore));
+
+        LogFrame frame;
+        frame.tick = t;
+        frame.possessor = static_cast<int>(match.ballon().possesseur - match.players().data());
+        frame.homeScore = score.homeScore;
+        frame.awayScore = score.awayScore;
+        for (const Player& player : match.players()) {
+            frame.positions.push_back(player.position);
+        }
+        expected.push_back(frame);
+    }
+    assert(writer.Close());
+
+    MatchLogReader reader;
+    assert(reader.Open(path));
+    assert(reader.Ticks() == 500);
+
+    std::uint64_t count = 0;
+    while (reader.Next()) {
+        const LogFrame& frame = reader.Current();
+        assert(frame.tick == count);
+        assert(frame.possessor == expected[count].possessor);
+        assert(frame.homeScore == expected[count].homeScore);
+        for (std::size_t i = 0; i < frame.positions.size(); ++i) {
+            assert(std::fabs(frame.positions[i].x - expected[count].positions[i].x) <= 1.f / 256);
+            assert(std::fabs(frame.positions[i].y - expected[count].positions[i].y) <= 1.f / 256);
+        }
+        ++count;
+    }
+    assert(count == 500);
+
+    assert(reader.Seek(377));
+    assert(reader.Current().tick == 377);
+    assert(reader.Current().awayScore == expected[377].awayScore);
+    assert(std::fabs(reader.Current().positions[3].x - expected[377].positions[3].x) <= 1.f / 256);
+    assert(!reader.Seek(500));
+    reader.Close();
+
+    // En-tête forgé : index dont la taille déborde, index mal aligné, première image clé après le tick
+    // demandé, puis dernier enregistrement tronqué
+    match_log::Header header;
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    assert(file && std::fread(&header, sizeof(header), 1, file) == 1);
+    const match_log::Header original = header;
+    header.index_count = UINT64_MAX / sizeof(match_log::IndexEntry) + 1;
+    assert(std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1);
+    std::fflush(file);
+    assert(!reader.Open(path));
+    header = original;
+    header.index_offset -= 4;
+    assert(std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1);
+    std::fflush(file);
+    assert(!reader.Open(path));
+    match_log::IndexEntry first;
+    assert(std::fseek(file, static_cast<long>(original.index_offset), SEEK_SET) == 0 &&
+           std::fread(&first, sizeof(first), 1, file) == 1);
+    const match_log::IndexEntry forged{first.tick + 1, first.offset};
+    assert(std::fseek(file, static_cast<long>(original.index_offset), SEEK_SET) == 0 &&
+           std::fwrite(&forged, sizeof(forged), 1, file) == 1);
+    assert(std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&original, sizeof(original), 1, file) == 1);
+    std::fflush(file);
+    assert(reader.Open(path) && !reader.Seek(first.tick));
+    reader.Close();
+    header = original;
+    header.index_offset -= 8;
+    header.index_count = 0;
+    assert(std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1);
+    std::fclose(file);
+    assert(reader.Open(path));
+    count = 0;
+    while (reader.Next()) {
+        ++count;
+    }
+    assert(count == 499 && !reader.Seek(0));
+
+    reader.Close();
+    std::remove(path.c_str());
+    std::cout << "testMatchLogReplay passed.\n";
+}
+
+/**
+ * @brief Teste la lecture en flux des fichiers de suivi CSV et binaires, sur des blocs minuscules.
+ */
+void testTrackingFeed() {
+    const std::string csvPath = "test_tracking.csv";
+    const std::string binPath = "test_tracking.bin";
+    const int frames = 200;
+
+    std::FILE* csv = std::fopen(csvPath.c_str(), "w");
+    std::FILE* bin = std::fopen(binPath.c_str(), "wb");
+    std::fprintf(csv, "frame,owner,ball_x,ball_y,p0_x,p0_y,p1_x,p1_y,p2_x,p2_y\n");
+    tracking::BinaryHeader header{};
+    std::memcpy(header.magic, tracking::kMagic, sizeof(header.magic));
+    header.players = 3;
+    header.rate_hz = 25;
+    std::fwrite(&header, sizeof(header), 1, bin);
+    for (int f = 0; f < frames; ++f) {
+        const int owner = f < 100 ? 0 : 1;
+        const float values[2 + 6] = {f * 0.5f, 10.f, f * 0.25f, 1.f, 2.f, 3.f, 4.f, f * 0.125f};
+        std::fprintf(csv, "%d,%d,%g,%g,%g,%g,%g,%g,%g,%g\r\n", f, owner, values[0], values[1], values[2],
+                     values[3], values[4], values[5], values[6], values[7]);
+        const std::uint32_t frame = f;
+        const std::int32_t owner32 = owner;
+        std::fwrite(&frame, 4, 1, bin);
+        std::fwrite(&owner32, 4, 1, bin);
+        std::fwrite(values, sizeof(float), 8, bin);
+    }
+    std::fclose(csv);
+    std::fclose(bin);
+
+    for (const std::string& path : {csvPath, binPath}) {
+        TrackingReader reader(37);
+        assert(reader.Open(path));
+        std::vector<Player> players(3, Player{Position{0.f, 0.f}, false, 0, {}, {}});
+        Ballon ballon{Position{0.f, 0.f}, nullptr};
+        TrackingRow row;
+        int count = 0;
+        while (reader.Next(row)) {
+            assert(row.frame == static_cast<std::uint32_t>(count));
+            assert(row.players == 3);
+            assert(row.coords[5] == count * 0.125f);
+            TrackingReader::Apply(row, players, ballon);
+            ++count;
+        }
+        assert(count == frames);
+        assert(reader.Errors() == 0 && reader.ReadError() == 0);
+        assert(reader.IsBinary() == (path == binPath));
+        assert(ballon.possesseur == &players[1] && players[1].possede_ball && !players[0].possede_ball);
+        assert(players[0].position.x == (frames - 1) * 0.25f);
+        assert(ballon.position.x == (frames - 1) * 0.5f);
+    }
+
+    // Une erreur de lecture n'est pas une fin de fichier : un répertoire s'ouvre mais ne se lit pas
+    {
+        TrackingReader failing(64);
+        TrackingRow row;
+        assert(failing.Open("."));
+        assert(!failing.Next(row) && failing.ReadError() == EISDIR);
+    }
+
+    TrackingReader reader(64);
+    assert(reader.Open(binPath));
+    TrackingReplay replay(3);
+    TrackingRow row;
+    const MetricsSnapshot before = ScrapeMetrics();
+    while (reader.Next(row)) {
+        replay.Apply(row);
+    }
+    assert(replay.Passes().passes == 1);
+    // La passe simulée pour comparaison n'est pas comptée comme une passe de match
+    const MetricsSnapshot after = ScrapeMetrics();
+    assert(after[Counter::PassesCompleted] == before[Counter::PassesCompleted]);
+    assert(after[Counter::PassesFailed] == before[Counter::PassesFailed]);
+    reader.Close();
+
+    // En-tête corrompu annonçant des milliards de joueurs : refusé sans allocation
+    header.players = UINT32_MAX;
+    bin = std::fopen(binPath.c_str(), "r+b");
+    std::fwrite(&header, sizeof(header), 1, bin);
+    std::fclose(bin);
+    assert(!reader.Open(binPath));
+
+    std::remove(csvPath.c_str());
+    std::remove(binPath.c_str());
+    std::cout << "testTrackingFeed passed.\n";
+}
+
+/**
+ * @brief Teste les compteurs par thread, leur fusion et leurs exports.
+ */
+void testMetrics() {
+    ResetMetrics();
+    Match match;
+    match.run(3000);
+    std::thread worker([] {
+        for (int i = 0; i < 1000; ++i) {
+            CountMetric(Counter::Ticks);
+        }
+        RecordLatency(Histogram::DispatchNs, 5);
+    });
+    worker.join();
+
+    const MetricsSnapshot snapshot = ScrapeMetrics();
+#ifdef BASKET_METRICS
+    // Le thread terminé a versé ses valeurs au cumul
+    assert(snapshot[Counter::Ticks] == 4000);
+    assert(snapshot[Counter::ShotsTaken] >= snapshot[Counter::ShotsMade]);
+    assert(snapshot[Counter::ShotsTaken] > 0);
+    assert(snapshot[Counter::PassesCompleted] + snapshot[Counter::PassesFailed] > 0);
+    assert(snapshot[Counter::NeighbourSearches] > 0);
+    // Même unité partout : une liste de coéquipiers ou d'adversaires recalculée
+    std::vector<Player> roster = match.players();
+    PlayerPool players;
+    players.Load(roster);
+    players.RefreshNeighbours(roster);
+    assert(ScrapeMetrics()[Counter::NeighbourSearches] == snapshot[Counter::NeighbourSearches] + 2 * roster.size());
+    const int tick = static_cast<int>(Histogram::TickNs);
+    const int dispatch = static_cast<int>(Histogram::DispatchNs);
+    assert(snapshot.count[tick] > 0 && snapshot.count[tick] <= 3000 / kLatencySampling + 1);
+    assert(snapshot.buckets[dispatch][3] >= 1); // 5 ns dans [4, 8)
+#else
+    assert(snapshot[Counter::Ticks] == 0);
+#endif
+
+    const std::string promPath = "test_metrics.prom";
+    const std::string jsonPath = "test_metrics.json";
+    assert(DumpMetrics(promPath, MetricsFormat::Prometheus));
+    assert(DumpMetrics(jsonPath, MetricsFormat::Json));
+    assert(!DumpMetrics("missing_directory/metrics.prom", MetricsFormat::Prometheus));
+
+    const auto read = [](const std::string& path) {
+        std::string text;
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        char chunk[4096];
+        std::size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            text.append(chunk, n);
+        }
+        std::fclose(file);
+        return text;
+    };
+    const std::string prom = read(promPath);
+    const std::string json = read(jsonPath);
+    const std::string ticks = std::to_string(snapshot[Counter::Ticks]);
+    assert(prom.find("basket_ticks_total " + ticks + "\n") != std::string::npos);
+    assert(prom.find("basket_tick_ns_bucket{le=\"+Inf\"} ") != std::string::npos);
+    assert(json.front() == '{' && json.find("\"ticks\":" + ticks) != std::string::npos);
+    assert(json.find("\"dispatch_ns\":{\"bounds\":[0,1,3,") != std::string::npos);
+
+    ResetMetrics();
+    assert(ScrapeMetrics()[Counter::Ticks] == 0);
+    std::remove(promPath.c_str());
+    std::remove(jsonPath.c_str());
+    std::cout << "testMetrics passed.\n";
+}
+
 /**
  * @brief Point d'entrée principal pour exécuter tous les tests unitaires.
  * 
@@ -94,13 +1806,58 @@ void testCompositePattern() {
  * - Les calculs de distances.
  * - Le changement de possesseur du ballon.
  * - Les patterns Singleton, Observer et Composite.
+ * - Le registre d'observateurs par poignées et ses filtres d'événements.
+ * - Le puits de sortie des rapports.
+ * - La hiérarchie d'équipes aplatie et ses agrégats en cache.
+ * - Le calcul groupé des voisins du PlayerPool.
+ * - Le suivi incrémental des voisins.
+ * - Le modèle de tir et ses tables de probabilité.
+ * - La boucle à pas fixe du moteur de match.
+ * - La sauvegarde d'un match et l'évaluation de stratégies par variantes.
+ * - Le choix de stratégie par recherche arborescente Monte-Carlo.
+ * - L'intégration vectorisée des déplacements de plusieurs matchs.
+ * - Le score atomique et le registre des scores.
+ * - Les variantes de jeu fixées à la compilation.
+ * - L'évaluation des passes selon les lignes d'interception.
+ * - L'exécution parallèle d'un lot de matchs.
+ * - Les statistiques par joueur et leur fusion entre workers.
+ * - Le générateur à compteur Philox et la reproductibilité des matchs.
+ * - Les comportements en coroutines et leur ordonnanceur coopératif.
+ * - La notification asynchrone des arbitres.
+ * - Le journal binaire des matchs et sa relecture.
+ * - La lecture en flux des fichiers de suivi.
+ * - Les compteurs des chemins critiques et leurs exports.
  */
 int main() {
     testPositionDistance();
     testBallonChangerPossesseur();
     testSingletonPattern();
     testObserverPattern();
+    testObserverRegistry();
     testCompositePattern();
+    testOutputSink();
+    testTeamTree();
+    testTeamAggregates();
+    testPlayerPoolNeighbours();
+    testNeighbourTracker();
+    testShotModel();
+    testMatchTick();
+    testGameStateFork();
+    testSearchStrategy();
+    testMotionBatch();
+    testCompileTimeRosters();
+    testPassEvaluator();
+    testMatchScore();
+    testBatchRunner();
+    testPlayerStats();
+    testHeatmap();
+    testColumnStore();
+    testCounterRng();
+    testAgentScheduler();
+    testAsyncNotification();
+    testMatchLogReplay();
+    testTrackingFeed();
+    testMetrics();
 
     std::cout << "Tous les tests unitaires ont été exécutés avec succès.\n";
     return 0;
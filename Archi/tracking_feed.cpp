@@ -0,0 +1,463 @@
+#include "tracking_feed.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kCarryReserve = 4096; ///< Capacité initiale du tampon de raccord.
+constexpr std::size_t kCoordsReserve = 64; ///< Capacité initiale des positions (32 joueurs).
+
+/**
+ * @brief Saute un séparateur `,` éventuellement entouré d'espaces.
+ * @return Position après le séparateur, ou nullptr s'il est absent.
+ */
+const char* skip_separator(const char* p, const char* last) {
+    while (p < last && *p == ' ') {
+        ++p;
+    }
+    if (p == last || *p != ',') {
+        return nullptr;
+    }
+    ++p;
+    while (p < last && *p == ' ') {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief Analyse un nombre avec std::from_chars.
+ * @return Position après le nombre, ou nullptr en cas d'erreur.
+ */
+template <typename T>
+const char* parse_number(const char* p, const char* last, T& value) {
+    const std::from_chars_result result = std::from_chars(p, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+} // namespace
+
+/**
+ * @brief Constructeur.
+ * @param chunk_size Taille de chaque tampon.
+ */
+ChunkPrefetcher::ChunkPrefetcher(std::size_t chunk_size) {
+    buffers[0].resize(chunk_size);
+    buffers[1].resize(chunk_size);
+}
+
+/**
+ * @brief Destructeur : arrête le thread de lecture.
+ */
+ChunkPrefetcher::~ChunkPrefetcher() {
+    Stop();
+}
+
+/**
+ * @brief Démarre la lecture d'un descripteur déjà ouvert.
+ * @param descriptor Descripteur à lire.
+ * @param offset Position de départ.
+ */
+void ChunkPrefetcher::Start(int descriptor, std::size_t offset) {
+    Stop();
+    fd = descriptor;
+    stopping = false;
+    current = 0;
+    slots[0] = slots[1] = Slot::Empty;
+    error.store(0);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    reader = std::thread(&ChunkPrefetcher::ReadLoop, this, offset);
+}
+
+/**
+ * @brief Arrête la lecture et ferme le descripteur.
+ */
+void ChunkPrefetcher::Stop() {
+    if (reader.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        reader.join();
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+/**
+ * @brief Boucle du thread de lecture : remplit alternativement les deux tampons.
+ *
+ * Une lecture interrompue (EINTR) est reprise ; toute autre erreur est notée dans error
+ * et termine le flux après le dernier bloc lu.
+ *
+ * @param offset Position de départ.
+ */
+void ChunkPrefetcher::ReadLoop(std::size_t offset) {
+    off_t position = static_cast<off_t>(offset);
+    int slot = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return stopping || slots[slot] == Slot::Empty; });
+            if (stopping) {
+                return;
+            }
+        }
+
+        std::vector<char>& buffer = buffers[slot];
+        std::size_t filled = 0;
+        while (filled < buffer.size() && error.load() == 0) {
+            const ssize_t n = ::pread(fd, buffer.data() + filled, buffer.size() - filled, position);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0) {
+                error.store(errno);
+            }
+            if (n <= 0) {
+                break;
+            }
+            filled += static_cast<std::size_t>(n);
+            position += n;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sizes[slot] = filled;
+            slots[slot] = filled ? Slot::Full : Slot::End;
+        }
+        changed.notify_all();
+        if (!filled) {
+            return;
+        }
+        slot ^= 1;
+    }
+}
+
+/**
+ * @brief Attend le bloc suivant.
+ * @param data Début du bloc.
+ * @param size Taille du bloc.
+ * @return False en fin de fichier.
+ */
+bool ChunkPrefetcher::Acquire(const char*& data, std::size_t& size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return slots[current] != Slot::Empty; });
+    if (slots[current] == Slot::End) {
+        return false;
+    }
+    data = buffers[current].data();
+    size = sizes[current];
+    return true;
+}
+
+/**
+ * @brief Rend le bloc obtenu par Acquire() au thread de lecture.
+ */
+void ChunkPrefetcher::Release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slots[current] = Slot::Empty;
+        current ^= 1;
+    }
+    changed.notify_all();
+}
+
+/**
+ * @brief Constructeur.
+ * @param chunk_size Taille des blocs lus en arrière-plan.
+ */
+TrackingReader::TrackingReader(std::size_t chunk_size) : prefetcher(chunk_size) {
+    carry.reserve(kCarryReserve);
+    coords.reserve(kCoordsReserve);
+}
+
+/**
+ * @brief Ouvre un fichier de suivi et détecte son format.
+ * @param path Chemin du fichier.
+ * @return False si le fichier n'a pas pu être ouvert ou si son en-tête annonce plus de
+ *         tracking::kMaxPlayers joueurs.
+ */
+bool TrackingReader::Open(const std::string& path) {
+    Close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    tracking::BinaryHeader header{};
+    const bool has_header = ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    binary = has_header && std::memcmp(header.magic, tracking::kMagic, sizeof(header.magic)) == 0;
+    if (binary && header.players > tracking::kMaxPlayers) {
+        ::close(fd);
+        return false;
+    }
+    players = binary ? header.players : 0;
+    coords.assign(2 * players, 0.f);
+
+    rows = 0;
+    errors = 0;
+    carry.clear();
+    carry_done = false;
+    holding = false;
+    cursor = end = nullptr;
+    prefetcher.Start(fd, binary ? sizeof(header) : 0);
+    open = true;
+    return true;
+}
+
+/**
+ * @brief Ferme le fichier.
+ */
+void TrackingReader::Close() {
+    prefetcher.Stop();
+    open = false;
+    holding = false;
+}
+
+/**
+ * @brief Décode l'image suivante.
+ * @param row Image décodée.
+ * @return False en fin de fichier ou après une erreur de lecture (voir ReadError()).
+ */
+bool TrackingReader::Next(TrackingRow& row) {
+    if (!open) {
+        return false;
+    }
+    const char* first;
+    const char* last;
+    while (NextRecord(first, last)) {
+        if (binary) {
+            ParseBinary(first, row);
+        } else if (!ParseCsv(first, last, row)) {
+            continue;
+        }
+        row.coords = coords.data();
+        row.players = players;
+        ++rows;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Extrait le prochain enregistrement brut.
+ *
+ * L'enregistrement pointe directement dans le bloc courant, sauf s'il est à cheval
+ * sur deux blocs : il est alors reconstitué dans le tampon de raccord.
+ *
+ * @param first Début de l'enregistrement.
+ * @param last Fin de l'enregistrement.
+ * @return False en fin de fichier.
+ */
+bool TrackingReader::NextRecord(const char*& first, const char*& last) {
+    const std::size_t fixed = tracking::record_size(static_cast<std::uint32_t>(players));
+    if (carry_done) {
+        carry.clear();
+        carry_done = false;
+    }
+
+    for (;;) {
+        if (holding && cursor == end) {
+            prefetcher.Release();
+            holding = false;
+        }
+        if (!holding) {
+            const char* data;
+            std::size_t size;
+            if (!prefetcher.Acquire(data, size)) {
+                if (!binary && !carry.empty()) {
+                    first = carry.data();
+                    last = first + carry.size();
+                    carry_done = true;
+                    return true;
+                }
+                return false;
+            }
+            cursor = data;
+            end = data + size;
+            holding = true;
+        }
+
+        const std::size_t available = static_cast<std::size_t>(end - cursor);
+        if (binary) {
+            if (carry.empty() && available >= fixed) {
+                first = cursor;
+                last = cursor + fixed;
+                cursor += fixed;
+                return true;
+            }
+            const std::size_t take = std::min(fixed - carry.size(), available);
+            carry.insert(carry.end(), cursor, cursor + take);
+            cursor += take;
+            if (carry.size() == fixed) {
+                first = carry.data();
+                last = first + fixed;
+                carry_done = true;
+                return true;
+            }
+        } else {
+            const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', available));
+            if (newline) {
+                if (carry.empty()) {
+                    first = cursor;
+                    last = newline;
+                } else {
+                    carry.insert(carry.end(), cursor, newline);
+                    first = carry.data();
+                    last = first + carry.size();
+                    carry_done = true;
+                }
+                cursor = newline + 1;
+                return true;
+            }
+            carry.insert(carry.end(), cursor, end);
+            cursor = end;
+        }
+    }
+}
+
+/**
+ * @brief Analyse une ligne CSV `frame,owner,ball_x,ball_y,p0_x,p0_y,...`.
+ *
+ * Le nombre de joueurs est fixé par la première image ; les lignes suivantes doivent
+ * en contenir autant.
+ *
+ * @param first Début de la ligne.
+ * @param last Fin de la ligne.
+ * @param row Image décodée.
+ * @return False si la ligne n'est pas une image valide.
+ */
+bool TrackingReader::ParseCsv(const char* first, const char* last, TrackingRow& row) {
+    if (last > first && last[-1] == '\r') {
+        --last;
+    }
+    if (first == last || *first < '0' || *first > '9') {
+        return false;
+    }
+
+    const char* p = parse_number(first, last, row.frame);
+    p = p ? skip_separator(p, last) : nullptr;
+    p = p ? parse_number(p, last, row.owner) : nullptr;
+    p = p ? skip_separator(p, last) : nullptr;
+    p = p ? parse_number(p, last, row.ball.x) : nullptr;
+    p = p ? skip_separator(p, last) : nullptr;
+    p = p ? parse_number(p, last, row.ball.y) : nullptr;
+    if (!p) {
+        ++errors;
+        return false;
+    }
+
+    std::size_t count = 0;
+    while (p && p < last) {
+        p = skip_separator(p, last);
+        float value;
+        p = p ? parse_number(p, last, value) : nullptr;
+        if (!p) {
+            break;
+        }
+        if (players == 0) {
+            coords.push_back(value);
+        } else if (count < coords.size()) {
+            coords[count] = value;
+        }
+        ++count;
+    }
+
+    if (!p || count % 2 != 0 || (players != 0 && count != 2 * players)) {
+        if (players == 0) {
+            coords.clear();
+        }
+        ++errors;
+        return false;
+    }
+    players = count / 2;
+    return true;
+}
+
+/**
+ * @brief Décode un enregistrement binaire.
+ * @param first Début de l'enregistrement.
+ * @param row Image décodée.
+ */
+void TrackingReader::ParseBinary(const char* first, TrackingRow& row) {
+    std::int32_t owner;
+    std::memcpy(&row.frame, first, 4);
+    std::memcpy(&owner, first + 4, 4);
+    std::memcpy(&row.ball.x, first + 8, 4);
+    std::memcpy(&row.ball.y, first + 12, 4);
+    std::memcpy(coords.data(), first + 16, coords.size() * sizeof(float));
+    row.owner = owner;
+}
+
+/**
+ * @brief Recopie une image dans l'état des joueurs et du ballon.
+ * @param row Image à appliquer.
+ * @param players Joueurs.
+ * @param ballon Ballon.
+ */
+void TrackingReader::Apply(const TrackingRow& row, std::vector<Player>& players, Ballon& ballon) {
+    const std::size_t n = std::min(row.players, players.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        players[i].position = Position{row.coords[2 * i], row.coords[2 * i + 1]};
+    }
+    ballon.position = row.ball;
+
+    Player* owner = row.owner >= 0 && static_cast<std::size_t>(row.owner) < n ? &players[row.owner] : nullptr;
+    if (ballon.possesseur != owner) {
+        if (ballon.possesseur) {
+            ballon.possesseur->possede_ball = false;
+        }
+        ballon.possesseur = owner;
+    }
+    if (owner) {
+        owner->possede_ball = true;
+    }
+}
+
+/**
+ * @brief Constructeur.
+ * @param players Nombre de joueurs.
+ */
+TrackingReplay::TrackingReplay(std::size_t players) : pool(players) {
+    roster.reserve(players);
+    for (std::size_t i = 0; i < players; ++i) {
+        roster.push_back(Player{Position{0.f, 0.f}, false, static_cast<int>(i), {}, {}});
+    }
+    pool.Load(roster);
+}
+
+/**
+ * @brief Applique une image et, en cas de passe, la compare au choix du modèle.
+ *
+ * Une passe est un changement de possesseur entre deux coéquipiers. Le choix du modèle
+ * est calculé sur l'état précédant la passe.
+ *
+ * @param row Image à appliquer.
+ */
+void TrackingReplay::Apply(const TrackingRow& row) {
+    const int next = row.owner >= 0 && static_cast<std::size_t>(row.owner) < roster.size() ? row.owner : -1;
+    if (owner >= 0 && next >= 0 && next != owner &&
+        Rules5x5::team_of(owner) == Rules5x5::team_of(next)) {
+        pool.RefreshNeighbours(roster);
+        Ballon probe{ball.position, &roster[owner]};
+        ++passes.passes;
+        if (probe.changer_possesseur() && probe.possesseur == &roster[next]) {
+            ++passes.agreed;
+        }
+    }
+
+    TrackingReader::Apply(row, roster, ball);
+    if (next >= 0) {
+        owner = next;
+    }
+}
@@ -0,0 +1,264 @@
+/**
+ * @file tracking_feed.hpp
+ * @brief Lecture en flux des données de suivi optique (CSV ou binaire) vers l'état des joueurs et du ballon.
+ */
+
+#ifndef TRACKING_FEED_HPP
+#define TRACKING_FEED_HPP
+
+#include "basket.hpp"
+#include "player_pool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Formats de fichiers de suivi.
+ *
+ * - CSV : une ligne par image, `frame,owner,ball_x,ball_y,p0_x,p0_y,...` ; `owner` est l'indice
+ *   du joueur en possession (-1 si aucun). Les lignes ne commençant pas par un chiffre
+ *   (en-tête, commentaires) sont ignorées.
+ * - Binaire : un en-tête BinaryHeader puis des enregistrements fixes
+ *   `uint32 frame, int32 owner, float ball_x, float ball_y, float xy[2 * players]`.
+ */
+namespace tracking {
+
+constexpr char kMagic[8] = {'B', 'S', 'K', 'T', 'R', 'K', '1', '\0'}; ///< Signature du format binaire.
+constexpr std::uint32_t kMaxPlayers = 1024; ///< Joueurs par image au plus : un en-tête au-delà est refusé.
+
+/**
+ * @brief En-tête d'un fichier de suivi binaire.
+ */
+struct BinaryHeader {
+    char magic[8]; ///< Signature kMagic.
+    std::uint32_t players; ///< Nombre de joueurs par image.
+    std::uint32_t rate_hz; ///< Fréquence d'acquisition.
+};
+
+/**
+ * @brief Taille d'un enregistrement binaire.
+ * @param players Nombre de joueurs par image.
+ * @return La taille en octets.
+ */
+constexpr std::size_t record_size(std::uint32_t players) { return 16 + 8 * static_cast<std::size_t>(players); }
+
+} // namespace tracking
+
+/**
+ * @brief Image de suivi décodée.
+ *
+ * @ref coords pointe dans un tampon du lecteur, réutilisé d'une image à l'autre :
+ * l'image n'est valide que jusqu'au prochain appel à TrackingReader::Next().
+ */
+struct TrackingRow {
+    std::uint32_t frame = 0; ///< Numéro d'image.
+    int owner = -1; ///< Indice du joueur en possession, -1 si aucun.
+    Position ball{0.f, 0.f}; ///< Position du ballon.
+    const float* coords = nullptr; ///< Positions des joueurs (x, y entrelacés).
+    std::size_t players = 0; ///< Nombre de joueurs.
+};
+
+/**
+ * @brief Lit un fichier par blocs sur un thread d'arrière-plan, avec double tampon.
+ *
+ * Pendant que le consommateur analyse un bloc, le thread lit le suivant dans l'autre tampon.
+ */
+class ChunkPrefetcher {
+public:
+    /**
+     * @brief Constructeur.
+     * @param chunk_size Taille de chaque tampon.
+     */
+    explicit ChunkPrefetcher(std::size_t chunk_size);
+
+    /**
+     * @brief Destructeur : arrête le thread de lecture.
+     */
+    ~ChunkPrefetcher();
+
+    ChunkPrefetcher(const ChunkPrefetcher&) = delete; ///< Non copiable.
+    ChunkPrefetcher& operator=(const ChunkPrefetcher&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Démarre la lecture d'un descripteur déjà ouvert (dont le prefetcher devient propriétaire).
+     * @param fd Descripteur à lire.
+     * @param offset Position de départ.
+     */
+    void Start(int fd, std::size_t offset);
+
+    /**
+     * @brief Arrête la lecture et ferme le descripteur.
+     */
+    void Stop();
+
+    /**
+     * @brief Attend le bloc suivant.
+     * @param data Début du bloc.
+     * @param size Taille du bloc.
+     * @return False en fin de fichier ou après une erreur de lecture.
+     */
+    bool Acquire(const char*& data, std::size_t& size);
+
+    /**
+     * @brief Rend le bloc obtenu par Acquire() au thread de lecture.
+     */
+    void Release();
+
+    int Error() const { return error.load(); } ///< errno de la lecture échouée, 0 si aucune.
+
+private:
+    enum class Slot { Empty, Full, End }; ///< État d'un tampon.
+
+    std::vector<char> buffers[2]; ///< Les deux tampons.
+    std::size_t sizes[2] = {0, 0}; ///< Octets valides dans chaque tampon.
+    Slot slots[2] = {Slot::Empty, Slot::Empty}; ///< États des tampons.
+    int current = 0; ///< Tampon en cours d'analyse.
+    int fd = -1; ///< Descripteur lu.
+    bool stopping = false; ///< Demande d'arrêt.
+    std::atomic<int> error{0}; ///< errno de la lecture échouée, 0 si aucune.
+    std::mutex mutex; ///< Protège les états.
+    std::condition_variable changed; ///< Signale un changement d'état.
+    std::thread reader; ///< Thread de lecture.
+
+    /**
+     * @brief Boucle du thread de lecture.
+     * @param offset Position de départ.
+     */
+    void ReadLoop(std::size_t offset);
+};
+
+/**
+ * @brief Lecteur en flux de fichiers de suivi, sans allocation par ligne.
+ *
+ * Le format est détecté à l'ouverture (signature binaire, sinon CSV). Les nombres
+ * sont analysés avec std::from_chars directement dans les tampons de lecture ; seules
+ * les lignes à cheval sur deux blocs sont recopiées dans un tampon de raccord.
+ */
+class TrackingReader {
+public:
+    /**
+     * @brief Constructeur.
+     * @param chunk_size Taille des blocs lus en arrière-plan.
+     */
+    explicit TrackingReader(std::size_t chunk_size = 1 << 22);
+
+    /**
+     * @brief Ouvre un fichier de suivi.
+     * @param path Chemin du fichier.
+     * @return False si le fichier n'a pas pu être ouvert ou si son en-tête binaire annonce
+     *         plus de tracking::kMaxPlayers joueurs.
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Ferme le fichier.
+     */
+    void Close();
+
+    /**
+     * @brief Décode l'image suivante.
+     * @param row Image décodée.
+     * @return False en fin de fichier ou après une erreur de lecture (voir ReadError()).
+     */
+    bool Next(TrackingRow& row);
+
+    /**
+     * @brief Recopie une image dans l'état des joueurs et du ballon.
+     *
+     * Les joueurs sont pris dans l'ordre du fichier ; le possesseur du ballon et les
+     * indicateurs possede_ball sont mis à jour d'après la colonne `owner`.
+     *
+     * @param row Image à appliquer.
+     * @param players Joueurs (au moins row.players).
+     * @param ballon Ballon.
+     */
+    static void Apply(const TrackingRow& row, std::vector<Player>& players, Ballon& ballon);
+
+    bool IsBinary() const { return binary; } ///< Indique si le fichier est au format binaire.
+    std::size_t Players() const { return players; } ///< Joueurs par image (connu après la première image en CSV).
+    std::uint64_t Rows() const { return rows; } ///< Images décodées.
+    std::uint64_t Errors() const { return errors; } ///< Lignes CSV ignorées car mal formées.
+    int ReadError() const { return prefetcher.Error(); } ///< errno de la lecture échouée, 0 si le fichier a été lu jusqu'au bout.
+
+private:
+    ChunkPrefetcher prefetcher; ///< Lecture en arrière-plan.
+    bool open = false; ///< Indique si un fichier est ouvert.
+    bool binary = false; ///< Format du fichier.
+    std::size_t players = 0; ///< Joueurs par image.
+    const char* cursor = nullptr; ///< Position dans le bloc courant.
+    const char* end = nullptr; ///< Fin du bloc courant.
+    bool holding = false; ///< Indique si un bloc est en cours d'analyse.
+    std::vector<char> carry; ///< Tampon de raccord pour les lignes à cheval sur deux blocs.
+    bool carry_done = false; ///< Indique que le raccord a été rendu et doit être vidé.
+    std::vector<float> coords; ///< Positions de l'image courante.
+    std::uint64_t rows = 0; ///< Images décodées.
+    std::uint64_t errors = 0; ///< Lignes ignorées.
+
+    /**
+     * @brief Extrait le prochain enregistrement brut (ligne CSV ou enregistrement binaire).
+     * @param first Début de l'enregistrement.
+     * @param last Fin de l'enregistrement.
+     * @return False en fin de fichier.
+     */
+    bool NextRecord(const char*& first, const char*& last);
+
+    /**
+     * @brief Analyse une ligne CSV.
+     * @param first Début de la ligne.
+     * @param last Fin de la ligne (sans le saut de ligne).
+     * @param row Image décodée.
+     * @return False si la ligne n'est pas une image valide.
+     */
+    bool ParseCsv(const char* first, const char* last, TrackingRow& row);
+
+    /**
+     * @brief Décode un enregistrement binaire.
+     * @param first Début de l'enregistrement.
+     * @param row Image décodée.
+     */
+    void ParseBinary(const char* first, TrackingRow& row);
+};
+
+/**
+ * @brief Bilan de la comparaison entre les passes réelles et celles choisies par changer_possesseur().
+ */
+struct PassComparison {
+    std::uint64_t passes = 0; ///< Passes réelles entre coéquipiers.
+    std::uint64_t agreed = 0; ///< Passes où changer_possesseur() aurait choisi le même receveur.
+};
+
+/**
+ * @brief Rejoue un flux de suivi dans un état de jeu et compare les passes au modèle.
+ */
+class TrackingReplay {
+public:
+    /**
+     * @brief Constructeur.
+     * @param players Nombre de joueurs (numérotés de 0 à players - 1, cinq par équipe).
+     */
+    explicit TrackingReplay(std::size_t players = 10);
+
+    /**
+     * @brief Applique une image et, en cas de passe, la compare au choix du modèle.
+     * @param row Image à appliquer.
+     */
+    void Apply(const TrackingRow& row);
+
+    std::vector<Player>& Players() { return roster; } ///< Joueurs rejoués.
+    Ballon& Ball() { return ball; } ///< Ballon rejoué.
+    const PassComparison& Passes() const { return passes; } ///< Bilan des passes.
+
+private:
+    std::vector<Player> roster; ///< Joueurs rejoués.
+    Ballon ball; ///< Ballon rejoué.
+    PlayerPool pool; ///< Calcul des voisins au moment des passes.
+    int owner = -1; ///< Possesseur de l'image précédente.
+    PassComparison passes; ///< Bilan des passes.
+};
+
+#endif // TRACKING_FEED_HPP
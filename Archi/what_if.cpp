@@ -0,0 +1,113 @@
+#include "what_if.hpp"
+
+namespace {
+
+/**
+ * @brief Graine d'une variante, commune à toutes les candidates.
+ * @param from État du match évalué (sa clé et son tick).
+ * @param fork Indice de la variante.
+ * @return La graine.
+ */
+template <class State>
+std::uint32_t fork_seed(const State& from, int fork) {
+    const PhiloxBlock counter{{static_cast<std::uint32_t>(fork), static_cast<std::uint32_t>(from.ticks),
+                               static_cast<std::uint32_t>(from.ticks >> 32),
+                               static_cast<std::uint32_t>(RandomStream::Fork)}};
+    return Philox4x32(counter, KeyFor(from.seed, from.match_id)).c[0];
+}
+
+} // namespace
+
+/**
+ * @brief Constructeur.
+ * @param config Paramètres de simulation des variantes.
+ */
+template <class Rules>
+BasicWhatIf<Rules>::BasicWhatIf(const MatchConfig& config) : scratch(config) {}
+
+/**
+ * @brief Simule une variante.
+ * @param from État de départ.
+ * @param team Équipe du coach.
+ * @param ours Stratégie de l'équipe du coach.
+ * @param theirs Stratégie de l'adversaire.
+ * @param horizon Nombre de ticks simulés.
+ * @param seed Graine du générateur de la variante.
+ * @return Le gain d'écart au score pour l'équipe du coach.
+ */
+template <class Rules>
+int BasicWhatIf<Rules>::Fork(const State& from, int team, Strategy* ours, Strategy* theirs, int horizon,
+                             std::uint32_t seed) {
+    State state = from;
+    state.seed = seed;
+    scratch.restore(state);
+    scratch.coach(team).SetStrategy(ours);
+    scratch.coach(1 - team).SetStrategy(theirs);
+    for (int i = 0; i < horizon; ++i) {
+        scratch.tick();
+    }
+    ++total_forks;
+
+    const ScoreSnapshot end = scratch.live_score().Snapshot();
+    const int before = from.home - from.away;
+    const int after = end.home - end.away;
+    return team == 0 ? after - before : before - after;
+}
+
+/**
+ * @brief Évalue des stratégies candidates depuis l'état courant d'un match.
+ * @param match Match évalué.
+ * @param team Équipe du coach.
+ * @param candidates Stratégies candidates.
+ * @param count Nombre de candidates.
+ * @param forks Variantes simulées par candidate.
+ * @param horizon Ticks simulés par variante.
+ * @return La candidate de meilleur gain moyen.
+ */
+template <class Rules>
+Strategy* BasicWhatIf<Rules>::Choose(const MatchType& match, int team, Strategy* const* candidates, int count,
+                                     int forks, int horizon) {
+    outcomes.clear();
+    const State from = match.snapshot();
+    Strategy* theirs = match.coach(1 - team).GetStrategy();
+
+    Strategy* best = nullptr;
+    double best_margin = 0.0;
+    for (int c = 0; c < count; ++c) {
+        long total = 0;
+        for (int f = 0; f < forks; ++f) {
+            total += Fork(from, team, candidates[c], theirs, horizon, fork_seed(from, f));
+        }
+        const double mean = forks > 0 ? static_cast<double>(total) / forks : 0.0;
+        outcomes.push_back(WhatIfOutcome{candidates[c], mean, forks});
+        if (!best || mean > best_margin) {
+            best = candidates[c];
+            best_margin = mean;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Choisit une stratégie et la donne au coach de l'équipe.
+ * @param match Match évalué.
+ * @param team Équipe du coach.
+ * @param candidates Stratégies candidates.
+ * @param count Nombre de candidates.
+ * @param forks Variantes simulées par candidate.
+ * @param horizon Ticks simulés par variante.
+ * @return La stratégie retenue.
+ */
+template <class Rules>
+Strategy* BasicWhatIf<Rules>::Decide(MatchType& match, int team, Strategy* const* candidates, int count, int forks,
+                                     int horizon) {
+    Strategy* best = Choose(match, team, candidates, count, forks, horizon);
+    if (best) {
+        match.coach(team).SetStrategy(best);
+    }
+    return best;
+}
+
+template class BasicWhatIf<Rules5x5>;
+template class BasicWhatIf<Rules3x3>;
+template class BasicWhatIf<RulesDrill2x2>;
@@ -0,0 +1,89 @@
+/**
+ * @file what_if.hpp
+ * @brief Évaluation des stratégies d'un coach par simulation de variantes du match.
+ */
+
+#ifndef WHAT_IF_HPP
+#define WHAT_IF_HPP
+
+#include "match.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Bilan des variantes simulées pour une stratégie candidate.
+ */
+struct WhatIfOutcome {
+    Strategy* strategy; ///< Stratégie candidate.
+    double mean_margin; ///< Gain moyen d'écart au score pour l'équipe du coach.
+    int forks; ///< Nombre de variantes simulées.
+};
+
+/**
+ * @brief Simule des variantes d'un match pour choisir la stratégie d'une équipe.
+ *
+ * Chaque variante repart de l'état sauvegardé du match (BasicGameState, copié par
+ * memcpy) dans un match de travail réutilisé : une variante ne coûte que la restauration
+ * et les ticks simulés, sans allocation. Toutes les candidates sont jouées avec les mêmes
+ * graines, si bien que leurs écarts tiennent aux stratégies et non au hasard.
+ *
+ * @tparam Rules Règles de la variante de jeu.
+ */
+template <class Rules>
+class BasicWhatIf {
+public:
+    using MatchType = BasicMatch<Rules>; ///< Type du match simulé.
+    using State = BasicGameState<Rules>; ///< État d'un match.
+
+    /**
+     * @brief Constructeur.
+     * @param config Paramètres de simulation des variantes (ceux du match évalué).
+     */
+    explicit BasicWhatIf(const MatchConfig& config = MatchConfig());
+
+    /**
+     * @brief Simule une variante.
+     * @param from État de départ.
+     * @param team Équipe du coach.
+     * @param ours Stratégie de l'équipe du coach.
+     * @param theirs Stratégie de l'adversaire (nullptr : aucune).
+     * @param horizon Nombre de ticks simulés.
+     * @param seed Graine des tirages de la variante.
+     * @return Le gain d'écart au score pour l'équipe du coach.
+     */
+    int Fork(const State& from, int team, Strategy* ours, Strategy* theirs, int horizon, std::uint32_t seed);
+
+    /**
+     * @brief Évalue des stratégies candidates depuis l'état courant d'un match.
+     * @param match Match évalué ; l'adversaire garde la stratégie de son coach.
+     * @param team Équipe du coach.
+     * @param candidates Stratégies candidates.
+     * @param count Nombre de candidates.
+     * @param forks Variantes simulées par candidate.
+     * @param horizon Ticks simulés par variante.
+     * @return La candidate de meilleur gain moyen, ou nullptr sans candidate.
+     */
+    Strategy* Choose(const MatchType& match, int team, Strategy* const* candidates, int count, int forks, int horizon);
+
+    /**
+     * @brief Choisit une stratégie par Choose() et la donne au coach de l'équipe.
+     * @return La stratégie retenue, ou nullptr sans candidate.
+     */
+    Strategy* Decide(MatchType& match, int team, Strategy* const* candidates, int count, int forks, int horizon);
+
+    const std::vector<WhatIfOutcome>& Outcomes() const { return outcomes; } ///< Bilans du dernier Choose().
+    std::uint64_t TotalForks() const { return total_forks; } ///< Variantes simulées depuis la construction.
+
+private:
+    MatchType scratch; ///< Match de travail, restauré pour chaque variante.
+    std::vector<WhatIfOutcome> outcomes; ///< Bilans du dernier Choose().
+    std::uint64_t total_forks = 0; ///< Variantes simulées.
+};
+
+extern template class BasicWhatIf<Rules5x5>;
+extern template class BasicWhatIf<Rules3x3>;
+extern template class BasicWhatIf<RulesDrill2x2>;
+
+using WhatIf = BasicWhatIf<Rules5x5>; ///< Évaluation de stratégies d'un match à cinq contre cinq.
+
+#endif // WHAT_IF_HPP
@@ -0,0 +1,206 @@
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+/**
+ * @brief Assemble une plage [begin, end) dans un mot de 64 bits.
+ */
+std::uint64_t pack(std::uint64_t begin, std::uint64_t end) {
+    return (begin << 32) | end;
+}
+
+std::uint64_t range_begin(std::uint64_t bounds) { return bounds >> 32; } ///< Début d'une plage.
+std::uint64_t range_end(std::uint64_t bounds) { return bounds & 0xffffffffu; } ///< Fin d'une plage.
+
+} // namespace
+
+/**
+ * @brief Constructeur démarrant les workers.
+ * @param threads Nombre total de workers, thread appelant compris (0 : un par cœur).
+ */
+WorkStealingPool::WorkStealingPool(unsigned threads)
+    : workers(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      ranges(new Range[workers]) {
+    this->threads.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w) {
+        this->threads.emplace_back(&WorkStealingPool::WorkerLoop, this, w);
+    }
+}
+
+/**
+ * @brief Destructeur arrêtant et joignant les workers.
+ */
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Exécute @p body pour chaque indice de [0, count) et attend la fin.
+ * @param count Nombre d'itérations.
+ * @param body Corps de la boucle.
+ */
+void WorkStealingPool::ParallelFor(std::size_t count, const Body& body) {
+    const bool reentered = busy.exchange(true, std::memory_order_acquire);
+    assert(!reentered && "ParallelFor n'est pas réentrant : utiliser TryParallelFor");
+    (void)reentered;
+    RunLoop(count, body);
+    busy.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief Exécute @p body pour chaque indice de [0, count), sauf si une boucle est déjà en cours.
+ * @param count Nombre d'itérations.
+ * @param body Corps de la boucle.
+ * @return False si le pool est occupé.
+ */
+bool WorkStealingPool::TryParallelFor(std::size_t count, const Body& body) {
+    if (busy.exchange(true, std::memory_order_acquire)) {
+        return false;
+    }
+    RunLoop(count, body);
+    busy.store(false, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Exécute une boucle, le pool étant réservé par l'appelant.
+ * @param count Nombre d'itérations.
+ * @param body Corps de la boucle.
+ */
+void WorkStealingPool::RunLoop(std::size_t count, const Body& body) {
+    if (count == 0) {
+        return;
+    }
+
+    const std::uint64_t chunk = count / workers;
+    const std::uint64_t extra = count % workers;
+    std::uint64_t begin = 0;
+    for (unsigned w = 0; w < workers; ++w) {
+        const std::uint64_t end = begin + chunk + (w < extra ? 1 : 0);
+        ranges[w].bounds.store(pack(begin, end), std::memory_order_relaxed);
+        begin = end;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        running = workers;
+        ++generation;
+    }
+    wake.notify_all();
+
+    Drain(0, body);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    --running;
+    finished.wait(lock, [this] { return running == 0; });
+    job = nullptr;
+}
+
+/**
+ * @brief Boucle principale d'un worker.
+ * @param worker Identifiant du worker.
+ */
+void WorkStealingPool::WorkerLoop(unsigned worker) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        const Body* body;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            body = job;
+        }
+
+        Drain(worker, *body);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) {
+            finished.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Exécute des itérations jusqu'à ce qu'il n'en reste plus à prendre ni à voler.
+ * @param worker Identifiant du worker.
+ * @param body Corps de la boucle.
+ */
+void WorkStealingPool::Drain(unsigned worker, const Body& body) {
+    std::size_t index;
+    for (;;) {
+        while (PopLocal(worker, index)) {
+            body(index, worker);
+        }
+        if (!Steal(worker, index)) {
+            return;
+        }
+        body(index, worker);
+    }
+}
+
+/**
+ * @brief Prend la prochaine itération de sa propre plage.
+ * @param worker Identifiant du worker.
+ * @param index Indice pris.
+ * @return True si une itération a été prise.
+ */
+bool WorkStealingPool::PopLocal(unsigned worker, std::size_t& index) {
+    std::atomic<std::uint64_t>& bounds = ranges[worker].bounds;
+    std::uint64_t current = bounds.load(std::memory_order_acquire);
+    for (;;) {
+        const std::uint64_t begin = range_begin(current);
+        const std::uint64_t end = range_end(current);
+        if (begin >= end) {
+            return false;
+        }
+        if (bounds.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel)) {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Vole la moitié de la plage d'un autre worker.
+ *
+ * Le voleur garde la première itération volée et range le reste dans sa propre plage,
+ * qui est vide à ce moment-là et n'est donc disputée par personne.
+ *
+ * @param thief Identifiant du voleur.
+ * @param index Première itération volée.
+ * @return True si un vol a réussi.
+ */
+bool WorkStealingPool::Steal(unsigned thief, std::size_t& index) {
+    for (unsigned offset = 1; offset < workers; ++offset) {
+        std::atomic<std::uint64_t>& victim = ranges[(thief + offset) % workers].bounds;
+        std::uint64_t current = victim.load(std::memory_order_acquire);
+        for (;;) {
+            const std::uint64_t begin = range_begin(current);
+            const std::uint64_t end = range_end(current);
+            if (begin >= end) {
+                break;
+            }
+            const std::uint64_t middle = end - (end - begin + 1) / 2;
+            if (victim.compare_exchange_weak(current, pack(begin, middle), std::memory_order_acq_rel)) {
+                ranges[thief].bounds.store(pack(middle + 1, end), std::memory_order_release);
+                steals.fetch_add(1, std::memory_order_relaxed);
+                index = middle;
+                return true;
+            }
+        }
+    }
+    return false;
+}
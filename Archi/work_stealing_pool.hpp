@@ -0,0 +1,148 @@
+/**
+ * @file work_stealing_pool.hpp
+ * @brief Pool de threads à vol de tâches pour les boucles parallèles.
+ */
+
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool de threads persistants exécutant des boucles parallèles par vol de tâches.
+ *
+ * Chaque appel à ParallelFor() découpe l'intervalle d'indices en une plage par worker.
+ * Un worker consomme sa plage par le début ; lorsqu'elle est vide, il vole la moitié
+ * de la plage d'un autre worker par la fin. Chaque plage tient dans un seul mot atomique,
+ * si bien que prise et vol se font par compare-and-swap, sans verrou. Le mutex ne sert
+ * qu'à réveiller les workers au début d'une boucle et à signaler sa fin.
+ * Le thread appelant participe au travail en tant que worker 0.
+ *
+ * Une seule boucle s'exécute à la fois : ParallelFor() n'est pas réentrant. Un corps de
+ * boucle, ou un thread extérieur pendant une boucle, passe par TryParallelFor() et
+ * exécute lui-même ses itérations si le pool est occupé.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Corps d'une boucle parallèle.
+     *
+     * Reçoit l'indice de l'itération et l'identifiant du worker qui l'exécute
+     * (dans [0, Size())), utile pour indexer des tampons propres à chaque thread.
+     */
+    using Body = std::function<void(std::size_t index, unsigned worker)>;
+
+    /**
+     * @brief Constructeur démarrant les workers.
+     * @param threads Nombre total de workers, thread appelant compris (0 : un par cœur).
+     */
+    explicit WorkStealingPool(unsigned threads = 0);
+
+    /**
+     * @brief Destructeur arrêtant et joignant les workers.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete; ///< Non copiable.
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete; ///< Non copiable.
+
+    /**
+     * @brief Nombre de workers, thread appelant compris.
+     * @return Le nombre de workers.
+     */
+    unsigned Size() const { return workers; }
+
+    /**
+     * @brief Exécute @p body pour chaque indice de [0, count) et attend la fin.
+     * @param count Nombre d'itérations (au plus 2^32 - 1).
+     * @param body Corps de la boucle ; il ne doit pas lever d'exception.
+     */
+    void ParallelFor(std::size_t count, const Body& body);
+
+    /**
+     * @brief Comme ParallelFor(), sauf si une boucle est déjà en cours.
+     *
+     * Le pool n'ayant qu'une boucle à la fois, un appel depuis un worker (ou concurrent à
+     * une autre boucle) ne peut pas être servi ; l'appelant doit alors exécuter les
+     * itérations lui-même.
+     *
+     * @param count Nombre d'itérations (au plus 2^32 - 1).
+     * @param body Corps de la boucle ; il ne doit pas lever d'exception.
+     * @return False, sans rien exécuter, si le pool est occupé.
+     */
+    bool TryParallelFor(std::size_t count, const Body& body);
+
+    /**
+     * @brief Nombre de vols réussis depuis la création du pool.
+     * @return Le nombre de vols.
+     */
+    std::uint64_t Steals() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Plage d'indices d'un worker : début sur 32 bits de poids fort, fin sur 32 bits de poids faible.
+     */
+    struct alignas(64) Range {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+
+    unsigned workers; ///< Nombre total de workers.
+    std::vector<std::thread> threads; ///< Workers 1 à workers - 1.
+    std::unique_ptr<Range[]> ranges; ///< Une plage par worker.
+    std::atomic<std::uint64_t> steals{0}; ///< Compteur de vols.
+    std::atomic<bool> busy{false}; ///< Vrai pendant une boucle.
+
+    std::mutex mutex; ///< Protège le démarrage et la fin des boucles.
+    std::condition_variable wake; ///< Réveille les workers au début d'une boucle.
+    std::condition_variable finished; ///< Signale la fin d'une boucle.
+    const Body* job = nullptr; ///< Corps de la boucle en cours.
+    std::uint64_t generation = 0; ///< Numéro de la boucle en cours.
+    unsigned running = 0; ///< Workers encore actifs sur la boucle en cours.
+    bool stopping = false; ///< Demande d'arrêt des workers.
+
+    /**
+     * @brief Exécute une boucle, le pool étant réservé par l'appelant.
+     * @param count Nombre d'itérations.
+     * @param body Corps de la boucle.
+     */
+    void RunLoop(std::size_t count, const Body& body);
+
+    /**
+     * @brief Boucle principale d'un worker.
+     * @param worker Identifiant du worker.
+     */
+    void WorkerLoop(unsigned worker);
+
+    /**
+     * @brief Exécute des itérations jusqu'à ce qu'il n'en reste plus à prendre ni à voler.
+     * @param worker Identifiant du worker.
+     * @param body Corps de la boucle.
+     */
+    void Drain(unsigned worker, const Body& body);
+
+    /**
+     * @brief Prend la prochaine itération de sa propre plage.
+     * @param worker Identifiant du worker.
+     * @param index Indice pris.
+     * @return True si une itération a été prise.
+     */
+    bool PopLocal(unsigned worker, std::size_t& index);
+
+    /**
+     * @brief Vole la moitié de la plage d'un autre worker.
+     * @param thief Identifiant du voleur.
+     * @param index Première itération volée, à exécuter immédiatement.
+     * @return True si un vol a réussi.
+     */
+    bool Steal(unsigned thief, std::size_t& index);
+};
+
+#endif // WORK_STEALING_POOL_HPP